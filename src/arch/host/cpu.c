@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/**
+ * \file arch/host/cpu.c
+ * \brief Host core emulation, one POSIX thread per DSP core
+ */
+
+#include <arch/cpu.h>
+#include <arch/idc.h>
+#include <platform/cpu.h>
+#include <platform/idc.h>
+#include <sof/idc.h>
+#include <sof/notifier.h>
+#include <sof/schedule/schedule.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* cpu tracing */
+#define trace_cpu(__e, ...) \
+	trace_event(TRACE_CLASS_CPU, __e, ##__VA_ARGS__)
+#define trace_cpu_error(__e, ...) \
+	trace_error(TRACE_CLASS_CPU, __e, ##__VA_ARGS__)
+
+/* emulated core context */
+struct host_core {
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	bool running;		/* thread finished its init */
+	bool wake;		/* IDC or scheduler work pending */
+	bool down;		/* power down requested */
+};
+
+static struct host_core cores[PLATFORM_CORE_COUNT] = {
+	[0 ... PLATFORM_CORE_COUNT - 1] = {
+		.mutex = PTHREAD_MUTEX_INITIALIZER,
+		.cond = PTHREAD_COND_INITIALIZER,
+	},
+};
+
+static uint32_t active_cores_mask = 1 << PLATFORM_MASTER_CORE_ID;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* the library caller thread is the master core */
+static __thread int core_id = PLATFORM_MASTER_CORE_ID;
+
+static void *host_core_main(void *arg)
+{
+	struct host_core *core = arg;
+
+	core_id = core - cores;
+
+	init_system_notify(NULL);
+	idc_init();
+
+	pthread_mutex_lock(&core->mutex);
+	core->running = true;
+	pthread_cond_broadcast(&core->cond);
+	pthread_mutex_unlock(&core->mutex);
+
+	for (;;) {
+		pthread_mutex_lock(&core->mutex);
+		while (!core->wake)
+			pthread_cond_wait(&core->cond, &core->mutex);
+		core->wake = false;
+		pthread_mutex_unlock(&core->mutex);
+
+		/* IDC is the highest priority work on the DSP too */
+		arch_idc_process_msg_queue();
+		if (core->down)
+			break;
+
+		schedule();
+	}
+
+	idc_free();
+	free_system_notify();
+
+	return NULL;
+}
+
+void arch_cpu_enable_core(int id)
+{
+	struct host_core *core = &cores[id];
+
+	pthread_mutex_lock(&lock);
+
+	if (!arch_cpu_is_core_enabled(id)) {
+		core->running = false;
+		core->wake = false;
+		core->down = false;
+
+		if (pthread_create(&core->thread, NULL, host_core_main,
+				   core)) {
+			trace_cpu_error("arch_cpu_enable_core() error: "
+					"thread for core %d failed", id);
+			goto out;
+		}
+
+		/* IDC must not be sent before the core can receive it */
+		pthread_mutex_lock(&core->mutex);
+		while (!core->running)
+			pthread_cond_wait(&core->cond, &core->mutex);
+		pthread_mutex_unlock(&core->mutex);
+
+		__atomic_or_fetch(&active_cores_mask, 1 << id,
+				  __ATOMIC_SEQ_CST);
+	}
+
+out:
+	pthread_mutex_unlock(&lock);
+}
+
+void arch_cpu_disable_core(int id)
+{
+	struct idc_msg power_down = {
+		IDC_MSG_POWER_DOWN, IDC_MSG_POWER_DOWN_EXT, id };
+
+	pthread_mutex_lock(&lock);
+
+	if (id != PLATFORM_MASTER_CORE_ID && arch_cpu_is_core_enabled(id)) {
+		/* blocking, so the thread can be reaped afterwards */
+		arch_idc_send_msg(&power_down, IDC_BLOCKING);
+		pthread_join(cores[id].thread, NULL);
+
+		__atomic_and_fetch(&active_cores_mask, ~(1 << id),
+				   __ATOMIC_SEQ_CST);
+	}
+
+	pthread_mutex_unlock(&lock);
+}
+
+int arch_cpu_is_core_enabled(int id)
+{
+	return __atomic_load_n(&active_cores_mask, __ATOMIC_SEQ_CST) &
+		(1 << id);
+}
+
+int arch_cpu_get_id(void)
+{
+	return core_id;
+}
+
+void arch_cpu_wake_core(int id)
+{
+	struct host_core *core = &cores[id];
+
+	pthread_mutex_lock(&core->mutex);
+	core->wake = true;
+	pthread_cond_broadcast(&core->cond);
+	pthread_mutex_unlock(&core->mutex);
+}
+
+void cpu_power_down_core(void)
+{
+	/* thread leaves its loop once the IDC message is completed */
+	cores[arch_cpu_get_id()].down = true;
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/**
+ * \file arch/host/idc.c
+ * \brief Host IDC implementation file, rings drained by emulated cores
+ */
+
+#include <arch/cpu.h>
+#include <arch/idc.h>
+#include <platform/cpu.h>
+#include <sof/idc.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/** \brief Blocking send timeout, host threads can be preempted. */
+#define IDC_HOST_TIMEOUT_MS	1000
+
+/** \brief Polling interval of a sender waiting for the target. */
+#define IDC_HOST_POLL_US	20
+
+static void idc_deadline(struct timespec *ts)
+{
+	clock_gettime(CLOCK_MONOTONIC, ts);
+	ts->tv_sec += IDC_HOST_TIMEOUT_MS / 1000;
+	ts->tv_nsec += (IDC_HOST_TIMEOUT_MS % 1000) * 1000000;
+	if (ts->tv_nsec >= 1000000000) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000;
+	}
+}
+
+/**
+ * \brief Waits one polling interval.
+ * \param[in] deadline Wait deadline.
+ * \return True if the deadline has passed.
+ */
+static bool idc_poll(const struct timespec *deadline)
+{
+	struct timespec poll = { 0, IDC_HOST_POLL_US * 1000 };
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (now.tv_sec > deadline->tv_sec ||
+	    (now.tv_sec == deadline->tv_sec &&
+	     now.tv_nsec >= deadline->tv_nsec))
+		return true;
+
+	nanosleep(&poll, NULL);
+
+	return false;
+}
+
+/**
+ * \brief Sends IDC message.
+ *
+ * Messages are queued in the ring of the core pair and the target thread is
+ * woken up to drain it, like the doorbell on the DSP.
+ *
+ * \param[in,out] msg Pointer to IDC message.
+ * \param[in] mode Is message blocking, non-blocking or coalesced.
+ * \return Error code.
+ */
+int arch_idc_send_msg(struct idc_msg *msg, uint32_t mode)
+{
+	struct timespec deadline;
+	uint32_t seq;
+	int ret;
+
+	tracev_idc("arch_idc_send_msg()");
+
+	idc_deadline(&deadline);
+
+	/* wait for a free slot only if the ring is full */
+	while ((ret = idc_ring_post(msg, mode, &seq)) == -EBUSY) {
+		if (idc_poll(&deadline)) {
+			trace_idc_error("arch_idc_send_msg() error: "
+					"ring full");
+			return -ETIME;
+		}
+	}
+	if (ret < 0)
+		return ret;
+
+	arch_cpu_wake_core(msg->core);
+
+	if (mode != IDC_BLOCKING)
+		return 0;
+
+	while ((ret = idc_ring_status(msg->core, seq)) == -EINPROGRESS) {
+		if (idc_poll(&deadline)) {
+			trace_idc_error("arch_idc_send_msg() error: timeout");
+			return -ETIME;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * \brief Executes pending IDC messages of the current core and reaps
+ * completions of the sent ones.
+ */
+void arch_idc_process_msg_queue(void)
+{
+	int core = arch_cpu_get_id();
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (i == core)
+			continue;
+
+		idc_ring_process(i);
+		idc_ring_reap(i);
+	}
+}
+
+/**
+ * \brief Initializes IDC data of the current core.
+ */
+int arch_idc_init(void)
+{
+	trace_idc("arch_idc_init()");
+
+	return idc_ring_init();
+}
+
+/**
+ * \brief Frees IDC data of the current core.
+ */
+void idc_free(void)
+{
+	trace_idc("idc_free()");
+}
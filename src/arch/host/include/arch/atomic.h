@@ -16,14 +16,15 @@ typedef struct {
 	volatile int32_t value;
 } atomic_t;
 
+/* use gcc atomic built-ins for host library, cores are host threads */
 static inline int32_t arch_atomic_read(const atomic_t *a)
 {
-	return (*(volatile int32_t *)&a->value);
+	return __atomic_load_n(&a->value, __ATOMIC_SEQ_CST);
 }
 
 static inline void arch_atomic_set(atomic_t *a, int32_t value)
 {
-	a->value = value;
+	__atomic_store_n(&a->value, value, __ATOMIC_SEQ_CST);
 }
 
 static inline void arch_atomic_init(atomic_t *a, int32_t value)
@@ -31,15 +32,14 @@ static inline void arch_atomic_init(atomic_t *a, int32_t value)
 	arch_atomic_set(a, value);
 }
 
-/* use gcc atomic built-ins for host library */
 static inline int32_t arch_atomic_add(atomic_t *a, int32_t value)
 {
-	return __sync_fetch_and_add(&a->value, value);
+	return __atomic_fetch_add(&a->value, value, __ATOMIC_SEQ_CST);
 }
 
 static inline int32_t arch_atomic_sub(atomic_t *a, int32_t value)
 {
-	return __sync_fetch_and_sub(&a->value, value);
+	return __atomic_fetch_sub(&a->value, value, __ATOMIC_SEQ_CST);
 }
 
 #endif
@@ -8,23 +8,21 @@
 #ifndef __INCLUDE_ARCH_CPU__
 #define __INCLUDE_ARCH_CPU__
 
-static inline void arch_cpu_enable_core(int id)
-{
-}
+/*
+ * The host library emulates each DSP core with a POSIX thread. The caller
+ * of the library is the master core, every other core gets a thread that
+ * services IDC messages and runs the scheduler when woken up.
+ */
 
-static inline void arch_cpu_disable_core(int id)
-{
-}
+void arch_cpu_enable_core(int id);
 
-static inline int arch_cpu_is_core_enabled(int id)
-{
-	return 0;
-}
+void arch_cpu_disable_core(int id);
 
-static inline int arch_cpu_get_id(void)
-{
-	return 0;
-}
+int arch_cpu_is_core_enabled(int id);
+
+int arch_cpu_get_id(void);
+
+void arch_cpu_wake_core(int id);
 
 static inline void cpu_write_threadptr(int threadptr)
 {
@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2019 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file arch/host/include/arch/idc.h
+ * \brief Host architecture IDC header file
+ */
+
+#ifndef __ARCH_IDC_H__
+#define __ARCH_IDC_H__
+
+#include <stdint.h>
+
+struct idc_msg;
+
+void cpu_power_down_core(void);
+
+int arch_idc_send_msg(struct idc_msg *msg, uint32_t mode);
+void arch_idc_process_msg_queue(void);
+int arch_idc_init(void);
+void idc_free(void);
+
+#endif
@@ -11,11 +11,38 @@
 #include <stdint.h>
 #include <errno.h>
 
+/* emulated cores run on host threads so locks must be real */
 typedef struct {
+	volatile uint32_t lock;
+#if DEBUG_LOCKS
+	uint32_t user;
+#endif
 } spinlock_t;
 
-static inline void arch_spinlock_init(spinlock_t *lock) {}
-static inline void arch_spin_lock(spinlock_t *lock) {}
-static inline void arch_spin_unlock(spinlock_t *lock) {}
+static inline void arch_spinlock_init(spinlock_t *lock)
+{
+	__atomic_store_n(&lock->lock, 0, __ATOMIC_RELEASE);
+}
+
+static inline void arch_spin_lock(spinlock_t *lock)
+{
+	while (__atomic_exchange_n(&lock->lock, 1, __ATOMIC_ACQUIRE)) {
+		/* wait for release without hammering the cache line */
+		while (__atomic_load_n(&lock->lock, __ATOMIC_RELAXED))
+			;
+	}
+}
+
+static inline int arch_try_lock(spinlock_t *lock)
+{
+	if (__atomic_exchange_n(&lock->lock, 1, __ATOMIC_ACQUIRE))
+		return 0; /* lock failed */
+	return 1; /* lock acquired */
+}
+
+static inline void arch_spin_unlock(spinlock_t *lock)
+{
+	__atomic_store_n(&lock->lock, 0, __ATOMIC_RELEASE);
+}
 
 #endif
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/**
+ * \file arch/host/notifier.c
+ * \brief Host notifier implementation file
+ */
+
+#include <arch/cpu.h>
+#include <platform/cpu.h>
+#include <sof/notifier.h>
+
+static struct notify *host_notify[PLATFORM_CORE_COUNT];
+
+struct notify **arch_notify_get(void)
+{
+	return &host_notify[arch_cpu_get_id()];
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/**
+ * \file arch/host/timer.c
+ * \brief Host platform timer, the monotonic clock scaled to the default
+ * DSP clock
+ */
+
+#include <platform/clk.h>
+#include <platform/platform.h>
+#include <platform/timer.h>
+#include <stdint.h>
+#include <time.h>
+
+static struct timer host_timer;
+
+struct timer *platform_timer = &host_timer;
+
+uint64_t platform_timer_get(struct timer *timer)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec) /
+		(1000000000 / CLK_DEFAULT_CPU_HZ);
+}
@@ -15,16 +15,10 @@
 #include <sof/idc.h>
 #include <sof/ipc.h>
 #include <sof/lock.h>
-#include <sof/notifier.h>
 #include <xtos-structs.h>
 #include <stdbool.h>
 #include <stdint.h>
 
-extern struct ipc *_ipc;
-
-/** \brief Indicates if core has processed received message. */
-static bool msg_processed[PLATFORM_CORE_COUNT];
-
 /**
  * \brief Returns IDC data.
  * \return Pointer to pointer of IDC data.
@@ -76,201 +70,163 @@ static void idc_irq_handler(void *arg)
 			/* disable BUSY interrupt */
 			idc_write(IPC_IDCCTL, core, idc->done_bit_mask);
 
-			idc->received_msg.core = i;
-			idc->received_msg.header =
-					idctfc & IPC_IDCTFC_MSG_MASK;
+			/* doorbell only wakes the task draining the rings */
+			if (iTS(idctfc) != iTS(IDC_MSG_RING)) {
+				idc->received_msg.core = i;
+				idc->received_msg.header =
+						idctfc & IPC_IDCTFC_MSG_MASK;
 
-			idctefc = idc_read(IPC_IDCTEFC(i), core);
-			idc->received_msg.extension =
-					idctefc & IPC_IDCTEFC_MSG_MASK;
+				idctefc = idc_read(IPC_IDCTEFC(i), core);
+				idc->received_msg.extension =
+						idctefc & IPC_IDCTEFC_MSG_MASK;
+			}
 
 			schedule_task(&idc->idc_task, 0, IDC_DEADLINE, 0);
 		}
 	}
 
-	/* DONE interrupt only enabled by master core */
-	if (core == PLATFORM_MASTER_CORE_ID) {
-		for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
-			/* skip current core */
-			if (core == i)
-				continue;
+	/* target acknowledged our doorbell, completions can be reaped */
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		/* skip current core */
+		if (core == i)
+			continue;
 
-			idcietc = idc_read(IPC_IDCIETC(i), core);
+		idcietc = idc_read(IPC_IDCIETC(i), core);
 
-			if (idcietc & IPC_IDCIETC_DONE) {
-				tracev_idc("idc_irq_handler(), "
-					   "IPC_IDCIETC_DONE");
+		if (idcietc & IPC_IDCIETC_DONE) {
+			tracev_idc("idc_irq_handler(), IPC_IDCIETC_DONE");
 
-				idc_write(IPC_IDCIETC(i), core,
-					  idcietc | IPC_IDCIETC_DONE);
+			idc_write(IPC_IDCIETC(i), core,
+				  idcietc | IPC_IDCIETC_DONE);
 
-				msg_processed[i] = true;
-			}
+			schedule_task(&idc->idc_task, 0, IDC_DEADLINE, 0);
 		}
 	}
 }
 
 /**
- * \brief Sends IDC message.
- * \param[in,out] msg Pointer to IDC message.
- * \param[in] mode Is message blocking or not.
- * \return Error code.
+ * \brief Writes message directly to the IDC registers of target core.
+ * \param[in] msg Pointer to IDC message.
  */
-int arch_idc_send_msg(struct idc_msg *msg, uint32_t mode)
+static void idc_send_raw(struct idc_msg *msg)
 {
 	int core = arch_cpu_get_id();
-	uint64_t deadline;
-
-	tracev_idc("arch_idc_send_msg()");
-
-	msg_processed[msg->core] = false;
 
 	idc_write(IPC_IDCIETC(msg->core), core, msg->extension);
 	idc_write(IPC_IDCITC(msg->core), core, msg->header | IPC_IDCITC_BUSY);
-
-	if (mode == IDC_BLOCKING) {
-		deadline = platform_timer_get(platform_timer) +
-			clock_ms_to_ticks(PLATFORM_DEFAULT_CLOCK, 1) *
-			IDC_TIMEOUT / 1000;
-
-		while (!msg_processed[msg->core]) {
-			if (deadline < platform_timer_get(platform_timer)) {
-				/* safe check in case we've got preempted
-				 * after read
-				 */
-				if (msg_processed[msg->core])
-					return 0;
-
-				trace_idc_error("arch_idc_send_msg() error: "
-						"timeout");
-				return -ETIME;
-			}
-		}
-	}
-
-	return 0;
 }
 
 /**
- * \brief Executes IDC pipeline trigger message.
- * \param[in] cmd Trigger command.
+ * \brief Sends IDC message.
+ *
+ * Messages are queued in the ring of the core pair and the doorbell is rung
+ * only if the target hasn't acknowledged the previous one yet, it drains the
+ * ring before doing so. Non-blocking messages don't wait for the target,
+ * their completion callback runs once the target has executed them.
+ *
+ * \param[in,out] msg Pointer to IDC message.
+ * \param[in] mode Is message blocking, non-blocking or coalesced.
  * \return Error code.
  */
-static int idc_pipeline_trigger(uint32_t cmd)
+int arch_idc_send_msg(struct idc_msg *msg, uint32_t mode)
 {
-	struct sof_ipc_stream *data = _ipc->comp_data;
-	struct ipc_comp_dev *pcm_dev;
+	struct idc_msg doorbell = { IDC_MSG_RING, IDC_MSG_RING_EXT, msg->core };
+	int core = arch_cpu_get_id();
+	uint64_t deadline;
+	uint32_t seq;
 	int ret;
 
-	/* invalidate stream data */
-	dcache_invalidate_region(data, sizeof(*data));
-
-	/* check whether component exists */
-	pcm_dev = ipc_get_comp(_ipc, data->comp_id);
-	if (!pcm_dev)
-		return -ENODEV;
-
-	/* check whether we are executing from the right core */
-	if (arch_cpu_get_id() != pcm_dev->cd->pipeline->ipc_pipe.core)
-		return -EINVAL;
-
-	/* invalidate pipeline on start */
-	if (cmd == COMP_TRIGGER_START)
-		pipeline_cache(pcm_dev->cd->pipeline,
-			       pcm_dev->cd, CACHE_INVALIDATE);
-
-	/* trigger pipeline */
-	ret = pipeline_trigger(pcm_dev->cd->pipeline, pcm_dev->cd, cmd);
+	tracev_idc("arch_idc_send_msg()");
 
-	/* writeback pipeline on stop */
-	if (cmd == COMP_TRIGGER_STOP)
-		pipeline_cache(pcm_dev->cd->pipeline,
-			       pcm_dev->cd, CACHE_WRITEBACK_INV);
+	/* ROM parses power up and a core powering down never completes,
+	 * so power messages bypass the rings
+	 */
+	if (iTS(msg->header) == iTS(IDC_MSG_POWER_UP) ||
+	    iTS(msg->header) == iTS(IDC_MSG_POWER_DOWN)) {
+		idc_send_raw(msg);
+		return 0;
+	}
 
-	return ret;
-}
+	deadline = platform_timer_get(platform_timer) +
+		clock_ms_to_ticks(PLATFORM_DEFAULT_CLOCK, 1) *
+		IDC_TIMEOUT / 1000;
 
-/**
- * \brief Executes IDC component command message.
- * \param[in] cmd Component command.
- * \return Error code.
- */
-static int idc_component_command(uint32_t cmd)
-{
-	struct sof_ipc_ctrl_data *data = _ipc->comp_data;
-	struct ipc_comp_dev *comp_dev;
-	int ret;
-
-	/* invalidate control data */
-	dcache_invalidate_region(data, sizeof(*data));
-	dcache_invalidate_region(data + 1,
-				 data->rhdr.hdr.size - sizeof(*data));
+	/* wait for a free slot only if the ring is full */
+	while ((ret = idc_ring_post(msg, mode, &seq)) == -EBUSY) {
+		if (deadline < platform_timer_get(platform_timer)) {
+			trace_idc_error("arch_idc_send_msg() error: "
+					"ring full");
+			return -ETIME;
+		}
+	}
+	if (ret < 0)
+		return ret;
 
-	/* check whether component exists */
-	comp_dev = ipc_get_comp(_ipc, data->comp_id);
-	if (!comp_dev)
-		return -ENODEV;
+	if (!(idc_read(IPC_IDCITC(msg->core), core) & IPC_IDCITC_BUSY))
+		idc_send_raw(&doorbell);
 
-	/* check whether we are executing from the right core */
-	if (arch_cpu_get_id() != comp_dev->cd->pipeline->ipc_pipe.core)
-		return -EINVAL;
+	if (mode != IDC_BLOCKING)
+		return 0;
 
-	/* execute component command */
-	ret = comp_cmd(comp_dev->cd, cmd, data, data->rhdr.hdr.size);
+	while ((ret = idc_ring_status(msg->core, seq)) == -EINPROGRESS) {
+		if (deadline < platform_timer_get(platform_timer)) {
+			/* safe check in case we've got preempted
+			 * after read
+			 */
+			ret = idc_ring_status(msg->core, seq);
+			if (ret != -EINPROGRESS)
+				return ret;
 
-	/* writeback control data */
-	dcache_writeback_region(data, data->rhdr.hdr.size);
+			trace_idc_error("arch_idc_send_msg() error: "
+					"timeout");
+			return -ETIME;
+		}
+	}
 
 	return ret;
 }
 
 /**
- * \brief Executes IDC message based on type.
- * \param[in,out] msg Pointer to IDC message.
- */
-static void idc_cmd(struct idc_msg *msg)
-{
-	uint32_t type = iTS(msg->header);
-
-	switch (type) {
-	case iTS(IDC_MSG_POWER_DOWN):
-		cpu_power_down_core();
-		break;
-	case iTS(IDC_MSG_PPL_TRIGGER):
-		idc_pipeline_trigger(msg->extension);
-		break;
-	case iTS(IDC_MSG_COMP_CMD):
-		idc_component_command(msg->extension);
-		break;
-	case iTS(IDC_MSG_NOTIFY):
-		notifier_notify();
-		break;
-	default:
-		trace_idc_error("idc_cmd() error: invalid msg->header = %u",
-				msg->header);
-	}
-}
-
-/**
- * \brief Handles received IDC message.
+ * \brief Handles received IDC messages and reaps sent ones.
  * \param[in,out] data Pointer to IDC data.
  */
 static uint64_t idc_do_cmd(void *data)
 {
 	struct idc *idc = data;
 	int core = arch_cpu_get_id();
-	int initiator = idc->received_msg.core;
+	uint32_t idctfc;
+	int i;
 
 	trace_idc("idc_do_cmd()");
 
-	idc_cmd(&idc->received_msg);
+	/* message written directly to the registers */
+	if (idc->received_msg.header) {
+		idc_cmd(&idc->received_msg);
+		idc->received_msg.header = 0;
+	}
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		/* skip current core */
+		if (core == i)
+			continue;
+
+		/* messages posted after the BUSY bit is cleared come with
+		 * a new doorbell, earlier ones are drained here
+		 */
+		do {
+			idc_ring_process(i);
 
-	/* clear BUSY bit */
-	idc_write(IPC_IDCTFC(initiator), core,
-		  idc_read(IPC_IDCTFC(initiator), core) | IPC_IDCTFC_BUSY);
+			/* clear BUSY bit */
+			idctfc = idc_read(IPC_IDCTFC(i), core);
+			if (idctfc & IPC_IDCTFC_BUSY)
+				idc_write(IPC_IDCTFC(i), core, idctfc);
+		} while (idc_ring_pending(i));
+
+		idc_ring_reap(i);
+	}
 
 	/* enable BUSY interrupt */
-	idc_write(IPC_IDCCTL, core, idc->busy_bit_mask);
+	idc_write(IPC_IDCCTL, core, idc->busy_bit_mask | idc->done_bit_mask);
 
 	return 0;
 }
@@ -285,13 +241,10 @@ static uint32_t idc_get_busy_bit_mask(int core)
 	uint32_t busy_mask = 0;
 	int i;
 
-	if (core == PLATFORM_MASTER_CORE_ID) {
-		for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
-			if (i != PLATFORM_MASTER_CORE_ID)
-				busy_mask |= IPC_IDCCTL_IDCTBIE(i);
-		}
-	} else {
-		busy_mask = IPC_IDCCTL_IDCTBIE(PLATFORM_MASTER_CORE_ID);
+	/* any core can send to any other one */
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (i != core)
+			busy_mask |= IPC_IDCCTL_IDCTBIE(i);
 	}
 
 	return busy_mask;
@@ -307,13 +260,10 @@ static uint32_t idc_get_done_bit_mask(int core)
 	uint32_t done_mask = 0;
 	int i;
 
-	if (core == PLATFORM_MASTER_CORE_ID) {
-		for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
-			if (i != PLATFORM_MASTER_CORE_ID)
-				done_mask |= IPC_IDCCTL_IDCIDIE(i);
-		}
-	} else {
-		done_mask = 0;
+	/* every sender reaps its completions */
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (i != core)
+			done_mask |= IPC_IDCCTL_IDCIDIE(i);
 	}
 
 	return done_mask;
@@ -329,6 +279,11 @@ int arch_idc_init(void)
 
 	trace_idc("arch_idc_init()");
 
+	/* rings shared with other cores */
+	ret = idc_ring_init();
+	if (ret < 0)
+		return ret;
+
 	/* initialize idc data */
 	struct idc **idc = idc_get();
 	*idc = rzalloc(RZONE_SYS, SOF_MEM_CAPS_RAM, sizeof(**idc));
@@ -346,7 +301,7 @@ int arch_idc_init(void)
 		return ret;
 	interrupt_enable(PLATFORM_IDC_INTERRUPT(core));
 
-	/* enable BUSY and DONE (only for master core) interrupts */
+	/* enable BUSY and DONE interrupts */
 	idc_write(IPC_IDCCTL, core,
 		  (*idc)->busy_bit_mask | (*idc)->done_bit_mask);
 
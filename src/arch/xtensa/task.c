@@ -123,7 +123,7 @@ static void _irq_task(void *arg)
 		spin_unlock_irq(&irq_task->lock, flags);
 
 		if (run_task)
-			task->func(task->data);
+			schedule_task_run(task);
 
 		spin_lock_irq(&irq_task->lock, flags);
 		schedule_task_complete(task);
@@ -21,6 +21,347 @@
 #include <sof/audio/pipeline.h>
 #include <sof/audio/buffer.h>
 
+#if CONFIG_BUFFER_POOL
+/* number of freed backing stores the pool can hold */
+#define BUFFER_POOL_ENTRIES	8
+
+/* backing stores are pooled in cache line size classes */
+#define BUFFER_POOL_CLASS(size)	ALIGN_UP(size, PLATFORM_DCACHE_ALIGN)
+
+struct buffer_pool_entry {
+	void *addr;		/* backing store or NULL if unused */
+	uint32_t size;		/* size class in bytes */
+	uint32_t caps;		/* memory caps it was allocated with */
+	uint32_t age;		/* pool sequence number when retained */
+};
+
+struct buffer_pool {
+	spinlock_t lock;
+	uint32_t seq;
+	struct buffer_pool_entry entry[BUFFER_POOL_ENTRIES];
+	struct buffer_pool_stats stats;
+};
+
+static struct buffer_pool *pool;
+
+/* take retained backing store of same size class and caps */
+static void *buffer_pool_get(uint32_t caps, uint32_t size)
+{
+	struct buffer_pool_entry *entry;
+	void *addr = NULL;
+	uint32_t flags;
+	int i;
+
+	if (!pool)
+		return NULL;
+
+	spin_lock_irq(&pool->lock, flags);
+
+	for (i = 0; i < BUFFER_POOL_ENTRIES; i++) {
+		entry = &pool->entry[i];
+		if (entry->addr && entry->size == size && entry->caps == caps) {
+			addr = entry->addr;
+			entry->addr = NULL;
+			pool->stats.entries--;
+			pool->stats.bytes -= size;
+			break;
+		}
+	}
+
+	if (addr)
+		pool->stats.hits++;
+	else
+		pool->stats.misses++;
+
+	spin_unlock_irq(&pool->lock, flags);
+
+	return addr;
+}
+
+/* oldest retained entry, locks held by caller */
+static struct buffer_pool_entry *buffer_pool_oldest(void)
+{
+	struct buffer_pool_entry *oldest = NULL;
+	int i;
+
+	for (i = 0; i < BUFFER_POOL_ENTRIES; i++) {
+		if (pool->entry[i].addr &&
+		    (!oldest || pool->seq - pool->entry[i].age >
+		     pool->seq - oldest->age))
+			oldest = &pool->entry[i];
+	}
+
+	return oldest;
+}
+
+/* retain backing store, older entries are evicted to stay within limits */
+static void buffer_pool_put(void *addr, uint32_t caps, uint32_t size)
+{
+	struct buffer_pool_entry *entry;
+	void *evicted[BUFFER_POOL_ENTRIES];
+	int count = 0;
+	uint32_t flags;
+	int i;
+
+	if (!pool || size > CONFIG_BUFFER_POOL_SIZE) {
+		rfree(addr);
+		return;
+	}
+
+	spin_lock_irq(&pool->lock, flags);
+
+	while (pool->stats.bytes + size > CONFIG_BUFFER_POOL_SIZE ||
+	       pool->stats.entries == BUFFER_POOL_ENTRIES) {
+		entry = buffer_pool_oldest();
+		evicted[count++] = entry->addr;
+		entry->addr = NULL;
+		pool->stats.entries--;
+		pool->stats.bytes -= entry->size;
+	}
+
+	for (i = 0; i < BUFFER_POOL_ENTRIES; i++) {
+		entry = &pool->entry[i];
+		if (!entry->addr)
+			break;
+	}
+
+	entry->addr = addr;
+	entry->size = size;
+	entry->caps = caps;
+	entry->age = pool->seq++;
+	pool->stats.entries++;
+	pool->stats.bytes += size;
+
+	spin_unlock_irq(&pool->lock, flags);
+
+	/* heap has its own lock */
+	for (i = 0; i < count; i++)
+		rfree(evicted[i]);
+}
+
+void buffer_pool_init(void)
+{
+	/* shared by all cores */
+	pool = rzalloc(RZONE_SYS | RZONE_FLAG_UNCACHED, SOF_MEM_CAPS_RAM,
+		       sizeof(*pool));
+	if (!pool)
+		return;
+
+	spinlock_init(&pool->lock);
+}
+
+void buffer_pool_get_stats(struct buffer_pool_stats *stats)
+{
+	uint32_t flags;
+
+	if (!pool) {
+		bzero(stats, sizeof(*stats));
+		return;
+	}
+
+	spin_lock_irq(&pool->lock, flags);
+	*stats = pool->stats;
+	spin_unlock_irq(&pool->lock, flags);
+}
+
+uint32_t buffer_pool_flush(void)
+{
+	void *addr[BUFFER_POOL_ENTRIES];
+	uint32_t bytes;
+	uint32_t flags;
+	int i;
+
+	if (!pool)
+		return 0;
+
+	spin_lock_irq(&pool->lock, flags);
+
+	for (i = 0; i < BUFFER_POOL_ENTRIES; i++) {
+		addr[i] = pool->entry[i].addr;
+		pool->entry[i].addr = NULL;
+	}
+
+	bytes = pool->stats.bytes;
+	pool->stats.entries = 0;
+	pool->stats.bytes = 0;
+
+	spin_unlock_irq(&pool->lock, flags);
+
+	for (i = 0; i < BUFFER_POOL_ENTRIES; i++)
+		rfree(addr[i]);
+
+	return bytes;
+}
+#else
+void buffer_pool_init(void) { }
+
+void buffer_pool_get_stats(struct buffer_pool_stats *stats)
+{
+	bzero(stats, sizeof(*stats));
+}
+
+uint32_t buffer_pool_flush(void)
+{
+	return 0;
+}
+#endif
+
+/* allocate buffer backing store, from the pool if possible */
+static void *buffer_alloc_data(uint32_t caps, uint32_t size)
+{
+	void *addr;
+
+#if CONFIG_BUFFER_POOL
+	size = BUFFER_POOL_CLASS(size);
+
+	addr = buffer_pool_get(caps, size);
+	if (addr)
+		return addr;
+#endif
+
+	/* the heap takes back pooled memory if it runs out */
+	return rballoc(RZONE_BUFFER, caps, size);
+}
+
+/* release buffer backing store, to the pool if possible */
+static void buffer_free_data(void *addr, uint32_t caps, uint32_t size)
+{
+#if CONFIG_PIPELINE_ARENA
+	/* arena memory goes back with its pipeline */
+	if (arena_contains(addr)) {
+		rfree(addr);
+		return;
+	}
+#endif
+
+#if CONFIG_BUFFER_POOL
+	buffer_pool_put(addr, caps, BUFFER_POOL_CLASS(size));
+#else
+	rfree(addr);
+#endif
+}
+
+/* bytes held by downstream buffers sharing our backing store */
+static uint32_t buffer_alias_avail(struct comp_buffer *buffer)
+{
+	struct comp_buffer *alias;
+	uint32_t bytes = 0;
+
+	for (alias = buffer->alias_sink; alias; alias = alias->alias_sink)
+		bytes += alias->avail;
+
+	return bytes;
+}
+
+/* free space of a buffer and the upstream buffers it shares memory with */
+static void buffer_update_free(struct comp_buffer *buffer)
+{
+	for (; buffer; buffer = buffer->alias_source)
+		buffer->free = buffer->size - buffer->avail -
+			buffer_alias_avail(buffer);
+}
+
+/* reset positions of all buffers sharing the backing store */
+static void buffer_alias_reset(struct comp_buffer *buffer)
+{
+	while (buffer->alias_source)
+		buffer = buffer->alias_source;
+
+	for (; buffer; buffer = buffer->alias_sink)
+		buffer_reset_pos(buffer);
+}
+
+/* drop buffer and its aliases from the backing store they share */
+static void buffer_alias_detach(struct comp_buffer *buffer)
+{
+	struct comp_buffer *next;
+
+	buffer->alias_source->alias_sink = NULL;
+
+	for (; buffer; buffer = next) {
+		next = buffer->alias_sink;
+		buffer->alias_source = NULL;
+		buffer->alias_sink = NULL;
+		buffer->addr = NULL;
+		buffer->end_addr = NULL;
+		buffer->w_ptr = NULL;
+		buffer->r_ptr = NULL;
+		buffer->alloc_size = 0;
+		buffer->size = 0;
+		buffer->avail = 0;
+		buffer->free = 0;
+	}
+}
+
+/*
+ * Make buffer use the backing store of source, the buffer upstream of an
+ * in-place component. Data consumed from source is overwritten with the
+ * processed data, so the free space of source also accounts the data
+ * held by its aliases. Own backing store of the buffer is released.
+ */
+int buffer_alias(struct comp_buffer *buffer, struct comp_buffer *source)
+{
+	struct comp_buffer *alias;
+
+	if (buffer->alias_source != source) {
+		/* source must not already be one of our aliases */
+		for (alias = buffer; alias; alias = alias->alias_sink)
+			if (alias == source)
+				break;
+
+		if (alias || buffer->alias_source || source->alias_sink ||
+		    !source->addr) {
+			trace_buffer_error("buffer_alias() error: buffer %u "
+					   "is already aliased",
+					   buffer->ipc_buffer.comp.id);
+			return -EINVAL;
+		}
+
+		trace_buffer("buffer_alias(), buffer %u aliases buffer %u",
+			     buffer->ipc_buffer.comp.id,
+			     source->ipc_buffer.comp.id);
+
+		if (buffer->addr)
+			buffer_free_data(buffer->addr, buffer->ipc_buffer.caps,
+					 buffer->alloc_size);
+
+		buffer->alias_source = source;
+		source->alias_sink = buffer;
+	}
+
+	/* our own aliases move along with us */
+	for (alias = buffer; alias; alias = alias->alias_sink) {
+		alias->addr = source->addr;
+		alias->end_addr = source->end_addr;
+		alias->size = source->size;
+		alias->alloc_size = 0;
+	}
+
+	buffer_alias_reset(buffer);
+
+	return 0;
+}
+
+/* give buffer its own backing store again */
+void buffer_unalias(struct comp_buffer *buffer)
+{
+	if (buffer->alias_source)
+		buffer_alias_detach(buffer);
+
+	if (buffer->addr)
+		return;
+
+	buffer->addr = buffer_alloc_data(buffer->ipc_buffer.caps,
+					 buffer->ipc_buffer.size);
+	if (!buffer->addr) {
+		trace_buffer_error("buffer_unalias() error: can't alloc %u "
+				   "bytes", buffer->ipc_buffer.size);
+		return;
+	}
+
+	buffer_init(buffer, buffer->ipc_buffer.size);
+}
+
 /* create a new component in the pipeline */
 struct comp_buffer *buffer_new(struct sof_ipc_buffer *desc)
 {
@@ -43,7 +384,7 @@ struct comp_buffer *buffer_new(struct sof_ipc_buffer *desc)
 		return NULL;
 	}
 
-	buffer->addr = rballoc(RZONE_BUFFER, desc->caps, desc->size);
+	buffer->addr = buffer_alloc_data(desc->caps, desc->size);
 	if (!buffer->addr) {
 		rfree(buffer);
 		trace_buffer_error("buffer_new() error: "
@@ -80,21 +421,41 @@ int buffer_set_size(struct comp_buffer *buffer, uint32_t size)
 		return -EINVAL;
 	}
 
-	if (size == desc->size)
+	if (buffer->alias_source && size != desc->size)
+		buffer_alias_detach(buffer);
+
+	if (size == desc->size && buffer->addr)
 		return 0;
 
-	new_ptr = rbrealloc(buffer->addr, RZONE_BUFFER, desc->caps, size);
+	/* aliases can't follow our backing store */
+	if (buffer->alias_sink)
+		buffer_alias_detach(buffer->alias_sink);
+
+#if CONFIG_PIPELINE_ARENA
+	/* pipeline arena slot of the old store takes the new one if it fits */
+	if (buffer->addr && arena_contains(buffer->addr)) {
+		rfree(buffer->addr);
+		buffer->addr = NULL;
+	}
+#endif
+
+	/* contents are not preserved, buffer_init() clears the new chunk */
+	new_ptr = buffer_alloc_data(desc->caps, size);
 
 	/* we couldn't allocate bigger chunk */
-	if (!new_ptr && size > desc->size) {
+	if (!new_ptr && (size > desc->size || !buffer->addr)) {
 		trace_buffer_error("resize error: can't alloc %u bytes type %u",
 				   desc->size, desc->caps);
 		return -ENOMEM;
 	}
 
 	/* use bigger chunk, else just use the old chunk but set smaller */
-	if (new_ptr)
+	if (new_ptr) {
+		if (buffer->addr)
+			buffer_free_data(buffer->addr, desc->caps,
+					 buffer->alloc_size);
 		buffer->addr = new_ptr;
+	}
 
 	desc->size = size;
 
@@ -110,10 +471,151 @@ void buffer_free(struct comp_buffer *buffer)
 
 	list_item_del(&buffer->source_list);
 	list_item_del(&buffer->sink_list);
-	rfree(buffer->addr);
+
+	if (buffer->alias_sink)
+		buffer_alias_detach(buffer->alias_sink);
+
+	if (buffer->alias_source)
+		buffer_alias_detach(buffer);
+	else if (buffer->addr)
+		buffer_free_data(buffer->addr, buffer->ipc_buffer.caps,
+				 buffer->alloc_size);
 	rfree(buffer);
 }
 
+static void buffer_cache_invalidate(struct comp_buffer *buffer, void *addr,
+				    uint32_t bytes)
+{
+	dcache_invalidate_region(addr, bytes);
+	buffer->cache_ops++;
+}
+
+static void buffer_cache_writeback(struct comp_buffer *buffer, void *addr,
+				   uint32_t bytes)
+{
+	dcache_writeback_region(addr, bytes);
+	buffer->cache_ops++;
+}
+
+/* write back data produced since the last sync, it ends at the write pointer
+ * and may wrap
+ */
+static uint32_t buffer_cache_writeback_pending(struct comp_buffer *buffer)
+{
+	uint32_t bytes = buffer->cache_pending;
+	uint32_t head;
+
+	if (!bytes)
+		return 0;
+
+	head = buffer->w_ptr - buffer->addr;
+	if (bytes > head) {
+		buffer_cache_writeback(buffer, buffer->end_addr -
+				       (bytes - head), bytes - head);
+		if (head)
+			buffer_cache_writeback(buffer, buffer->addr, head);
+	} else {
+		buffer_cache_writeback(buffer, buffer->w_ptr - bytes, bytes);
+	}
+
+	buffer->cache_pending = 0;
+
+	return bytes;
+}
+
+#if CONFIG_BUFFER_XCORE
+/*
+ * A cross-core buffer is written by the source core on the producer side
+ * and by the sink core on the consumer side only, so neither needs the
+ * lock. Each side publishes a free running byte count from its own cache
+ * lines and reads the count of the other side after invalidating them.
+ * Produced data is written back once per period before it is published
+ * and the sink invalidates only the newly published part of the data.
+ */
+
+/* free bytes as seen by the source core */
+static uint32_t buffer_xcore_free(struct comp_buffer *buffer)
+{
+	return buffer->size - (buffer->produced + buffer->cache_pending -
+			       buffer->consumed);
+}
+
+/* drop lines holding data published by the source core, lines shared with
+ * data still being written by a source on this core are written back
+ */
+static void buffer_xcore_invalidate(struct comp_buffer *buffer, void *ptr,
+				    uint32_t bytes)
+{
+	uint32_t head = MIN(bytes, (uint32_t)(buffer->end_addr - ptr));
+
+	dcache_writeback_invalidate_region(ptr, head);
+	if (bytes > head)
+		dcache_writeback_invalidate_region(buffer->addr, bytes - head);
+}
+
+static void buffer_xcore_produce(struct comp_buffer *buffer, uint32_t bytes)
+{
+	buffer->w_ptr = buffer_get_frag(buffer, buffer->w_ptr, bytes, 1);
+
+	/* published by buffer_cache_sync() together with the data */
+	buffer->cache_pending += bytes;
+	buffer->free = buffer_xcore_free(buffer);
+
+	if (buffer->cb && buffer->cb_type & BUFF_CB_TYPE_PRODUCE)
+		buffer->cb(buffer->cb_data, bytes);
+}
+
+static void buffer_xcore_consume(struct comp_buffer *buffer, uint32_t bytes)
+{
+	buffer->r_ptr = buffer_get_frag(buffer, buffer->r_ptr, bytes, 1);
+	buffer->consumed += bytes;
+	buffer->avail = buffer->visible - buffer->consumed;
+
+	/* release the space to the source core */
+	dcache_writeback_region(&buffer->consumed, sizeof(buffer->consumed));
+
+	if (buffer->cb && buffer->cb_type & BUFF_CB_TYPE_CONSUME)
+		buffer->cb(buffer->cb_data, bytes);
+}
+
+/* make data produced in this period visible to the sink core */
+static void buffer_xcore_publish(struct comp_buffer *buffer)
+{
+	buffer->produced += buffer_cache_writeback_pending(buffer);
+	buffer->cache_ops_sync = buffer->cache_ops;
+
+	/* the count only after the data it covers */
+	dcache_writeback_region(&buffer->produced, sizeof(buffer->produced));
+}
+
+void buffer_xcore_pull(struct comp_buffer *buffer)
+{
+	uint32_t produced;
+
+	dcache_writeback_invalidate_region(&buffer->produced,
+					   sizeof(buffer->produced));
+	produced = buffer->produced;
+
+	if (produced != buffer->visible) {
+		buffer_xcore_invalidate(buffer,
+					buffer_get_frag(buffer, buffer->r_ptr,
+							buffer->visible -
+							buffer->consumed, 1),
+					produced - buffer->visible);
+		buffer->visible = produced;
+	}
+
+	buffer->avail = produced - buffer->consumed;
+}
+
+void buffer_xcore_reclaim(struct comp_buffer *buffer)
+{
+	dcache_writeback_invalidate_region(&buffer->consumed,
+					   sizeof(buffer->consumed));
+	buffer->free = buffer_xcore_free(buffer);
+}
+#endif
+
 void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes)
 {
 	uint32_t flags;
@@ -131,6 +633,13 @@ void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes)
 		return;
 	}
 
+#if CONFIG_BUFFER_XCORE
+	if (buffer->xcore) {
+		buffer_xcore_produce(buffer, bytes);
+		return;
+	}
+#endif
+
 	spin_lock_irq(&buffer->lock, flags);
 
 	/* calculate head and tail size for dcache circular wrap ops */
@@ -142,22 +651,23 @@ void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes)
 	/*
 	 * new data produce, handle consistency for buffer and cache:
 	 * 1. source(DMA) --> buffer --> sink(non-DMA): invalidate cache.
-	 * 2. source(non-DMA) --> buffer --> sink(DMA): write back to memory.
+	 * 2. source(non-DMA) --> buffer --> sink(DMA): write back to memory,
+	 *    deferred to buffer_cache_sync() so that a stage producing in
+	 *    several chunks writes back once per period.
 	 * 3. source(DMA) --> buffer --> sink(DMA): do nothing.
 	 * 4. source(non-DMA) --> buffer --> sink(non-DMA): do nothing.
 	 */
 	if (buffer->source->is_dma_connected &&
 	    !buffer->sink->is_dma_connected) {
 		/* need invalidate cache for sink component to use */
-		dcache_invalidate_region(buffer->w_ptr, head);
+		buffer_cache_invalidate(buffer, buffer->w_ptr, head);
 		if (tail)
-			dcache_invalidate_region(buffer->addr, tail);
+			buffer_cache_invalidate(buffer, buffer->addr, tail);
 	} else if (!buffer->source->is_dma_connected &&
 		   buffer->sink->is_dma_connected) {
 		/* need write back to memory for sink component to use */
-		dcache_writeback_region(buffer->w_ptr, head);
-		if (tail)
-			dcache_writeback_region(buffer->addr, tail);
+		buffer->cache_pending = MIN(buffer->cache_pending + bytes,
+					    buffer->size);
 	}
 
 	buffer->w_ptr += bytes;
@@ -176,7 +686,7 @@ void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes)
 		buffer->avail = buffer->size - (buffer->r_ptr - buffer->w_ptr);
 
 	/* calculate free bytes */
-	buffer->free = buffer->size - buffer->avail;
+	buffer_update_free(buffer);
 
 	if (buffer->cb && buffer->cb_type & BUFF_CB_TYPE_PRODUCE)
 		buffer->cb(buffer->cb_data, bytes);
@@ -209,6 +719,13 @@ void comp_update_buffer_consume(struct comp_buffer *buffer, uint32_t bytes)
 		return;
 	}
 
+#if CONFIG_BUFFER_XCORE
+	if (buffer->xcore) {
+		buffer_xcore_consume(buffer, bytes);
+		return;
+	}
+#endif
+
 	spin_lock_irq(&buffer->lock, flags);
 
 	buffer->r_ptr += bytes;
@@ -227,11 +744,7 @@ void comp_update_buffer_consume(struct comp_buffer *buffer, uint32_t bytes)
 		buffer->avail = buffer->size - (buffer->r_ptr - buffer->w_ptr);
 
 	/* calculate free bytes */
-	buffer->free = buffer->size - buffer->avail;
-
-	if (buffer->sink->is_dma_connected &&
-	    !buffer->source->is_dma_connected)
-		dcache_writeback_region(buffer->r_ptr, bytes);
+	buffer_update_free(buffer);
 
 	if (buffer->cb && buffer->cb_type & BUFF_CB_TYPE_CONSUME)
 		buffer->cb(buffer->cb_data, bytes);
@@ -248,3 +761,29 @@ void comp_update_buffer_consume(struct comp_buffer *buffer, uint32_t bytes)
 		      (buffer->r_ptr - buffer->addr) << 16 |
 		      (buffer->w_ptr - buffer->addr));
 }
+
+void buffer_cache_sync(struct comp_buffer *buffer)
+{
+	uint32_t flags;
+
+#if CONFIG_BUFFER_XCORE
+	if (buffer->xcore) {
+		buffer_xcore_publish(buffer);
+		return;
+	}
+#endif
+
+	spin_lock_irq(&buffer->lock, flags);
+
+	buffer_cache_writeback_pending(buffer);
+
+	/* operations issued in this period, including invalidations */
+	if (buffer->cache_ops != buffer->cache_ops_sync) {
+		tracev_buffer("buffer_cache_sync(), comp.id = %u, ops = %u",
+			      buffer->ipc_buffer.comp.id,
+			      buffer->cache_ops - buffer->cache_ops_sync);
+		buffer->cache_ops_sync = buffer->cache_ops;
+	}
+
+	spin_unlock_irq(&buffer->lock, flags);
+}
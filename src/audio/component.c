@@ -204,3 +204,66 @@ int comp_get_copy_limits(struct comp_dev *dev, struct comp_copy_limits *cl)
 
 	return 0;
 }
+
+/* copy bytes between buffers, handling wrap of both */
+static void comp_buffer_copy_bytes(struct comp_buffer *source,
+				   struct comp_buffer *sink, uint32_t bytes)
+{
+	char *r = source->r_ptr;
+	char *w = sink->w_ptr;
+	uint32_t n;
+
+	while (bytes) {
+		n = MIN(bytes, (char *)source->end_addr - r);
+		n = MIN(n, (char *)sink->end_addr - w);
+
+		assert(!memcpy_s(w, (char *)sink->end_addr - w, r, n));
+
+		r += n;
+		if (r >= (char *)source->end_addr)
+			r = source->addr;
+
+		w += n;
+		if (w >= (char *)sink->end_addr)
+			w = sink->addr;
+
+		bytes -= n;
+	}
+}
+
+/*
+ * Bypass is a copy fallback. When a component is bypassed by the time it is
+ * prepared, the pipeline aliases its sink onto its source even next to host
+ * or DAI DMA, so data is not copied. The available frames are only copied
+ * unchanged when the buffers can't share memory, e.g. a sink buffer the host
+ * DMA was set up on before the component was prepared.
+ */
+int comp_bypass_copy(struct comp_dev *dev)
+{
+	struct comp_copy_limits cl;
+	int ret;
+
+	ret = comp_get_copy_limits(dev, &cl);
+	if (ret < 0) {
+		trace_comp_error("comp_bypass_copy() error: comp.id = %u "
+				 "no copy limits", dev->comp.id);
+		return ret;
+	}
+
+	/* data can be forwarded only as is */
+	if (cl.source_frame_bytes != cl.sink_frame_bytes) {
+		trace_comp_error("comp_bypass_copy() error: comp.id = %u "
+				 "changes frame size", dev->comp.id);
+		dev->bypass = false;
+		return dev->drv->ops.copy(dev);
+	}
+
+	/* in-place sink already holds the data at its write position */
+	if (cl.sink->alias_source != cl.source)
+		comp_buffer_copy_bytes(cl.source, cl.sink, cl.source_bytes);
+
+	comp_update_buffer_produce(cl.sink, cl.sink_bytes);
+	comp_update_buffer_consume(cl.source, cl.source_bytes);
+
+	return 0;
+}
@@ -399,6 +399,27 @@ static int dai_params(struct comp_dev *dev)
 
 }
 
+/* playback buffer may have been aliased onto the buffer upstream after
+ * params, so move the DMA elems onto its current backing store
+ */
+static void dai_playback_elems_update(struct comp_dev *dev)
+{
+	struct dai_data *dd = comp_get_drvdata(dev);
+	struct dma_sg_elem_array *elem_array = &dd->config.elem_array;
+	uint32_t addr = (uintptr_t)dd->dma_buffer->addr;
+	uint32_t base = elem_array->elems[0].src;
+	int i;
+
+	if (dev->params.direction != SOF_IPC_STREAM_PLAYBACK || base == addr)
+		return;
+
+	trace_dai_with_ids(dev, "dai_playback_elems_update(), "
+			   "dma buffer moved");
+
+	for (i = 0; i < elem_array->count; i++)
+		elem_array->elems[i].src += addr - base;
+}
+
 static int dai_prepare(struct comp_dev *dev)
 {
 	struct dai_data *dd = comp_get_drvdata(dev);
@@ -433,6 +454,8 @@ static int dai_prepare(struct comp_dev *dev)
 		return ret;
 	}
 
+	dai_playback_elems_update(dev);
+
 	ret = dma_set_config(dd->dma, dd->chan, &dd->config);
 	if (ret < 0)
 		comp_set_state(dev, COMP_TRIGGER_RESET);
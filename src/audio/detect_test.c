@@ -89,6 +89,7 @@ static void notify_kpb(struct comp_dev *dev)
 	cd->event.id = NOTIFIER_ID_KPB_CLIENT_EVT;
 	cd->event.target_core_mask = NOTIFIER_TARGET_CORE_ALL_MASK;
 	cd->event.data = &cd->event_data;
+	cd->event.data_size = sizeof(cd->event_data);
 
 	notifier_event(&cd->event);
 }
@@ -741,10 +741,15 @@ static int eq_fir_prepare(struct comp_dev *dev)
 		}
 
 		ret = set_fir_func(dev);
+
+		/* all channels flat, nothing to process */
+		comp_set_bypass(dev, !ret && !cd->fir_delay_size &&
+				cd->source_format == cd->sink_format);
 		return ret;
 	}
 
 	ret = set_pass_func(dev);
+	comp_set_bypass(dev, !ret && cd->source_format == cd->sink_format);
 	return ret;
 
 err:
@@ -760,6 +765,7 @@ static int eq_fir_reset(struct comp_dev *dev)
 	trace_eq("eq_fir_reset()");
 
 	eq_fir_free_delaylines(cd);
+	comp_set_bypass(dev, false);
 
 	cd->eq_fir_func_even = eq_fir_s32_passthrough;
 	cd->eq_fir_func = eq_fir_s32_passthrough;
@@ -814,6 +820,7 @@ static void eq_fir_cache(struct comp_dev *dev, int cmd)
 
 struct comp_driver comp_eq_fir = {
 	.type = SOF_COMP_EQ_FIR,
+	.flags = COMP_DRV_FUSABLE | COMP_DRV_INPLACE,
 	.ops = {
 		.new = eq_fir_new,
 		.free = eq_fir_free,
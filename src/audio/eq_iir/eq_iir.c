@@ -18,6 +18,7 @@
 #include <sof/audio/component.h>
 #include <sof/audio/eq_iir/eq_iir.h>
 #include <sof/audio/format.h>
+#include <sof/audio/format/pcm_converter.h>
 #include <sof/audio/eq_iir/iir.h>
 #include <user/eq.h>
 
@@ -34,6 +35,7 @@ struct comp_data {
 	enum sof_ipc_frame sink_format;     /**< sink frame format */
 	int64_t *iir_delay;		    /**< pointer to allocated RAM */
 	size_t iir_delay_size;		    /**< allocated size */
+	const struct pcm_func_map *pass;    /**< pass-through converter */
 	void (*eq_iir_func)(struct comp_dev *dev,
 			    struct comp_buffer *source,
 			    struct comp_buffer *sink,
@@ -187,23 +189,6 @@ static void eq_iir_s32_24_default(struct comp_dev *dev,
 	}
 }
 
-static void eq_iir_s16_pass(struct comp_dev *dev,
-			    struct comp_buffer *source,
-			    struct comp_buffer *sink,
-			    uint32_t frames)
-{
-	int16_t *x;
-	int16_t *y;
-	int i;
-	int n = frames * dev->params.channels;
-
-	for (i = 0; i < n; i++) {
-		x = buffer_read_frag_s16(source, i);
-		y = buffer_write_frag_s16(sink, i);
-		*y = *x;
-	}
-}
-
 static void eq_iir_s32_pass(struct comp_dev *dev,
 			    struct comp_buffer *source,
 			    struct comp_buffer *sink,
@@ -221,38 +206,15 @@ static void eq_iir_s32_pass(struct comp_dev *dev,
 	}
 }
 
-static void eq_iir_s32_s16_pass(struct comp_dev *dev,
-				struct comp_buffer *source,
-				struct comp_buffer *sink,
-				uint32_t frames)
-{
-	int32_t *x;
-	int16_t *y;
-	int i;
-	int n = frames * dev->params.channels;
-
-	for (i = 0; i < n; i++) {
-		x = buffer_read_frag_s32(source, i);
-		y = buffer_write_frag_s16(sink, i);
-		*y = sat_int16(Q_SHIFT_RND(*x, 31, 15));
-	}
-}
-
-static void eq_iir_s32_s24_pass(struct comp_dev *dev,
-				struct comp_buffer *source,
-				struct comp_buffer *sink,
-				uint32_t frames)
+static void eq_iir_pass(struct comp_dev *dev,
+			struct comp_buffer *source,
+			struct comp_buffer *sink,
+			uint32_t frames)
 {
-	int32_t *x;
-	int32_t *y;
-	int i;
-	int n = frames * dev->params.channels;
+	struct comp_data *cd = comp_get_drvdata(dev);
 
-	for (i = 0; i < n; i++) {
-		x = buffer_read_frag_s32(source, i);
-		y = buffer_write_frag_s16(sink, i);
-		*y = sat_int24(Q_SHIFT_RND(*x, 31, 23));
-	}
+	pcm_convert(cd->pass, source, 0, sink, 0,
+		    frames * dev->params.channels);
 }
 
 const struct eq_iir_func_map fm_configured[] = {
@@ -267,18 +229,6 @@ const struct eq_iir_func_map fm_configured[] = {
 	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  eq_iir_s32_default},
 };
 
-const struct eq_iir_func_map fm_passthrough[] = {
-	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_s16_pass},
-	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S24_4LE, NULL},
-	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S32_LE,  NULL},
-	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE,  NULL},
-	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, eq_iir_s32_pass},
-	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE,  NULL},
-	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_s32_s16_pass},
-	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S24_4LE, eq_iir_s32_s24_pass},
-	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  eq_iir_s32_pass},
-};
-
 static eq_iir_func eq_iir_find_func(struct comp_data *cd,
 				    const struct eq_iir_func_map *map,
 				    int n)
@@ -799,10 +749,14 @@ static int eq_iir_prepare(struct comp_dev *dev)
 			goto err;
 		}
 		trace_eq("eq_iir_prepare(), IIR is configured.");
+
+		/* all channels flat, nothing to process */
+		comp_set_bypass(dev, !cd->iir_delay_size &&
+				cd->source_format == cd->sink_format);
 	} else {
-		cd->eq_iir_func = eq_iir_find_func(cd, fm_passthrough,
-						   ARRAY_SIZE(fm_passthrough));
-		if (!cd->eq_iir_func) {
+		cd->pass = pcm_get_conversion(cd->source_format,
+					      cd->sink_format);
+		if (!cd->pass) {
 			trace_eq_error("eq_iir_prepare() error: "
 					"No processing function available, "
 					"for pass-through mode.");
@@ -810,7 +764,10 @@ static int eq_iir_prepare(struct comp_dev *dev)
 			ret = -EINVAL;
 			goto err;
 		}
+		cd->eq_iir_func = eq_iir_pass;
 		trace_eq("eq_iir_prepare(), pass-through mode.");
+
+		comp_set_bypass(dev, cd->source_format == cd->sink_format);
 	}
 	return 0;
 
@@ -827,6 +784,7 @@ static int eq_iir_reset(struct comp_dev *dev)
 	trace_eq("eq_iir_reset()");
 
 	eq_iir_free_delaylines(cd);
+	comp_set_bypass(dev, false);
 
 	cd->eq_iir_func = eq_iir_s32_default;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
@@ -881,6 +839,7 @@ static void eq_iir_cache(struct comp_dev *dev, int cmd)
 
 struct comp_driver comp_eq_iir = {
 	.type = SOF_COMP_EQ_IIR,
+	.flags = COMP_DRV_FUSABLE | COMP_DRV_INPLACE,
 	.ops = {
 		.new = eq_iir_new,
 		.free = eq_iir_free,
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/**
+ * \file audio/format/pcm_converter.c
+ * \brief PCM sample format conversion between circular buffers
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sof/sof.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/format/pcm_converter.h>
+#include <sof/debug.h>
+
+static void pcm_copy_16(const void *source, void *sink, uint32_t samples)
+{
+	size_t bytes = samples * sizeof(int16_t);
+
+	/* nothing to move when processing in place */
+	if (source != sink)
+		assert(!memcpy_s(sink, bytes, source, bytes));
+}
+
+static void pcm_copy_32(const void *source, void *sink, uint32_t samples)
+{
+	size_t bytes = samples * sizeof(int32_t);
+
+	/* nothing to move when processing in place */
+	if (source != sink)
+		assert(!memcpy_s(sink, bytes, source, bytes));
+}
+
+static const struct pcm_func_map pcm_copy_map[] = {
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  pcm_copy_16},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, pcm_copy_32},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  pcm_copy_32},
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_FLOAT,   pcm_copy_32},
+};
+
+static uint32_t pcm_sample_bytes(uint8_t frame_fmt)
+{
+	return frame_fmt == SOF_IPC_FRAME_S16_LE ? sizeof(int16_t) :
+		sizeof(int32_t);
+}
+
+static const struct pcm_func_map *pcm_find(const struct pcm_func_map *map,
+					   size_t n, enum sof_ipc_frame source,
+					   enum sof_ipc_frame sink)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		if ((uint8_t)source == map[i].source &&
+		    (uint8_t)sink == map[i].sink)
+			return &map[i];
+	}
+
+	return NULL;
+}
+
+const struct pcm_func_map *pcm_get_conversion(enum sof_ipc_frame source,
+					      enum sof_ipc_frame sink)
+{
+	if (source == sink)
+		return pcm_find(pcm_copy_map, ARRAY_SIZE(pcm_copy_map),
+				source, sink);
+
+	return pcm_find(pcm_func_map, pcm_func_count, source, sink);
+}
+
+void pcm_convert(const struct pcm_func_map *conv, struct comp_buffer *source,
+		 uint32_t ioffset, struct comp_buffer *sink, uint32_t ooffset,
+		 uint32_t samples)
+{
+	uint32_t isize = pcm_sample_bytes(conv->source);
+	uint32_t osize = pcm_sample_bytes(conv->sink);
+	uint8_t *in = buffer_read_frag(source, ioffset, isize);
+	uint8_t *out = buffer_write_frag(sink, ooffset, osize);
+	uint32_t n;
+	uint32_t n_out;
+
+	/* convert contiguous runs up to the nearest wrap */
+	while (samples) {
+		n = ((uint8_t *)source->end_addr - in) / isize;
+		n_out = ((uint8_t *)sink->end_addr - out) / osize;
+		if (n_out < n)
+			n = n_out;
+		if (samples < n)
+			n = samples;
+
+		conv->func(in, out, n);
+
+		samples -= n;
+		in += n * isize;
+		out += n * osize;
+		if (in >= (uint8_t *)source->end_addr)
+			in = source->addr;
+		if (out >= (uint8_t *)sink->end_addr)
+			out = sink->addr;
+	}
+}
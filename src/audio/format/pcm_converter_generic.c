@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/**
+ * \file audio/format/pcm_converter_generic.c
+ * \brief PCM sample format conversion generic implementation
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sof/sof.h>
+#include <sof/audio/format/pcm_converter.h>
+
+#if PCM_CONVERTER_GENERIC
+
+static void pcm_convert_s16_to_s24(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int16_t *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s16_to_s24(in[i]);
+}
+
+static void pcm_convert_s16_to_s32(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int16_t *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s16_to_s32(in[i]);
+}
+
+static void pcm_convert_s16_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int16_t *in = source;
+	float *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s16_to_float(in[i]);
+}
+
+static void pcm_convert_s24_to_s16(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int32_t *in = source;
+	int16_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s24_to_s16(in[i]);
+}
+
+static void pcm_convert_s24_to_s32(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int32_t *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s24_to_s32(in[i]);
+}
+
+static void pcm_convert_s24_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int32_t *in = source;
+	float *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s24_to_float(in[i]);
+}
+
+static void pcm_convert_s32_to_s16(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int32_t *in = source;
+	int16_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s32_to_s16(in[i]);
+}
+
+static void pcm_convert_s32_to_s24(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int32_t *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s32_to_s24(in[i]);
+}
+
+static void pcm_convert_s32_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int32_t *in = source;
+	float *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s32_to_float(in[i]);
+}
+
+static void pcm_convert_float_to_s16(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int16_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_float_to_s16(in[i]);
+}
+
+static void pcm_convert_float_to_s24(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_float_to_s24(in[i]);
+}
+
+static void pcm_convert_float_to_s32(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_float_to_s32(in[i]);
+}
+
+const struct pcm_func_map pcm_func_map[] = {
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S24_4LE, pcm_convert_s16_to_s24},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S32_LE,  pcm_convert_s16_to_s32},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_FLOAT, pcm_convert_s16_to_float},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE,  pcm_convert_s24_to_s16},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE,  pcm_convert_s24_to_s32},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_FLOAT, pcm_convert_s24_to_float},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S16_LE,  pcm_convert_s32_to_s16},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S24_4LE, pcm_convert_s32_to_s24},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_FLOAT, pcm_convert_s32_to_float},
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_S16_LE, pcm_convert_float_to_s16},
+	{SOF_IPC_FRAME_FLOAT, SOF_IPC_FRAME_S24_4LE, pcm_convert_float_to_s24},
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_S32_LE, pcm_convert_float_to_s32},
+};
+
+const size_t pcm_func_count = ARRAY_SIZE(pcm_func_map);
+
+#endif
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/**
+ * \file audio/format/pcm_converter_hifi3.c
+ * \brief PCM sample format conversion HiFi3 implementation
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sof/sof.h>
+#include <sof/audio/format/pcm_converter.h>
+
+#if PCM_CONVERTER_HIFI3
+
+#include <xtensa/tie/xt_hifi3.h>
+
+static void pcm_convert_s16_to_s24(const void *source, void *sink,
+				   uint32_t samples)
+{
+	ae_int16 *in = (ae_int16 *)source;
+	ae_int32 *out = sink;
+	ae_f16x4 sample = AE_ZERO16();
+	ae_f32x2 out_sample;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		AE_L16_XP(sample, in, sizeof(ae_int16));
+
+		/* Q1.15 to Q1.31 and down to Q1.23 */
+		out_sample = AE_CVT32X2F16_32(sample);
+		out_sample = AE_SRAA32(out_sample, 8);
+		AE_S32_L_XP(out_sample, out, sizeof(ae_int32));
+	}
+}
+
+static void pcm_convert_s16_to_s32(const void *source, void *sink,
+				   uint32_t samples)
+{
+	ae_int16 *in = (ae_int16 *)source;
+	ae_int32 *out = sink;
+	ae_f16x4 sample = AE_ZERO16();
+	ae_f32x2 out_sample;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		AE_L16_XP(sample, in, sizeof(ae_int16));
+		out_sample = AE_CVT32X2F16_32(sample);
+		AE_S32_L_XP(out_sample, out, sizeof(ae_int32));
+	}
+}
+
+static void pcm_convert_s24_to_s16(const void *source, void *sink,
+				   uint32_t samples)
+{
+	ae_int32 *in = (ae_int32 *)source;
+	ae_int16 *out = sink;
+	ae_f32x2 sample = AE_ZERO32();
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		AE_L32_XP(sample, in, sizeof(ae_int32));
+
+		/* drop container bits, then round Q1.31 to Q1.15 */
+		sample = AE_SLAA32(sample, 8);
+		AE_S16_0_XP(AE_ROUND16X4F32SASYM(sample, sample), out,
+			    sizeof(ae_int16));
+	}
+}
+
+static void pcm_convert_s24_to_s32(const void *source, void *sink,
+				   uint32_t samples)
+{
+	ae_int32 *in = (ae_int32 *)source;
+	ae_int32 *out = sink;
+	ae_f32x2 sample = AE_ZERO32();
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		AE_L32_XP(sample, in, sizeof(ae_int32));
+		sample = AE_SLAA32(sample, 8);
+		AE_S32_L_XP(sample, out, sizeof(ae_int32));
+	}
+}
+
+static void pcm_convert_s32_to_s16(const void *source, void *sink,
+				   uint32_t samples)
+{
+	ae_int32 *in = (ae_int32 *)source;
+	ae_int16 *out = sink;
+	ae_f32x2 sample = AE_ZERO32();
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		AE_L32_XP(sample, in, sizeof(ae_int32));
+		AE_S16_0_XP(AE_ROUND16X4F32SASYM(sample, sample), out,
+			    sizeof(ae_int16));
+	}
+}
+
+static void pcm_convert_s32_to_s24(const void *source, void *sink,
+				   uint32_t samples)
+{
+	ae_int32 *in = (ae_int32 *)source;
+	ae_int32 *out = sink;
+	ae_f32x2 sample = AE_ZERO32();
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		AE_L32_XP(sample, in, sizeof(ae_int32));
+
+		/* round to Q1.23 and saturate to the 24 bit range */
+		sample = AE_SRAA32RS(sample, 8);
+		sample = AE_SLAA32S(sample, 8);
+		sample = AE_SRAA32(sample, 8);
+		AE_S32_L_XP(sample, out, sizeof(ae_int32));
+	}
+}
+
+/* HiFi3 has no vector floating point, float uses the scalar FPU */
+
+static void pcm_convert_s16_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int16_t *in = source;
+	float *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s16_to_float(in[i]);
+}
+
+static void pcm_convert_s24_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int32_t *in = source;
+	float *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s24_to_float(in[i]);
+}
+
+static void pcm_convert_s32_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int32_t *in = source;
+	float *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_s32_to_float(in[i]);
+}
+
+static void pcm_convert_float_to_s16(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int16_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_float_to_s16(in[i]);
+}
+
+static void pcm_convert_float_to_s24(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_float_to_s24(in[i]);
+}
+
+static void pcm_convert_float_to_s32(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		out[i] = pcm_float_to_s32(in[i]);
+}
+
+const struct pcm_func_map pcm_func_map[] = {
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S24_4LE, pcm_convert_s16_to_s24},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S32_LE,  pcm_convert_s16_to_s32},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_FLOAT, pcm_convert_s16_to_float},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE,  pcm_convert_s24_to_s16},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE,  pcm_convert_s24_to_s32},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_FLOAT, pcm_convert_s24_to_float},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S16_LE,  pcm_convert_s32_to_s16},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S24_4LE, pcm_convert_s32_to_s24},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_FLOAT, pcm_convert_s32_to_float},
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_S16_LE, pcm_convert_float_to_s16},
+	{SOF_IPC_FRAME_FLOAT, SOF_IPC_FRAME_S24_4LE, pcm_convert_float_to_s24},
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_S32_LE, pcm_convert_float_to_s32},
+};
+
+const size_t pcm_func_count = ARRAY_SIZE(pcm_func_map);
+
+#endif
@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/**
+ * \file audio/format/pcm_converter_sse.c
+ * \brief PCM sample format conversion SSE2 implementation for the host
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sof/sof.h>
+#include <sof/audio/format/pcm_converter.h>
+
+#if PCM_CONVERTER_SSE
+
+#include <emmintrin.h>
+
+/* samples per 128 bit vector of 32 bit samples */
+#define PCM_SSE_SAMPLES	4
+
+static inline __m128i pcm_sse_load_s16(const int16_t *in)
+{
+	/* sample in the upper half of each 32 bit lane, Q1.31 */
+	return _mm_unpacklo_epi16(_mm_setzero_si128(),
+				  _mm_loadl_epi64((const __m128i *)in));
+}
+
+static inline __m128i pcm_sse_s32_to_s24(__m128i x)
+{
+	/* round half up to Q1.23, only the positive end can overflow */
+	x = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(x, 7),
+					 _mm_set1_epi32(1)), 1);
+
+	return _mm_add_epi32(x, _mm_cmpgt_epi32(x,
+				_mm_set1_epi32(INT24_MAXVALUE)));
+}
+
+static inline void pcm_sse_store_s16(int16_t *out, __m128i x)
+{
+	/* round half up to Q1.15, pack saturates */
+	x = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(x, 15),
+					 _mm_set1_epi32(1)), 1);
+	_mm_storel_epi64((__m128i *)out, _mm_packs_epi32(x, x));
+}
+
+/* Scales x, limits it and rounds half away from zero, NaN to zero.
+ * Lanes reaching a limit of 2^31 overflow and must be saturated by
+ * the caller.
+ */
+static inline __m128i pcm_sse_float_round(__m128 x, float scale,
+					  float limit)
+{
+	__m128 y = _mm_mul_ps(x, _mm_set1_ps(scale));
+	__m128i t;
+	__m128 r;
+
+	y = _mm_and_ps(y, _mm_cmpord_ps(y, y));
+	y = _mm_max_ps(y, _mm_set1_ps(-limit));
+	y = _mm_min_ps(y, _mm_set1_ps(limit));
+
+	t = _mm_cvttps_epi32(y);
+	r = _mm_sub_ps(y, _mm_cvtepi32_ps(t));
+	t = _mm_sub_epi32(t, _mm_castps_si128(_mm_cmpge_ps(r,
+						_mm_set1_ps(0.5f))));
+	t = _mm_add_epi32(t, _mm_castps_si128(_mm_cmple_ps(r,
+						_mm_set1_ps(-0.5f))));
+
+	return t;
+}
+
+static inline __m128i pcm_sse_sat(__m128i x, int32_t min, int32_t max)
+{
+	__m128i hi = _mm_cmpgt_epi32(x, _mm_set1_epi32(max));
+	__m128i lo = _mm_cmplt_epi32(x, _mm_set1_epi32(min));
+
+	x = _mm_or_si128(_mm_andnot_si128(hi, x),
+			 _mm_and_si128(hi, _mm_set1_epi32(max)));
+
+	return _mm_or_si128(_mm_andnot_si128(lo, x),
+			    _mm_and_si128(lo, _mm_set1_epi32(min)));
+}
+
+static void pcm_convert_s16_to_s24(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int16_t *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES)
+		_mm_storeu_si128((__m128i *)(out + i),
+				 _mm_srai_epi32(pcm_sse_load_s16(in + i), 8));
+
+	for (; i < samples; i++)
+		out[i] = pcm_s16_to_s24(in[i]);
+}
+
+static void pcm_convert_s16_to_s32(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int16_t *in = source;
+	int32_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES)
+		_mm_storeu_si128((__m128i *)(out + i),
+				 pcm_sse_load_s16(in + i));
+
+	for (; i < samples; i++)
+		out[i] = pcm_s16_to_s32(in[i]);
+}
+
+static void pcm_convert_s16_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int16_t *in = source;
+	float *out = sink;
+	__m128i x;
+	uint32_t i;
+
+	/* Q1.31 with zero low bits converts exactly */
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		x = pcm_sse_load_s16(in + i);
+		_mm_storeu_ps(out + i,
+			      _mm_mul_ps(_mm_cvtepi32_ps(x),
+					 _mm_set1_ps(1.0f / 2147483648.0f)));
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_s16_to_float(in[i]);
+}
+
+static void pcm_convert_s24_to_s16(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int32_t *in = source;
+	int16_t *out = sink;
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		x = _mm_loadu_si128((const __m128i *)(in + i));
+		pcm_sse_store_s16(out + i, _mm_slli_epi32(x, 8));
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_s24_to_s16(in[i]);
+}
+
+static void pcm_convert_s24_to_s32(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int32_t *in = source;
+	int32_t *out = sink;
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		x = _mm_loadu_si128((const __m128i *)(in + i));
+		_mm_storeu_si128((__m128i *)(out + i), _mm_slli_epi32(x, 8));
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_s24_to_s32(in[i]);
+}
+
+static void pcm_convert_s24_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int32_t *in = source;
+	float *out = sink;
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		x = _mm_slli_epi32(_mm_loadu_si128((const __m128i *)(in + i)),
+				   8);
+		_mm_storeu_ps(out + i,
+			      _mm_mul_ps(_mm_cvtepi32_ps(x),
+					 _mm_set1_ps(1.0f / 2147483648.0f)));
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_s24_to_float(in[i]);
+}
+
+static void pcm_convert_s32_to_s16(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int32_t *in = source;
+	int16_t *out = sink;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES)
+		pcm_sse_store_s16(out + i,
+				  _mm_loadu_si128((const __m128i *)(in + i)));
+
+	for (; i < samples; i++)
+		out[i] = pcm_s32_to_s16(in[i]);
+}
+
+static void pcm_convert_s32_to_s24(const void *source, void *sink,
+				   uint32_t samples)
+{
+	const int32_t *in = source;
+	int32_t *out = sink;
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		x = _mm_loadu_si128((const __m128i *)(in + i));
+		_mm_storeu_si128((__m128i *)(out + i), pcm_sse_s32_to_s24(x));
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_s32_to_s24(in[i]);
+}
+
+static void pcm_convert_s32_to_float(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const int32_t *in = source;
+	float *out = sink;
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		x = _mm_loadu_si128((const __m128i *)(in + i));
+		_mm_storeu_ps(out + i,
+			      _mm_mul_ps(_mm_cvtepi32_ps(x),
+					 _mm_set1_ps(1.0f / 2147483648.0f)));
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_s32_to_float(in[i]);
+}
+
+static void pcm_convert_float_to_s16(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int16_t *out = sink;
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		x = pcm_sse_float_round(_mm_loadu_ps(in + i), 32768.0f,
+					65536.0f);
+		_mm_storel_epi64((__m128i *)(out + i), _mm_packs_epi32(x, x));
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_float_to_s16(in[i]);
+}
+
+static void pcm_convert_float_to_s24(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int32_t *out = sink;
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		x = pcm_sse_float_round(_mm_loadu_ps(in + i), 8388608.0f,
+					16777216.0f);
+		_mm_storeu_si128((__m128i *)(out + i),
+				 pcm_sse_sat(x, INT24_MINVALUE,
+					     INT24_MAXVALUE));
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_float_to_s24(in[i]);
+}
+
+static void pcm_convert_float_to_s32(const void *source, void *sink,
+				     uint32_t samples)
+{
+	const float *in = source;
+	int32_t *out = sink;
+	__m128 y;
+	__m128i hi;
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + PCM_SSE_SAMPLES <= samples; i += PCM_SSE_SAMPLES) {
+		y = _mm_loadu_ps(in + i);
+		x = pcm_sse_float_round(y, 2147483648.0f, 2147483648.0f);
+
+		/* conversion overflow gives INT32_MIN, fix positive end */
+		hi = _mm_castps_si128(_mm_cmpge_ps(y, _mm_set1_ps(1.0f)));
+		x = _mm_or_si128(_mm_andnot_si128(hi, x),
+				 _mm_and_si128(hi, _mm_set1_epi32(INT32_MAX)));
+		_mm_storeu_si128((__m128i *)(out + i), x);
+	}
+
+	for (; i < samples; i++)
+		out[i] = pcm_float_to_s32(in[i]);
+}
+
+const struct pcm_func_map pcm_func_map[] = {
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S24_4LE, pcm_convert_s16_to_s24},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S32_LE,  pcm_convert_s16_to_s32},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_FLOAT, pcm_convert_s16_to_float},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE,  pcm_convert_s24_to_s16},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE,  pcm_convert_s24_to_s32},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_FLOAT, pcm_convert_s24_to_float},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S16_LE,  pcm_convert_s32_to_s16},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S24_4LE, pcm_convert_s32_to_s24},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_FLOAT, pcm_convert_s32_to_float},
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_S16_LE, pcm_convert_float_to_s16},
+	{SOF_IPC_FRAME_FLOAT, SOF_IPC_FRAME_S24_4LE, pcm_convert_float_to_s24},
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_S32_LE, pcm_convert_float_to_s32},
+};
+
+const size_t pcm_func_count = ARRAY_SIZE(pcm_func_map);
+
+#endif
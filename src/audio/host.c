@@ -44,7 +44,8 @@ struct hc_buf {
  *
  * Host reports local position in the host buffer every params.host_period_bytes
  * if the latter is != 0. report_pos is used to track progress since the last
- * multiple of host_period_bytes.
+ * multiple of host_period_bytes. With SOF_PCM_FLAG_POSN_SHARED the position
+ * is also published in the stream region every period without an IPC.
  *
  * host_size is the host buffer size (in bytes) specified in the IPC parameters.
  */
@@ -63,6 +64,7 @@ struct host_data {
 
 	/* host component attributes */
 	enum comp_copy_type copy_type;	/**< Current host copy type */
+	uint32_t pcm_flags;		/**< SOF_PCM_FLAG_ from PCM params */
 
 	/* local and host DMA buffer info */
 	struct hc_buf host;
@@ -124,8 +126,15 @@ static void host_update_position(struct comp_dev *dev, uint32_t bytes)
 			 */
 			pipeline_get_timestamp(dev->pipeline, dev, &hd->posn);
 			ipc_stream_send_position(dev, &hd->posn);
+			return;
 		}
 	}
+
+	/* host polls the stream region, publish every period without IPC */
+	if (hd->pcm_flags & SOF_PCM_FLAG_POSN_SHARED) {
+		pipeline_get_timestamp(dev->pipeline, dev, &hd->posn);
+		ipc_stream_publish_position(dev, &hd->posn);
+	}
 }
 
 /* The host memory is not guaranteed to be continuous and also not guaranteed
@@ -774,6 +783,9 @@ static int host_set_attribute(struct comp_dev *dev, uint32_t type,
 	case COMP_ATTR_HOST_BUFFER:
 		hd->host.elem_array = *(struct dma_sg_elem_array *)value;
 		break;
+	case COMP_ATTR_PCM_FLAGS:
+		hd->pcm_flags = *(uint32_t *)value;
+		break;
 	default:
 		return -EINVAL;
 	}
@@ -831,8 +831,12 @@ static uint64_t kpb_draining_task(void *arg)
 			buff = buff->next;
 			move_buffer = false;
 		}
-		if (size_to_copy)
+		if (size_to_copy) {
 			comp_update_buffer_produce(sink, size_to_copy);
+
+			/* host DMA drains concurrently, write back now */
+			buffer_cache_sync(sink);
+		}
 	}
 
 	time =  platform_timer_get(platform_timer) - time;
@@ -67,9 +67,35 @@ struct pipeline *pipeline_new(struct sof_ipc_pipe_new *pipe_desc,
 	schedule_task_init(&p->pipe_task, type, pipe_desc->priority,
 			   pipeline_task, p, pipe_desc->core, 0);
 
+	/* measured on the pipeline core, read by the master core */
+	p->pipe_task.run_max = rzalloc(RZONE_RUNTIME | RZONE_FLAG_UNCACHED,
+				       SOF_MEM_CAPS_RAM,
+				       sizeof(*p->pipe_task.run_max));
+	if (!p->pipe_task.run_max) {
+		trace_pipe_error("pipeline_new() error: Out of Memory");
+		schedule_task_free(&p->pipe_task);
+		rfree(p);
+		return NULL;
+	}
+
 	return p;
 }
 
+#if CONFIG_BUFFER_XCORE
+/* buffer between pipelines placed on different cores, components get
+ * their pipeline once it is completed
+ */
+static void pipeline_buffer_xcore(struct comp_buffer *buffer)
+{
+	struct pipeline *source = buffer->source ?
+		buffer->source->pipeline : NULL;
+	struct pipeline *sink = buffer->sink ? buffer->sink->pipeline : NULL;
+
+	buffer->xcore = source && sink &&
+		source->ipc_pipe.core != sink->ipc_pipe.core;
+}
+#endif
+
 int pipeline_connect(struct comp_dev *comp, struct comp_buffer *buffer,
 		     int dir)
 {
@@ -80,6 +106,10 @@ int pipeline_connect(struct comp_dev *comp, struct comp_buffer *buffer,
 	list_item_prepend(buffer_comp_list(buffer, dir),
 			  comp_buffer_list(comp, dir));
 	buffer_set_comp(buffer, comp, dir);
+
+#if CONFIG_BUFFER_XCORE
+	pipeline_buffer_xcore(buffer);
+#endif
 	spin_unlock(&comp->lock);
 
 	return 0;
@@ -125,6 +155,180 @@ static int pipeline_for_each_comp(struct comp_dev *current,
 	return err;
 }
 
+/* component with exactly one source and one sink buffer */
+static inline bool pipeline_comp_is_single_io(struct comp_dev *dev)
+{
+	return !list_is_empty(&dev->bsource_list) &&
+		list_item_is_last(dev->bsource_list.next, &dev->bsource_list) &&
+		!list_is_empty(&dev->bsink_list) &&
+		list_item_is_last(dev->bsink_list.next, &dev->bsink_list);
+}
+
+#if CONFIG_PIPELINE_FUSION
+/* number of frames copied by each stage of a fused chain at a time */
+static uint32_t pipeline_fuse_tile(struct comp_dev *dev)
+{
+	return MAX(MIN(CONFIG_PIPELINE_FUSION_TILE_FRAMES, dev->frames), 1);
+}
+
+/* single source and single sink processing stage of pipeline p */
+static bool pipeline_comp_is_fusable(struct comp_dev *dev, struct pipeline *p)
+{
+	return dev && dev->pipeline == p && pipeline_comp_is_single_io(dev) &&
+		(dev->drv->flags & COMP_DRV_FUSABLE);
+}
+
+/* append component to the fused chain of its upstream neighbour */
+static void pipeline_comp_fuse(struct comp_dev *current)
+{
+	struct comp_buffer *buffer;
+	struct comp_dev *prev;
+
+	current->fuse_head = NULL;
+	current->fuse_next = NULL;
+
+	if (!pipeline_comp_is_fusable(current, current->pipeline))
+		return;
+
+	buffer = list_first_item(&current->bsource_list, struct comp_buffer,
+				 sink_list);
+	prev = buffer->source;
+	if (!pipeline_comp_is_fusable(prev, current->pipeline))
+		return;
+
+	if (!prev->fuse_head)
+		prev->fuse_head = prev;
+	prev->fuse_next = current;
+	current->fuse_head = prev->fuse_head;
+
+	trace_pipe_with_ids(current->pipeline, "pipeline_comp_fuse(), "
+			    "comp.id = %u fused after %u, head %u",
+			    current->comp.id, prev->comp.id,
+			    current->fuse_head->comp.id);
+}
+
+/* shrink backing store of the buffer between two fused stages to a tile */
+static void pipeline_comp_fuse_tile(struct comp_dev *current)
+{
+	struct comp_buffer *sink;
+	uint32_t bytes;
+
+	if (!current->fuse_next)
+		return;
+
+	sink = list_first_item(&current->bsink_list, struct comp_buffer,
+			       source_list);
+	if (sink->alias_source)
+		return;
+
+	bytes = comp_period_bytes(sink->sink, pipeline_fuse_tile(current));
+	if (bytes && bytes < sink->size)
+		buffer_set_size(sink, bytes);
+}
+
+/* Copy a fused chain tile by tile. Every stage copies at most one tile
+ * as limited by the buffer to its successor, so data produced by one
+ * stage is consumed by the next one while it is still in cache.
+ */
+static int pipeline_fused_copy(struct comp_dev *head)
+{
+	struct comp_buffer *source;
+	struct comp_dev *stage;
+	uint32_t tiles;
+	void *r_ptr;
+	int err;
+
+	source = list_first_item(&head->bsource_list, struct comp_buffer,
+				 sink_list);
+
+	/* bound the loop by the input available when we started */
+	tiles = source->avail / comp_frame_bytes(source->source) /
+		pipeline_fuse_tile(head) + 1;
+
+	while (tiles--) {
+		r_ptr = source->r_ptr;
+
+		for (stage = head; stage; stage = stage->fuse_next) {
+			if (!comp_is_active(stage))
+				break;
+
+			err = comp_copy(stage);
+			if (err < 0)
+				return err;
+		}
+
+		/* stop once the first stage can't take any more input */
+		if (source->r_ptr == r_ptr)
+			break;
+	}
+
+	return 0;
+}
+#endif
+
+/* write back what the component produced for DMA in this period */
+static void pipeline_stage_cache_sync(struct comp_dev *current)
+{
+	struct list_item *clist;
+	struct comp_buffer *buffer;
+
+	list_for_item(clist, &current->bsink_list) {
+		buffer = container_of(clist, struct comp_buffer, source_list);
+		buffer_cache_sync(buffer);
+	}
+}
+
+#if CONFIG_BUFFER_XCORE
+/* take data and space published by pipelines on other cores */
+static void pipeline_stage_xcore_sync(struct comp_dev *current)
+{
+	struct list_item *clist;
+	struct comp_buffer *buffer;
+
+	list_for_item(clist, &current->bsource_list) {
+		buffer = container_of(clist, struct comp_buffer, sink_list);
+		if (buffer->xcore)
+			buffer_xcore_pull(buffer);
+	}
+
+	list_for_item(clist, &current->bsink_list) {
+		buffer = container_of(clist, struct comp_buffer, source_list);
+		if (buffer->xcore)
+			buffer_xcore_reclaim(buffer);
+	}
+}
+#else
+static inline void pipeline_stage_xcore_sync(struct comp_dev *current) { }
+#endif
+
+/* copy component, fused chains are copied as a whole by their head */
+static int pipeline_stage_copy(struct comp_dev *current)
+{
+	int err;
+#if CONFIG_PIPELINE_FUSION
+	struct comp_dev *stage;
+
+	if (current->fuse_head == current) {
+		for (stage = current; stage; stage = stage->fuse_next)
+			pipeline_stage_xcore_sync(stage);
+
+		err = pipeline_fused_copy(current);
+
+		for (stage = current; stage; stage = stage->fuse_next)
+			pipeline_stage_cache_sync(stage);
+
+		return err;
+	}
+	if (current->fuse_head)
+		return 0;
+#endif
+	pipeline_stage_xcore_sync(current);
+	err = comp_copy(current);
+	pipeline_stage_cache_sync(current);
+
+	return err;
+}
+
 static int pipeline_comp_complete(struct comp_dev *current, void *data,
 				  int dir)
 {
@@ -144,12 +348,140 @@ static int pipeline_comp_complete(struct comp_dev *current, void *data,
 	current->pipeline = ppl_data->p;
 	current->frames = ppl_data->p->ipc_pipe.frames_per_sched;
 
+#if CONFIG_PIPELINE_FUSION
+	pipeline_comp_fuse(current);
+#endif
+
 	pipeline_for_each_comp(current, &pipeline_comp_complete, data,
 			       NULL, dir);
 
 	return 0;
 }
 
+#if CONFIG_PIPELINE_ARENA
+/* pipeline arena reservation data */
+struct pipeline_arena_data {
+	struct comp_dev *start;
+	struct pipeline *p;
+	struct mm_arena *arena;
+	uint32_t size;
+	uint32_t caps;
+};
+
+/* move buffer data into the pipeline arena, buffers are still empty */
+static void pipeline_buffer_to_arena(struct mm_arena *arena,
+				     struct comp_buffer *buffer)
+{
+	void *addr;
+
+	if (buffer->addr >= arena->base &&
+	    buffer->addr < (void *)((char *)arena->base + arena->size))
+		return;
+
+	addr = arena_alloc(arena, buffer->ipc_buffer.size);
+	if (!addr)
+		return;
+
+	rfree(buffer->addr);
+	buffer->addr = addr;
+	buffer_init(buffer, buffer->ipc_buffer.size);
+}
+
+static int pipeline_comp_arena(struct comp_dev *current, void *data, int dir)
+{
+	struct pipeline_arena_data *arena_data = data;
+	struct list_item *clist;
+	struct comp_buffer *buffer;
+
+	if (!comp_is_single_pipeline(current, arena_data->start))
+		return 0;
+
+	/* size up or move the buffers owned by this pipeline */
+	list_for_item(clist, comp_buffer_list(current, dir)) {
+		buffer = buffer_from_list(clist, struct comp_buffer, dir);
+		if (buffer->ipc_buffer.comp.pipeline_id !=
+		    arena_data->p->ipc_pipe.pipeline_id)
+			continue;
+
+		if (arena_data->arena) {
+			pipeline_buffer_to_arena(arena_data->arena, buffer);
+		} else {
+			arena_data->size += ALIGN_UP(buffer->ipc_buffer.size,
+						     PLATFORM_DCACHE_ALIGN);
+			arena_data->caps |= buffer->ipc_buffer.caps;
+		}
+	}
+
+	return pipeline_for_each_comp(current, &pipeline_comp_arena, data,
+				      NULL, dir);
+}
+
+/* reserve pipeline arena sized for its buffers plus component headroom */
+static void pipeline_arena_new(struct pipeline *p, struct comp_dev *source)
+{
+	struct pipeline_arena_data data;
+
+	data.start = source;
+	data.p = p;
+	data.arena = NULL;
+	data.size = CONFIG_PIPELINE_ARENA_HEADROOM;
+	data.caps = SOF_MEM_CAPS_RAM;
+
+	pipeline_comp_arena(source, &data, PPL_DIR_DOWNSTREAM);
+
+	heap_set_owner(p->ipc_pipe.pipeline_id);
+	p->arena = arena_new(p->ipc_pipe.pipeline_id, data.caps, data.size);
+	heap_clear_owner();
+	if (!p->arena) {
+		trace_pipe_error_with_ids(p, "pipeline_arena_new() error: "
+					  "no arena of %u bytes, using heap",
+					  data.size);
+		return;
+	}
+
+	data.arena = p->arena;
+	pipeline_comp_arena(source, &data, PPL_DIR_DOWNSTREAM);
+
+	/* buffers stay for the pipeline lifetime, the rest is recycled */
+	arena_seal(p->arena);
+}
+#endif
+
+#if CONFIG_BUFFER_XCORE
+static int pipeline_comp_xcore(struct comp_dev *current, void *data, int dir)
+{
+	struct pipeline_data *ppl_data = data;
+	struct list_item *clist;
+
+	if (!comp_is_single_pipeline(current, ppl_data->start))
+		return 0;
+
+	/* buffers coming from other pipelines are not walked downstream */
+	list_for_item(clist, &current->bsource_list)
+		pipeline_buffer_xcore(container_of(clist, struct comp_buffer,
+						   sink_list));
+
+	return pipeline_for_each_comp(current, &pipeline_comp_xcore, data,
+				      &pipeline_buffer_xcore, dir);
+}
+
+/* buffers to other pipelines follow the cores of both pipelines */
+static void pipeline_xcore_update(struct pipeline *p)
+{
+	struct pipeline_data data;
+
+	if (!p->source_comp)
+		return;
+
+	data.start = p->source_comp;
+	data.p = p;
+
+	pipeline_comp_xcore(p->source_comp, &data, PPL_DIR_DOWNSTREAM);
+}
+#else
+static inline void pipeline_xcore_update(struct pipeline *p) { }
+#endif
+
 int pipeline_complete(struct pipeline *p, struct comp_dev *source,
 		      struct comp_dev *sink)
 {
@@ -172,10 +504,16 @@ int pipeline_complete(struct pipeline *p, struct comp_dev *source,
 	 */
 	pipeline_comp_complete(source, &data, PPL_DIR_DOWNSTREAM);
 
+#if CONFIG_PIPELINE_ARENA
+	pipeline_arena_new(p, source);
+#endif
+
 	p->source_comp = source;
 	p->sink_comp = sink;
 	p->status = COMP_STATE_READY;
 
+	pipeline_xcore_update(p);
+
 	/* show heap status */
 	heap_trace_all(0);
 
@@ -197,6 +535,8 @@ static int pipeline_comp_free(struct comp_dev *current, void *data, int dir)
 
 	/* complete component free */
 	current->pipeline = NULL;
+	current->fuse_head = NULL;
+	current->fuse_next = NULL;
 
 	pipeline_for_each_comp(current, &pipeline_comp_free, data,
 			       NULL, dir);
@@ -209,6 +549,28 @@ static int pipeline_comp_free(struct comp_dev *current, void *data, int dir)
 	return 0;
 }
 
+/* components are written back when stopped on another core, so a pipeline
+ * that is not running only needs its task to be bound to the new core
+ */
+int pipeline_set_core(struct pipeline *p, uint32_t core)
+{
+	if (p->status == COMP_STATE_ACTIVE) {
+		trace_pipe_error_with_ids(p, "pipeline_set_core() error: "
+					  "pipeline is running");
+		return -EBUSY;
+	}
+
+	trace_pipe_with_ids(p, "pipeline_set_core(), core %u -> %u",
+			    p->ipc_pipe.core, core);
+
+	p->ipc_pipe.core = core;
+	p->pipe_task.core = core;
+
+	pipeline_xcore_update(p);
+
+	return 0;
+}
+
 /* pipelines must be inactive */
 int pipeline_free(struct pipeline *p)
 {
@@ -217,7 +579,7 @@ int pipeline_free(struct pipeline *p)
 	trace_pipe_with_ids(p, "pipeline_free()");
 
 	/* make sure we are not in use */
-	if (p->source_comp->state > COMP_STATE_READY) {
+	if (p->source_comp && p->source_comp->state > COMP_STATE_READY) {
 		trace_pipe_error_with_ids(p, "pipeline_free() error: Pipeline"
 					  " in use, %u, %u",
 					  p->source_comp->comp.id,
@@ -228,12 +590,19 @@ int pipeline_free(struct pipeline *p)
 	/* remove from any scheduling */
 	schedule_task_free(&p->pipe_task);
 
-	data.start = p->source_comp;
+	/* disconnect components, none known before pipeline_complete() */
+	if (p->source_comp) {
+		data.start = p->source_comp;
+		pipeline_comp_free(p->source_comp, &data, PPL_DIR_DOWNSTREAM);
+	}
 
-	/* disconnect components */
-	pipeline_comp_free(p->source_comp, &data, PPL_DIR_DOWNSTREAM);
+#if CONFIG_PIPELINE_ARENA
+	/* arena goes back to the heap with the last buffer or comp freed */
+	arena_free(p->arena);
+#endif
 
 	/* now free the pipeline */
+	rfree(p->pipe_task.run_max);
 	rfree(p);
 
 	/* show heap status */
@@ -281,7 +650,9 @@ static int pipeline_comp_params(struct comp_dev *current, void *data, int dir)
 	/* send current params to the component */
 	current->params = ppl_data->params->params;
 
+	heap_set_owner(current->comp.pipeline_id);
 	err = comp_params(current);
+	heap_clear_owner();
 	if (err < 0 || err == PPL_STATUS_PATH_STOP)
 		return err;
 
@@ -329,6 +700,86 @@ int pipeline_params(struct pipeline *p, struct comp_dev *host,
 	return ret;
 }
 
+#if CONFIG_PIPELINE_INPLACE
+/* neighbour of in-place component of pipeline p, accessed by CPU unless dma */
+static bool pipeline_comp_is_inplace_peer(struct comp_dev *dev,
+					  struct comp_buffer *buffer,
+					  struct pipeline *p, bool dma)
+{
+	return dev && dev->pipeline == p && (dma || !dev->is_dma_connected) &&
+		buffer->ipc_buffer.comp.pipeline_id == p->ipc_pipe.pipeline_id;
+}
+
+/*
+ * DAI downstream of a bypassed component. It is prepared after us and
+ * moves its DMA onto the shared store, which has the size it expects.
+ */
+static bool pipeline_comp_is_bypass_dai(struct comp_dev *current,
+					struct comp_buffer *source,
+					struct comp_buffer *sink)
+{
+	return current->bypass && sink->sink &&
+		comp_get_endpoint_type(sink->sink) == COMP_ENDPOINT_DAI &&
+		sink->size == source->size;
+}
+
+/*
+ * In-place capable or bypassed component with same data format on both
+ * sides. Bypassed components don't touch the data, so DMA upstream may
+ * keep writing the shared store.
+ */
+static bool pipeline_comp_is_inplace(struct comp_dev *current)
+{
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+
+	if (!(current->drv->flags & COMP_DRV_INPLACE) && !current->bypass)
+		return false;
+
+	if (!pipeline_comp_is_single_io(current))
+		return false;
+
+	source = list_first_item(&current->bsource_list, struct comp_buffer,
+				 sink_list);
+	sink = list_first_item(&current->bsink_list, struct comp_buffer,
+			       source_list);
+
+	return pipeline_comp_is_inplace_peer(source->source, source,
+					     current->pipeline,
+					     current->bypass) &&
+		pipeline_comp_is_inplace_peer(sink->sink, sink,
+					      current->pipeline,
+					      pipeline_comp_is_bypass_dai
+						(current, source, sink)) &&
+		comp_frame_fmt(source->source) == comp_frame_fmt(sink->sink) &&
+		comp_frame_bytes(source->source) ==
+		comp_frame_bytes(sink->sink);
+}
+
+/* alias sink buffer of in-place component onto its source buffer */
+static void pipeline_comp_alias(struct comp_dev *current)
+{
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+
+	if (list_is_empty(&current->bsink_list))
+		return;
+
+	sink = list_first_item(&current->bsink_list, struct comp_buffer,
+			       source_list);
+
+	if (pipeline_comp_is_inplace(current)) {
+		source = list_first_item(&current->bsource_list,
+					 struct comp_buffer, sink_list);
+		if (buffer_alias(sink, source) < 0)
+			buffer_unalias(sink);
+	} else {
+		/* format may have changed since it was aliased */
+		buffer_unalias(sink);
+	}
+}
+#endif
+
 static int pipeline_comp_prepare(struct comp_dev *current, void *data, int dir)
 {
 	int err = 0;
@@ -360,10 +811,22 @@ static int pipeline_comp_prepare(struct comp_dev *current, void *data, int dir)
 		}
 	}
 
+	heap_set_owner(current->comp.pipeline_id);
 	err = comp_prepare(current);
+	heap_clear_owner();
 	if (err < 0 || err == PPL_STATUS_PATH_STOP)
 		return err;
 
+#if CONFIG_PIPELINE_FUSION
+	pipeline_comp_fuse_tile(current);
+#endif
+
+#if CONFIG_PIPELINE_INPLACE
+	/* before a DAI downstream sets up its DMA on the sink buffer */
+	if (comp_is_single_pipeline(current, ppl_data->start))
+		pipeline_comp_alias(current);
+#endif
+
 	return pipeline_for_each_comp(current, &pipeline_comp_prepare, data,
 				      &buffer_reset_pos, dir);
 }
@@ -464,6 +927,7 @@ static void pipeline_comp_trigger_sched_comp(struct pipeline *p,
 	case COMP_TRIGGER_RELEASE:
 	case COMP_TRIGGER_START:
 		p->xrun_bytes = 0;
+		*p->pipe_task.run_max = 0;
 
 		/* playback pipelines need to be scheduled now,
 		 * capture pipelines are scheduled only for
@@ -521,7 +985,8 @@ static int pipeline_trigger_on_core(struct pipeline *p, struct comp_dev *host,
 				    int cmd)
 {
 	struct idc_msg pipeline_trigger = { IDC_MSG_PPL_TRIGGER,
-		IDC_MSG_PPL_TRIGGER_EXT(cmd), p->ipc_pipe.core };
+		IDC_MSG_PPL_TRIGGER_EXT(cmd), p->ipc_pipe.core,
+		sizeof(host->comp.id), &host->comp.id };
 	int ret;
 
 	/* check if requested core is enabled */
@@ -537,7 +1002,7 @@ static int pipeline_trigger_on_core(struct pipeline *p, struct comp_dev *host,
 	if (cmd == COMP_TRIGGER_START)
 		pipeline_cache(p, host, CACHE_WRITEBACK_INV);
 
-	/* send IDC pipeline trigger message */
+	/* the IPC reply carries the result of the slave core */
 	ret = idc_send_msg(&pipeline_trigger, IDC_BLOCKING);
 	if (ret < 0) {
 		trace_pipe_error_with_ids(p, "pipeline_trigger_on_core() "
@@ -721,7 +1186,7 @@ static int pipeline_comp_copy(struct comp_dev *current, void *data, int dir)
 
 	/* copy to downstream immediately */
 	if (dir == PPL_DIR_DOWNSTREAM) {
-		err = comp_copy(current);
+		err = pipeline_stage_copy(current);
 		if (err < 0 || err == PPL_STATUS_PATH_STOP)
 			return err;
 	}
@@ -732,7 +1197,7 @@ static int pipeline_comp_copy(struct comp_dev *current, void *data, int dir)
 		return err;
 
 	if (dir == PPL_DIR_UPSTREAM)
-		err = comp_copy(current);
+		err = pipeline_stage_copy(current);
 
 	return err;
 }
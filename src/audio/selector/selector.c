@@ -466,6 +466,7 @@ static void selector_cache(struct comp_dev *dev, int cmd)
 /** \brief Selector component definition. */
 struct comp_driver comp_selector = {
 	.type	= SOF_COMP_SELECTOR,
+	.flags	= COMP_DRV_FUSABLE,
 	.ops	= {
 		.new		= selector_new,
 		.free		= selector_free,
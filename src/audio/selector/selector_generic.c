@@ -12,22 +12,31 @@
 
 #include <sof/audio/selector.h>
 
+static inline uint32_t sel_in_channels(struct comp_dev *dev)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+
+	return cd->config.in_channels_count;
+}
+
 /**
  * \brief Channel selection for 16 bit, 1 channel data format.
  * \param[in,out] dev Selector base component device.
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of input channels.
  */
-static void sel_s16le_1ch(struct comp_dev *dev, struct comp_buffer *sink,
-			  struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+sel_s16le_1ch_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		  struct comp_buffer *source, uint32_t frames,
+		  const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int16_t *src;
 	int16_t *dest;
 	uint32_t i;
 	uint32_t j = 0;
-	uint32_t nch = cd->config.in_channels_count;
 
 	for (i = cd->config.sel_channel; i < frames * nch; i += nch) {
 		src = buffer_read_frag_s16(source, i);
@@ -42,16 +51,18 @@ static void sel_s16le_1ch(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of input channels.
  */
-static void sel_s32le_1ch(struct comp_dev *dev, struct comp_buffer *sink,
-			  struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+sel_s32le_1ch_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		  struct comp_buffer *source, uint32_t frames,
+		  const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int32_t *src;
 	int32_t *dest;
 	uint32_t i;
 	uint32_t j = 0;
-	uint32_t nch = cd->config.in_channels_count;
 
 	for (i = cd->config.sel_channel; i < frames * nch; i += nch) {
 		src = buffer_read_frag_s32(source, i);
@@ -116,16 +127,44 @@ static void sel_s32le_nch(struct comp_dev *dev, struct comp_buffer *sink,
 	}
 }
 
+/**
+ * \brief Instantiates channel selection for a number of input channels.
+ * \param[in] func Name of the instantiated function.
+ * \param[in] name Selection function template.
+ * \param[in] nch Number of input channels, a constant turns the stride
+ *		  into an immediate.
+ */
+#define SEL_FUNC(func, name, nch)					\
+static void func(struct comp_dev *dev, struct comp_buffer *sink,	\
+		 struct comp_buffer *source, uint32_t frames)		\
+{									\
+	name##_nch(dev, sink, source, frames, nch);			\
+}
+
+SEL_FUNC(sel_s16le_1ch, sel_s16le_1ch, sel_in_channels(dev))
+SEL_FUNC(sel_s16le_1ch_2ch, sel_s16le_1ch, 2)
+SEL_FUNC(sel_s16le_1ch_4ch, sel_s16le_1ch, 4)
+SEL_FUNC(sel_s32le_1ch, sel_s32le_1ch, sel_in_channels(dev))
+SEL_FUNC(sel_s32le_1ch_2ch, sel_s32le_1ch, 2)
+SEL_FUNC(sel_s32le_1ch_4ch, sel_s32le_1ch, 4)
+
+/* specialised variants come first, entries with in_channels 0 match any */
 const struct comp_func_map func_table[] = {
-	{SOF_IPC_FRAME_S16_LE, 1, sel_s16le_1ch},
-	{SOF_IPC_FRAME_S24_4LE, 1, sel_s32le_1ch},
-	{SOF_IPC_FRAME_S32_LE, 1, sel_s32le_1ch},
-	{SOF_IPC_FRAME_S16_LE, 2, sel_s16le_nch},
-	{SOF_IPC_FRAME_S24_4LE, 2, sel_s32le_nch},
-	{SOF_IPC_FRAME_S32_LE, 2, sel_s32le_nch},
-	{SOF_IPC_FRAME_S16_LE, 4, sel_s16le_nch},
-	{SOF_IPC_FRAME_S24_4LE, 4, sel_s32le_nch},
-	{SOF_IPC_FRAME_S32_LE, 4, sel_s32le_nch},
+	{SOF_IPC_FRAME_S16_LE, 1, sel_s16le_1ch_2ch, 2},
+	{SOF_IPC_FRAME_S24_4LE, 1, sel_s32le_1ch_2ch, 2},
+	{SOF_IPC_FRAME_S32_LE, 1, sel_s32le_1ch_2ch, 2},
+	{SOF_IPC_FRAME_S16_LE, 1, sel_s16le_1ch_4ch, 4},
+	{SOF_IPC_FRAME_S24_4LE, 1, sel_s32le_1ch_4ch, 4},
+	{SOF_IPC_FRAME_S32_LE, 1, sel_s32le_1ch_4ch, 4},
+	{SOF_IPC_FRAME_S16_LE, 1, sel_s16le_1ch, 0},
+	{SOF_IPC_FRAME_S24_4LE, 1, sel_s32le_1ch, 0},
+	{SOF_IPC_FRAME_S32_LE, 1, sel_s32le_1ch, 0},
+	{SOF_IPC_FRAME_S16_LE, 2, sel_s16le_nch, 0},
+	{SOF_IPC_FRAME_S24_4LE, 2, sel_s32le_nch, 0},
+	{SOF_IPC_FRAME_S32_LE, 2, sel_s32le_nch, 0},
+	{SOF_IPC_FRAME_S16_LE, 4, sel_s16le_nch, 0},
+	{SOF_IPC_FRAME_S24_4LE, 4, sel_s32le_nch, 0},
+	{SOF_IPC_FRAME_S32_LE, 4, sel_s32le_nch, 0},
 };
 
 sel_func sel_get_processing_function(struct comp_dev *dev)
@@ -139,6 +178,9 @@ sel_func sel_get_processing_function(struct comp_dev *dev)
 			continue;
 		if (cd->config.out_channels_count != func_table[i].out_channels)
 			continue;
+		if (func_table[i].in_channels &&
+		    cd->config.in_channels_count != func_table[i].in_channels)
+			continue;
 
 		/* TODO: add additional criteria as needed */
 		return func_table[i].sel_func;
@@ -17,6 +17,7 @@
 #include <sof/schedule/schedule.h>
 #include <sof/clk.h>
 #include <sof/ipc.h>
+#include <arch/cache.h>
 #include <sof/audio/component.h>
 #include <sof/audio/pipeline.h>
 #include <sof/audio/src/src_config.h>
@@ -24,7 +25,11 @@
 #include <sof/math/numbers.h>
 #include <ipc/topology.h>
 
-#if SRC_SHORT
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+#include <sof/audio/coefficients/src/src_std_int32_define.h>
+#include <sof/audio/coefficients/src/src_runtime_table.h>
+#include <user/src.h>
+#elif SRC_SHORT
 #include <sof/audio/coefficients/src/src_tiny_int16_define.h>
 #include <sof/audio/coefficients/src/src_tiny_int16_table.h>
 #else
@@ -40,9 +45,41 @@
 	trace_error(TRACE_CLASS_SRC, __e, ##__VA_ARGS__)
 
 /* The FIR maximum lengths are per channel so need to multiply them */
-#define MAX_FIR_DELAY_SIZE_XNCH (PLATFORM_MAX_CHANNELS * MAX_FIR_DELAY_SIZE)
+#define MAX_FIR_DELAY_SIZE_XNCH \
+	(SRC_FIR_DELAY_COPIES * PLATFORM_MAX_CHANNELS * MAX_FIR_DELAY_SIZE)
 #define MAX_OUT_DELAY_SIZE_XNCH (PLATFORM_MAX_CHANNELS * MAX_OUT_DELAY_SIZE)
 
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+/* coefficients of a rate pair, written once by the loading core */
+struct src_coef_data {
+	struct src_stage stage1;
+	struct src_stage stage2;
+	struct sof_src_coef_set set;	/* copy of the set in the blob */
+};
+
+/* coefficient set of a rate pair shared by the SRC instances, the set is
+ * uncached and its data is invalidated by each user taking a reference
+ */
+struct src_coef_set {
+	struct list_item list;
+	int idx_in;
+	int idx_out;
+	uint32_t refs;
+	size_t data_size;
+	struct src_coef_data *data;
+};
+
+/* loaded sets shared by the SRC instances on all cores, uncached */
+struct src_coef_shared {
+	struct list_item list;
+	spinlock_t lock;
+	struct src_stage *table1[NUM_OUT_FS][NUM_IN_FS];
+	struct src_stage *table2[NUM_OUT_FS][NUM_IN_FS];
+};
+
+static struct src_coef_shared *src_coef;
+#endif
+
 /* src component private data */
 struct comp_data {
 	struct polyphase_src src;
@@ -54,16 +91,20 @@ struct comp_data {
 	uint32_t source_format;
 	int32_t *sbuf_w_ptr;
 	int32_t *sbuf_r_ptr;
-	int sbuf_avail;
+	int sched_idx;
 	int data_shift;
-	int source_frames;
-	int sink_frames;
 	void (*src_func)(struct comp_dev *dev,
 			 struct comp_buffer *source,
 			 struct comp_buffer *sink,
 			 int *consumed,
 			 int *produced);
 	void (*polyphase_func)(struct src_stage_prm *s);
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+	struct sof_src_coef_config *config;	/* blob being received */
+	size_t config_size;
+	struct src_coef_set *coef[SOF_SRC_COEF_MAX_SETS]; /* loaded sets */
+	struct src_coef_set *coef_active;	/* set of the current rates */
+#endif
 };
 
 /* Calculates the needed FIR delay line length */
@@ -91,13 +132,351 @@ static int src_find_fs(int fs_list[], int list_length, int fs)
 	return -EINVAL;
 }
 
-/* Calculates buffers to allocate for a SRC mode */
+/* Gets the stages of a rate pair */
+static void src_get_stages(struct src_param *a, struct src_stage **stage1,
+			   struct src_stage **stage2)
+{
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+	*stage1 = src_coef->table1[a->idx_out][a->idx_in];
+	*stage2 = src_coef->table2[a->idx_out][a->idx_in];
+
+	/* No coefficient set is loaded for the rate pair */
+	if (!*stage1) {
+		*stage1 = src_in_fs[a->idx_in] == src_out_fs[a->idx_out] ?
+			&src_1_1_0_0 : &src_0_0_0_0;
+		*stage2 = *stage1;
+	}
+#else
+	*stage1 = src_table1[a->idx_out][a->idx_in];
+	*stage2 = src_table2[a->idx_out][a->idx_in];
+#endif
+}
+
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+#if SRC_SHORT
+#define SRC_COEF_BITS	16
+#else
+#define SRC_COEF_BITS	32
+#endif
+
+/* Bytes of stage coefficients in the blob */
+static size_t src_coef_stage_size(const struct sof_src_coef_stage *s)
+{
+	return ALIGN_UP(s->filter_length * SRC_COEF_BITS / 8,
+			sizeof(int32_t));
+}
+
+static int src_coef_stage_check(const struct sof_src_coef_stage *s)
+{
+	if (s->filter_length < 1 || s->filter_length > SOF_SRC_COEF_MAX_SIZE ||
+	    s->num_of_subfilters < 1 || s->subfilter_length < 1 ||
+	    s->filter_length % s->num_of_subfilters ||
+	    s->filter_length / s->num_of_subfilters != s->subfilter_length ||
+	    s->blk_in < 1 || s->blk_out < 1 || s->idm < 0 || s->odm < 0)
+		return -EINVAL;
+
+	return 0;
+}
+
+static void src_coef_stage_init(struct src_stage *stage,
+				const struct sof_src_coef_stage *s,
+				const void *coefs)
+{
+	struct src_stage init = {
+		.idm = s->idm,
+		.odm = s->odm,
+		.num_of_subfilters = s->num_of_subfilters,
+		.subfilter_length = s->subfilter_length,
+		.filter_length = s->filter_length,
+		.blk_in = s->blk_in,
+		.blk_out = s->blk_out,
+		.halfband = s->halfband,
+		.shift = s->shift,
+		.coefs = coefs,
+	};
+
+	assert(!memcpy_s(stage, sizeof(*stage), &init, sizeof(init)));
+}
+
+/* Takes a reference to the set of the rate pair, the first user adds it to
+ * the table. A set different from the one in use is refused.
+ */
+static int src_coef_get(const struct sof_src_coef_set *set,
+			struct src_coef_set **coef)
+{
+	struct list_item *clist;
+	struct src_coef_set *cs;
+	size_t stage1_size;
+	int idx_in;
+	int idx_out;
+	int ret = 0;
+	uint32_t flags;
+
+	idx_in = src_find_fs(src_in_fs, NUM_IN_FS, set->source_rate);
+	idx_out = src_find_fs(src_out_fs, NUM_OUT_FS, set->sink_rate);
+	if (idx_in < 0 || idx_out < 0 || set->source_rate == set->sink_rate) {
+		trace_src_error("src_coef_get() error: rates not supported, "
+				"fs_in: %u, fs_out: %u", set->source_rate,
+				set->sink_rate);
+		return -EINVAL;
+	}
+
+	if (src_coef_stage_check(&set->stage[0]) < 0 ||
+	    src_coef_stage_check(&set->stage[1]) < 0) {
+		trace_src_error("src_coef_get() error: invalid stages, "
+				"fs_in: %u, fs_out: %u", set->source_rate,
+				set->sink_rate);
+		return -EINVAL;
+	}
+
+	stage1_size = src_coef_stage_size(&set->stage[0]);
+	if (set->size != sizeof(*set) + stage1_size +
+	    src_coef_stage_size(&set->stage[1])) {
+		trace_src_error("src_coef_get() error: invalid set size %u",
+				set->size);
+		return -EINVAL;
+	}
+
+	spin_lock_irq(&src_coef->lock, flags);
+
+	list_for_item(clist, &src_coef->list) {
+		cs = container_of(clist, struct src_coef_set, list);
+		if (cs->idx_in != idx_in || cs->idx_out != idx_out)
+			continue;
+
+		/* lines of a set freed earlier may still be cached here */
+		dcache_invalidate_region(cs->data, cs->data_size);
+
+		if (cs->data->set.size != set->size ||
+		    memcmp(&cs->data->set, set, set->size)) {
+			trace_src_error("src_coef_get() error: other set in "
+					"use, fs_in: %u, fs_out: %u",
+					set->source_rate, set->sink_rate);
+			ret = -EBUSY;
+			goto out;
+		}
+
+		cs->refs++;
+		*coef = cs;
+		goto out;
+	}
+
+	/* sets are shared with instances on all cores */
+	cs = rzalloc(RZONE_RUNTIME | RZONE_FLAG_UNCACHED, SOF_MEM_CAPS_RAM,
+		     sizeof(*cs));
+	if (!cs) {
+		trace_src_error("src_coef_get() error: failed to alloc set");
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	cs->data_size = sizeof(*cs->data) - sizeof(*set) + set->size;
+	cs->data = rballoc(RZONE_BUFFER, SOF_MEM_CAPS_RAM, cs->data_size);
+	if (!cs->data) {
+		trace_src_error("src_coef_get() error: failed to alloc set "
+				"data, size = %u", set->size);
+		rfree(cs);
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	assert(!memcpy_s(&cs->data->set, set->size, set, set->size));
+	src_coef_stage_init(&cs->data->stage1, &cs->data->set.stage[0],
+			    cs->data->set.coef);
+	src_coef_stage_init(&cs->data->stage2, &cs->data->set.stage[1],
+			    (char *)cs->data->set.coef + stage1_size);
+
+	/* the data is not modified after it is published */
+	dcache_writeback_region(cs->data, cs->data_size);
+
+	cs->idx_in = idx_in;
+	cs->idx_out = idx_out;
+	cs->refs = 1;
+	list_item_append(&cs->list, &src_coef->list);
+
+	src_coef->table1[idx_out][idx_in] = &cs->data->stage1;
+	src_coef->table2[idx_out][idx_in] = &cs->data->stage2;
+	*coef = cs;
+
+	trace_src("src_coef_get(), loaded fs_in: %u, fs_out: %u",
+		  set->source_rate, set->sink_rate);
+
+out:
+	spin_unlock_irq(&src_coef->lock, flags);
+	return ret;
+}
+
+/* Takes a reference to the loaded set of the rates */
+static struct src_coef_set *src_coef_find(int idx_in, int idx_out)
+{
+	struct list_item *clist;
+	struct src_coef_set *cs;
+	uint32_t flags;
+
+	spin_lock_irq(&src_coef->lock, flags);
+
+	list_for_item(clist, &src_coef->list) {
+		cs = container_of(clist, struct src_coef_set, list);
+		if (cs->idx_in == idx_in && cs->idx_out == idx_out) {
+			dcache_invalidate_region(cs->data, cs->data_size);
+			cs->refs++;
+			goto out;
+		}
+	}
+
+	cs = NULL;
+
+out:
+	spin_unlock_irq(&src_coef->lock, flags);
+	return cs;
+}
+
+/* Drops a reference, the last user removes the set from the table */
+static void src_coef_put(struct src_coef_set *cs)
+{
+	uint32_t flags;
+
+	if (!cs)
+		return;
+
+	spin_lock_irq(&src_coef->lock, flags);
+
+	if (--cs->refs == 0) {
+		src_coef->table1[cs->idx_out][cs->idx_in] = NULL;
+		src_coef->table2[cs->idx_out][cs->idx_in] = NULL;
+		list_item_del(&cs->list);
+		rfree(cs->data);
+		rfree(cs);
+	}
+
+	spin_unlock_irq(&src_coef->lock, flags);
+}
+
+static void src_coef_put_all(struct comp_data *cd)
+{
+	int i;
+
+	for (i = 0; i < SOF_SRC_COEF_MAX_SETS; i++) {
+		src_coef_put(cd->coef[i]);
+		cd->coef[i] = NULL;
+	}
+}
+
+/* Replaces the sets loaded by the instance with the sets of the blob */
+static int src_coef_load(struct comp_data *cd)
+{
+	struct src_coef_set *coef[SOF_SRC_COEF_MAX_SETS] = { NULL };
+	struct sof_src_coef_config *config = cd->config;
+	struct sof_src_coef_set *set;
+	size_t offset = sizeof(*config);
+	int ret = 0;
+	int i;
+
+	if (config->size < sizeof(*config) ||
+	    config->coef_bits != SRC_COEF_BITS ||
+	    config->num_sets > SOF_SRC_COEF_MAX_SETS) {
+		trace_src_error("src_coef_load() error: invalid blob, "
+				"coef_bits %u num_sets %u", config->coef_bits,
+				config->num_sets);
+		return -EINVAL;
+	}
+
+	for (i = 0; i < config->num_sets; i++) {
+		set = (struct sof_src_coef_set *)((char *)config + offset);
+		if (offset + sizeof(*set) > config->size ||
+		    set->size > config->size - offset) {
+			trace_src_error("src_coef_load() error: set %u "
+					"exceeds the blob", i);
+			ret = -EINVAL;
+			break;
+		}
+
+		ret = src_coef_get(set, &coef[i]);
+		if (ret < 0)
+			break;
+
+		offset += set->size;
+	}
+
+	if (ret < 0) {
+		while (--i >= 0)
+			src_coef_put(coef[i]);
+		return ret;
+	}
+
+	src_coef_put_all(cd);
+	assert(!memcpy_s(cd->coef, sizeof(cd->coef), coef, sizeof(coef)));
+
+	return 0;
+}
+#endif
+
+static int src_gcd(int a, int b)
+{
+	int c;
+
+	while (b) {
+		c = a % b;
+		a = b;
+		b = c;
+	}
+
+	return a;
+}
+
+/* Runs the stages over periods of input until the state of the conversion
+ * repeats. Returns the length of the cyclic schedule and fills it if given.
+ * The most stage 1 output waiting for stage 2 sets the inter-stage buffer
+ * size.
+ */
+static int src_schedule(struct src_param *a, struct src_stage *stage1,
+			struct src_stage *stage2, struct src_sched *sched)
+{
+	int fs_in = src_in_fs[a->idx_in];
+	int g = src_gcd(fs_in, a->period_fs);
+	int period_in = a->period_frames * (fs_in / g);
+	int block_in = a->period_fs / g * stage1->blk_in;
+	int acc = 0;
+	int left = 0;
+	int t1;
+	int t2 = 0;
+	int n;
+
+	a->sbuf_length = 0;
+
+	for (n = 0; n < SRC_SCHED_MAX_LENGTH; n++) {
+		/* Input of the period in 1 / (period_fs / g) frames */
+		acc += period_in;
+		t1 = acc / block_in;
+		acc -= t1 * block_in;
+
+		if (stage2->filter_length > 1) {
+			left += t1 * stage1->blk_out;
+			a->sbuf_length = MAX(a->sbuf_length, a->nch * left);
+			t2 = left / stage2->blk_in;
+			left -= t2 * stage2->blk_in;
+		}
+
+		if (sched) {
+			sched[n].stage1_times = t1;
+			sched[n].stage2_times = t2;
+		}
+
+		if (!acc && !left)
+			return n + 1;
+	}
+
+	return -EINVAL;
+}
+
+/* Calculates buffers to allocate for a SRC mode, period_frames of input
+ * or output are converted in a period.
+ */
 int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
-		       int source_frames)
+		       int period_frames, int period_fs)
 {
 	struct src_stage *stage1;
 	struct src_stage *stage2;
-	int r1;
 
 	if (nch > PLATFORM_MAX_CHANNELS) {
 		trace_src_error("src_buffer_lengths() error: "
@@ -105,6 +484,12 @@ int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
 		return -EINVAL;
 	}
 
+	if (period_frames < 1) {
+		trace_src_error("src_buffer_lengths() error: "
+				"period_frames = %u", period_frames);
+		return -EINVAL;
+	}
+
 	a->nch = nch;
 	a->idx_in = src_find_fs(src_in_fs, NUM_IN_FS, fs_in);
 	a->idx_out = src_find_fs(src_out_fs, NUM_OUT_FS, fs_out);
@@ -117,8 +502,7 @@ int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
 		return -EINVAL;
 	}
 
-	stage1 = src_table1[a->idx_out][a->idx_in];
-	stage2 = src_table2[a->idx_out][a->idx_in];
+	src_get_stages(a, &stage1, &stage2);
 
 	/* Check from stage1 parameter for a deleted in/out rate combination.*/
 	if (stage1->filter_length < 1) {
@@ -128,41 +512,47 @@ int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
 		return -EINVAL;
 	}
 
-	a->fir_s1 = nch * src_fir_delay_length(stage1);
+	a->fir_s1 = SRC_FIR_DELAY_COPIES * nch * src_fir_delay_length(stage1);
 	a->out_s1 = nch * src_out_delay_length(stage1);
 
-	/* Computing of number of blocks to process is done in
-	 * copy() per each frame.
-	 */
-	a->stage1_times = 0;
-	a->stage2_times = 0;
+	/* Number of schedule steps to process is set in copy() */
+	a->sched_steps = 0;
 	a->blk_in = 0;
 	a->blk_out = 0;
 
 	if (stage2->filter_length == 1) {
 		a->fir_s2 = 0;
 		a->out_s2 = 0;
-		a->sbuf_length = 0;
 	} else {
-		a->fir_s2 = nch * src_fir_delay_length(stage2);
+		a->fir_s2 = SRC_FIR_DELAY_COPIES * nch *
+			src_fir_delay_length(stage2);
 		a->out_s2 = nch * src_out_delay_length(stage2);
+	}
 
-		/* Stage 1 is repeated max. amount that just exceeds one
-		 * period.
-		 */
-		r1 = source_frames / stage1->blk_in + 1;
-
-		/* Set sbuf length to allow storing two stage 1 output
-		 * periods. This is an empirically found value for no
-		 * xruns to happen with SRC in/out buffers. Due to
-		 * variable number of blocks to process per each stage
-		 * there is no equation known for minimum size.
-		 */
-		a->sbuf_length = 2 * nch * stage1->blk_out * r1;
+	/* The stages are run in a cyclic schedule, one step per period */
+	a->period_frames = period_frames;
+	a->period_fs = period_fs;
+	a->sched_length = src_schedule(a, stage1, stage2, NULL);
+	if (a->sched_length < 0) {
+		trace_src_error("src_buffer_lengths() error: no schedule, "
+				"period_frames = %u, period_fs = %u",
+				period_frames, period_fs);
+		return -EINVAL;
 	}
 
-	a->src_multich = a->fir_s1 + a->fir_s2 + a->out_s1 + a->out_s2;
-	a->total = a->sbuf_length + a->src_multich;
+#if SRC_SSE
+	/* Coefficients scaled and widened to 64 bits for the stages */
+	a->coef_s1 = 2 * stage1->filter_length;
+	a->coef_s2 = a->fir_s2 ? 2 * stage2->filter_length : 0;
+#else
+	a->coef_s1 = 0;
+	a->coef_s2 = 0;
+#endif
+
+	a->src_multich = a->fir_s1 + a->fir_s2 + a->out_s1 + a->out_s2 +
+		a->coef_s1 + a->coef_s2;
+	a->total = a->sbuf_length + a->src_multich +
+		a->sched_length * sizeof(struct src_sched) / sizeof(int32_t);
 
 	return 0;
 }
@@ -197,7 +587,7 @@ static int init_stages(struct src_stage *stage1, struct src_stage *stage2,
 	/* Delay line sizes */
 	src->state1.fir_delay_size = p->fir_s1;
 	src->state1.out_delay_size = p->out_s1;
-	src->state1.fir_delay = delay_lines_start;
+	src->state1.fir_delay = delay_lines_start + p->coef_s1 + p->coef_s2;
 	src->state1.out_delay =
 		src->state1.fir_delay + src->state1.fir_delay_size;
 	/* Initialize to last ensures that circular wrap cannot happen
@@ -224,6 +614,16 @@ static int init_stages(struct src_stage *stage1, struct src_stage *stage2,
 		src->state2.out_delay = NULL;
 	}
 
+#if SRC_SSE
+	/* Scaled coefficients precede the delay lines */
+	src_polyphase_stage_init(&src->state1, stage1, p->nch,
+				 (int64_t *)delay_lines_start);
+	if (p->coef_s2)
+		src_polyphase_stage_init(&src->state2, stage2, p->nch,
+					 src->state1.coefs +
+					 stage1->filter_length);
+#endif
+
 	/* Check the sizes are less than MAX */
 	if (src->state1.fir_delay_size > MAX_FIR_DELAY_SIZE_XNCH ||
 	    src->state1.out_delay_size > MAX_OUT_DELAY_SIZE_XNCH ||
@@ -244,6 +644,7 @@ void src_polyphase_reset(struct polyphase_src *src)
 	src->number_of_stages = 0;
 	src->stage1 = NULL;
 	src->stage2 = NULL;
+	src->sched = NULL;
 	src_state_reset(&src->state1);
 	src_state_reset(&src->state2);
 }
@@ -260,8 +661,7 @@ int src_polyphase_init(struct polyphase_src *src, struct src_param *p,
 		return -EINVAL;
 
 	/* Get setup for 2 stage conversion */
-	stage1 = src_table1[p->idx_out][p->idx_in];
-	stage2 = src_table2[p->idx_out][p->idx_in];
+	src_get_stages(p, &stage1, &stage2);
 	ret = init_stages(stage1, stage2, src, p, 2, delay_lines_start);
 	if (ret < 0)
 		return -EINVAL;
@@ -283,6 +683,10 @@ int src_polyphase_init(struct polyphase_src *src, struct src_param *p,
 	if (src->stage1->filter_length == 0)
 		return -EINVAL;
 
+	/* The schedule follows the delay lines */
+	src->sched = (struct src_sched *)(delay_lines_start + p->src_multich);
+	src_schedule(p, stage1, stage2, src->sched);
+
 	return n_stages;
 }
 
@@ -301,22 +705,15 @@ static void src_2s(struct comp_dev *dev,
 {
 	struct src_stage_prm s1;
 	struct src_stage_prm s2;
-	int s1_blk_in;
-	int s1_blk_out;
-	int s2_blk_in;
-	int s2_blk_out;
 	struct comp_data *cd = comp_get_drvdata(dev);
+	struct src_sched *step;
 	void *sbuf_addr = cd->delay_lines;
 	void *sbuf_end_addr = &cd->delay_lines[cd->param.sbuf_length];
 	size_t sbuf_size = cd->param.sbuf_length * sizeof(int32_t);
 	int nch = dev->params.channels;
-	int sbuf_free = cd->param.sbuf_length - cd->sbuf_avail;
-	int avail_b = source->avail;
-	int free_b = sink->free;
-	int sz = dev->params.sample_container_bytes;
+	int idx = cd->sched_idx;
+	int i;
 
-	*n_read = 0;
-	*n_written = 0;
 	s1.x_end_addr = source->end_addr;
 	s1.x_size = source->size;
 	s1.y_addr = sbuf_addr;
@@ -341,53 +738,25 @@ static void src_2s(struct comp_dev *dev,
 	s2.nch = nch;
 	s2.shift = cd->data_shift;
 
-	/* Test if 1st stage can be run with default block length to reach
-	 * the period length or just under it.
+	/* The schedule keeps the stage 1 output within the sbuf, the steps
+	 * must be run in order.
 	 */
-	s1.times = cd->param.stage1_times;
-	s1_blk_in = s1.times * cd->src.stage1->blk_in * nch;
-	s1_blk_out = s1.times * cd->src.stage1->blk_out * nch;
-
-	/* The sbuf may limit how many times s1 can be looped. It's harder
-	 * to prepare for in advance so the repeats number is adjusted down
-	 * here if need.
-	 */
-	if (s1_blk_out > sbuf_free) {
-		s1.times = sbuf_free / (cd->src.stage1->blk_out * nch);
-		s1_blk_in = s1.times * cd->src.stage1->blk_in * nch;
-		s1_blk_out = s1.times * cd->src.stage1->blk_out * nch;
-		tracev_src("s1.times = %d", s1.times);
-	}
-
-	if (avail_b >= s1_blk_in * sz && sbuf_free >= s1_blk_out) {
+	for (i = 0; i < cd->param.sched_steps; i++) {
+		step = &cd->src.sched[idx];
+		s1.times = step->stage1_times;
+		s2.times = step->stage2_times;
 		cd->polyphase_func(&s1);
+		cd->polyphase_func(&s2);
 
-		cd->sbuf_w_ptr = s1.y_wptr;
-		cd->sbuf_avail += s1_blk_out;
-		*n_read += s1.times * cd->src.stage1->blk_in;
-		avail_b -= s1_blk_in * sz;
-		sbuf_free -= s1_blk_out;
-	}
-
-	s2.times = cd->param.stage2_times;
-	s2_blk_in = s2.times * cd->src.stage2->blk_in * nch;
-	s2_blk_out = s2.times * cd->src.stage2->blk_out * nch;
-	if (s2_blk_in > cd->sbuf_avail) {
-		s2.times = cd->sbuf_avail / (cd->src.stage2->blk_in * nch);
-		s2_blk_in = s2.times * cd->src.stage2->blk_in * nch;
-		s2_blk_out = s2.times * cd->src.stage2->blk_out * nch;
-		tracev_src("s2.times = %d", s2.times);
+		if (++idx == cd->param.sched_length)
+			idx = 0;
 	}
 
-	/* Test if second stage can be run with default block length. */
-	if (cd->sbuf_avail >= s2_blk_in && free_b >= s2_blk_out * sz) {
-		cd->polyphase_func(&s2);
+	cd->sbuf_w_ptr = s1.y_wptr;
+	cd->sbuf_r_ptr = s2.x_rptr;
 
-		cd->sbuf_r_ptr = s2.x_rptr;
-		cd->sbuf_avail -= s2_blk_in;
-		free_b -= s2_blk_out * sz;
-		*n_written += s2.times * cd->src.stage2->blk_out;
-	}
+	*n_read = cd->param.blk_in;
+	*n_written = cd->param.blk_out;
 }
 
 /* 1 stage SRC for simple conversions */
@@ -398,7 +767,7 @@ static void src_1s(struct comp_dev *dev,
 	struct src_stage_prm s1;
 	struct comp_data *cd = comp_get_drvdata(dev);
 
-	s1.times = cd->param.stage1_times;
+	s1.times = cd->param.blk_in / cd->src.stage1->blk_in;
 	s1.x_rptr = source->r_ptr;
 	s1.x_end_addr = source->end_addr;
 	s1.x_size = source->size;
@@ -545,6 +914,14 @@ static void src_free(struct comp_dev *dev)
 	if (cd->delay_lines)
 		rfree(cd->delay_lines);
 
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+	if (cd->config)
+		rfree(cd->config);
+
+	src_coef_put(cd->coef_active);
+	src_coef_put_all(cd);
+#endif
+
 	rfree(cd);
 	rfree(dev);
 }
@@ -555,8 +932,12 @@ static int src_params(struct comp_dev *dev)
 	struct sof_ipc_stream_params *params = &dev->params;
 	struct sof_ipc_comp_src *src = COMP_GET_IPC(dev, sof_ipc_comp_src);
 	struct comp_data *cd = comp_get_drvdata(dev);
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+	struct src_coef_set *coef;
+#endif
 	size_t delay_lines_size;
 	int32_t *buffer_start;
+	int period_fs;
 	int n = 0;
 	int err;
 
@@ -571,18 +952,15 @@ static int src_params(struct comp_dev *dev)
 		cd->sink_rate = src->sink_rate;
 		/* re-write our params with output rate for next component */
 		params->rate = cd->sink_rate;
-		cd->source_frames = dev->frames * cd->source_rate /
-			cd->sink_rate;
-		cd->sink_frames = dev->frames;
+		/* the period is at the fixed rate of the DAI side */
+		period_fs = cd->sink_rate;
 	} else {
 		/* params rate is sink rate */
 		cd->source_rate = src->source_rate;
 		cd->sink_rate = params->rate;
 		/* re-write our params with output rate for next component */
 		params->rate = cd->source_rate;
-		cd->source_frames = dev->frames;
-		cd->sink_frames = dev->frames * cd->sink_rate /
-			cd->source_rate;
+		period_fs = cd->source_rate;
 	}
 
 	/* Allocate needed memory for delay lines */
@@ -590,16 +968,26 @@ static int src_params(struct comp_dev *dev)
 		  cd->source_rate, cd->sink_rate);
 	trace_src("src_params(), params->channels = %u, dev->frames = %u",
 		  params->channels, dev->frames);
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+	/* Hold the coefficient set of the rates before its stages are used */
+	coef = src_coef_find(src_find_fs(src_in_fs, NUM_IN_FS,
+					 cd->source_rate),
+			     src_find_fs(src_out_fs, NUM_OUT_FS,
+					 cd->sink_rate));
+	src_coef_put(cd->coef_active);
+	cd->coef_active = coef;
+#endif
+
 	err = src_buffer_lengths(&cd->param, cd->source_rate, cd->sink_rate,
-				 params->channels, cd->source_frames);
+				 params->channels, dev->frames, period_fs);
 	if (err < 0) {
 		trace_src_error("src_params() error: src_buffer_lengths() "
 				"failed");
 		return err;
 	}
 
-	trace_src("src_params(), blk_in = %u, blk_out = %u",
-		  cd->param.blk_in, cd->param.blk_out);
+	trace_src("src_params(), sched_length = %u, sbuf_length = %u",
+		  cd->param.sched_length, cd->param.sbuf_length);
 
 	delay_lines_size = sizeof(int32_t) * cd->param.total;
 	if (delay_lines_size == 0) {
@@ -630,7 +1018,7 @@ static int src_params(struct comp_dev *dev)
 	/* Reset stage buffer */
 	cd->sbuf_r_ptr = cd->delay_lines;
 	cd->sbuf_w_ptr = cd->delay_lines;
-	cd->sbuf_avail = 0;
+	cd->sched_idx = 0;
 
 	switch (n) {
 	case 0:
@@ -662,6 +1050,89 @@ static int src_ctrl_cmd(struct comp_dev *dev, struct sof_ipc_ctrl_data *cdata)
 	return -EINVAL;
 }
 
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+static int src_cmd_set_data(struct comp_dev *dev,
+			    struct sof_ipc_ctrl_data *cdata)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	size_t size = cdata->num_elems + cdata->elems_remaining;
+	size_t offset;
+	int ret;
+
+	if (cdata->cmd != SOF_CTRL_CMD_BINARY) {
+		trace_src_error("src_cmd_set_data() error: "
+				"invalid cdata->cmd");
+		return -EINVAL;
+	}
+
+	/* The stages can't be replaced under a running conversion. The
+	 * driver re-sends the blob when the SRC is idle.
+	 */
+	if (dev->state != COMP_STATE_READY) {
+		trace_src_error("src_cmd_set_data() error: driver is busy");
+		return -EBUSY;
+	}
+
+	trace_src("src_cmd_set_data(), blob size: %u msg_index %u",
+		  size, cdata->msg_index);
+
+	if (cdata->msg_index == 0) {
+		if (size < sizeof(*cd->config) ||
+		    size > SOF_SRC_COEF_MAX_SIZE) {
+			trace_src_error("src_cmd_set_data() error: "
+					"invalid blob size %u", size);
+			return -EINVAL;
+		}
+
+		if (cd->config)
+			rfree(cd->config);
+
+		cd->config = rballoc(RZONE_RUNTIME, SOF_MEM_CAPS_RAM, size);
+		if (!cd->config) {
+			trace_src_error("src_cmd_set_data() error: "
+					"buffer allocation failed");
+			return -ENOMEM;
+		}
+
+		cd->config_size = size;
+		offset = 0;
+	} else {
+		if (!cd->config || size > cd->config_size) {
+			trace_src_error("src_cmd_set_data() error: "
+					"unexpected msg_index %u",
+					cdata->msg_index);
+			return -EINVAL;
+		}
+
+		offset = cd->config_size - size;
+	}
+
+	assert(!memcpy_s((char *)cd->config + offset,
+			 cd->config_size - offset, cdata->data->data,
+			 cdata->num_elems));
+
+	if (cdata->elems_remaining)
+		return 0;
+
+	/* The whole blob is received, the coefficients are kept in the
+	 * shared sets only.
+	 */
+	if (cd->config->size == cd->config_size) {
+		ret = src_coef_load(cd);
+	} else {
+		trace_src_error("src_cmd_set_data() error: blob size %u "
+				"received %u", cd->config->size,
+				cd->config_size);
+		ret = -EINVAL;
+	}
+
+	rfree(cd->config);
+	cd->config = NULL;
+
+	return ret;
+}
+#endif
+
 /* used to pass standard and bespoke commands (with data) to component */
 static int src_cmd(struct comp_dev *dev, int cmd, void *data,
 		   int max_data_size)
@@ -673,6 +1144,10 @@ static int src_cmd(struct comp_dev *dev, int cmd, void *data,
 
 	if (cmd == COMP_CMD_SET_VALUE)
 		ret = src_ctrl_cmd(dev, cdata);
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+	else if (cmd == COMP_CMD_SET_DATA)
+		ret = src_cmd_set_data(dev, cdata);
+#endif
 
 	return ret;
 }
@@ -691,41 +1166,49 @@ static int src_get_copy_limits(struct comp_data *cd,
 	struct src_param *sp;
 	struct src_stage *s1;
 	struct src_stage *s2;
+	struct src_sched *step;
 	int frames_src;
 	int frames_snk;
+	int idx = cd->sched_idx;
+	int blk_in;
+	int blk_out;
 
 	/* Get SRC parameters */
 	sp = &cd->param;
 	s1 = cd->src.stage1;
 	s2 = cd->src.stage2;
 
-	/* Calculate how many blocks can be processed with
-	 * available source and free sink frames amount.
+	frames_src = source->avail / comp_frame_bytes(source->source);
+	frames_snk = sink->free / comp_frame_bytes(sink->sink);
+
+	/* Take the next steps of the schedule that fit to available source
+	 * and free sink frames. More than one step is taken only to catch
+	 * up after a period was missed.
 	 */
-	if (s2->filter_length > 1) {
-		/* Two polyphase filters case */
-		frames_snk = sink->free / comp_frame_bytes(sink->sink);
-		frames_snk = MIN(frames_snk, cd->sink_frames + s2->blk_out);
-		sp->stage2_times = frames_snk / s2->blk_out;
-		frames_src = source->avail / comp_frame_bytes(source->source);
-		frames_src = MIN(frames_src, cd->source_frames + s1->blk_in);
-		sp->stage1_times = frames_src / s1->blk_in;
-		sp->blk_in = sp->stage1_times * s1->blk_in;
-		sp->blk_out = sp->stage2_times * s2->blk_out;
-	} else {
-		/* Single polyphase filter case */
-		frames_snk = sink->free / comp_frame_bytes(sink->sink);
-		frames_snk = MIN(frames_snk, cd->sink_frames + s1->blk_out);
-		sp->stage1_times = frames_snk / s1->blk_out;
-		frames_src = source->avail / comp_frame_bytes(source->source);
-		frames_snk = MIN(frames_src, cd->source_frames + s1->blk_in);
-		sp->stage1_times = MIN(sp->stage1_times,
-				       frames_src / s1->blk_in);
-		sp->blk_in = sp->stage1_times * s1->blk_in;
-		sp->blk_out = sp->stage1_times * s1->blk_out;
-	}
-
-	if (sp->blk_in == 0 || sp->blk_out == 0)
+	sp->sched_steps = 0;
+	sp->blk_in = 0;
+	sp->blk_out = 0;
+	while (sp->sched_steps < SRC_SCHED_MAX_STEPS) {
+		step = &cd->src.sched[idx];
+		blk_in = sp->blk_in + step->stage1_times * s1->blk_in;
+		if (s2->filter_length > 1)
+			blk_out = sp->blk_out +
+				step->stage2_times * s2->blk_out;
+		else
+			blk_out = sp->blk_out +
+				step->stage1_times * s1->blk_out;
+
+		if (blk_in > frames_src || blk_out > frames_snk)
+			break;
+
+		sp->blk_in = blk_in;
+		sp->blk_out = blk_out;
+		sp->sched_steps++;
+		if (++idx == sp->sched_length)
+			idx = 0;
+	}
+
+	if (sp->sched_steps == 0)
 		return -EIO;
 
 	return 0;
@@ -761,6 +1244,10 @@ static int src_copy(struct comp_dev *dev)
 
 	cd->src_func(dev, source, sink, &consumed, &produced);
 
+	/* Move to the steps of the next period */
+	cd->sched_idx = (cd->sched_idx + cd->param.sched_steps) %
+		cd->param.sched_length;
+
 	tracev_src("src_copy(), consumed = %u,  produced = %u",
 		   consumed, produced);
 
@@ -881,6 +1368,11 @@ static int src_reset(struct comp_dev *dev)
 	cd->src_func = src_fallback;
 	src_polyphase_reset(&cd->src);
 
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+	src_coef_put(cd->coef_active);
+	cd->coef_active = NULL;
+#endif
+
 	comp_set_state(dev, COMP_TRIGGER_RESET);
 	return 0;
 }
@@ -937,6 +1429,13 @@ struct comp_driver comp_src = {
 
 static void sys_comp_src_init(void)
 {
+#if CONFIG_COMP_SRC_COEF_RUNTIME
+	src_coef = rzalloc(RZONE_SYS | RZONE_FLAG_UNCACHED, SOF_MEM_CAPS_RAM,
+			   sizeof(*src_coef));
+	list_init(&src_coef->list);
+	spinlock_init(&src_coef->lock);
+#endif
+
 	comp_register(&comp_src);
 }
 
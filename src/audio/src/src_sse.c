@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/* SSE4.1 and AVX2 optimized code parts of SRC for the host. The
+ * coefficients are scaled to Q1.23 and widened to 64 bits once when the
+ * stage is initialized. Input is deinterleaved to per channel delay lines
+ * kept twice in a row, so the taps of any sub-filter are read linearly.
+ * The output is bit exact with the generic version.
+ */
+
+#include <stdint.h>
+#include <sof/alloc.h>
+#include <sof/audio/format.h>
+#include <sof/audio/src/src_config.h>
+#include <sof/audio/src/src.h>
+#include <sof/math/numbers.h>
+
+#if SRC_SSE
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#else
+#include <smmintrin.h>
+#endif
+
+void src_polyphase_stage_init(struct src_state *state,
+			      struct src_stage *stage, int nch,
+			      int64_t *coefs)
+{
+	const int32_t *cp = stage->coefs;
+	int i;
+
+	for (i = 0; i < stage->filter_length; i++)
+		coefs[i] = cp[i] >> 8;
+
+	state->coefs = coefs;
+
+	/* Start from the end of the first copy of channel 0 line */
+	state->fir_wp = state->fir_delay +
+		state->fir_delay_size / (SRC_FIR_DELAY_COPIES * nch) - 1;
+}
+
+/* Q1.23 x Q1.31 -> Q2.54 products of a sub-filter */
+static inline int64_t src_sse_dot(const int64_t *coef, const int32_t *data,
+				  int taps)
+{
+	int64_t y = 0;
+	int i = 0;
+
+#ifdef __AVX2__
+	__m256i acc = _mm256_setzero_si256();
+	__m128i sum;
+
+	for (; i + 4 <= taps; i += 4)
+		acc = _mm256_add_epi64(acc, _mm256_mul_epi32
+			(_mm256_loadu_si256((const __m256i *)&coef[i]),
+			 _mm256_cvtepi32_epi64
+				(_mm_loadu_si128((const __m128i *)&data[i]))));
+
+	sum = _mm_add_epi64(_mm256_castsi256_si128(acc),
+			    _mm256_extracti128_si256(acc, 1));
+	y = _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+#else
+	__m128i acc = _mm_setzero_si128();
+
+	for (; i + 2 <= taps; i += 2)
+		acc = _mm_add_epi64(acc, _mm_mul_epi32
+			(_mm_loadu_si128((const __m128i *)&coef[i]),
+			 _mm_cvtepi32_epi64
+				(_mm_loadl_epi64((const __m128i *)&data[i]))));
+
+	y = _mm_cvtsi128_si64(acc) + _mm_extract_epi64(acc, 1);
+#endif
+
+	for (; i < taps; i++)
+		y += coef[i] * data[i];
+
+	return y;
+}
+
+/* Runs the sub-filters of one block to the output delay line */
+static void src_sse_filter(struct src_stage_prm *s, int lines_length,
+			   int newest)
+{
+	struct src_state *fir = s->state;
+	struct src_stage *cfg = s->stage;
+	int32_t *out_delay_end = &fir->out_delay[fir->out_delay_size];
+	const size_t out_size = fir->out_delay_size * sizeof(int32_t);
+	const int nch = s->nch;
+	const int qshift = 23 + cfg->shift; /* Qx.54 -> Qx.31 */
+	const int64_t rnd = (int64_t)1 << (qshift - 1); /* Half LSB */
+	const int64_t *cp = fir->coefs;
+	int32_t *wp = fir->out_rp;
+	int start;
+	int i;
+	int j;
+
+	/* Oldest frame of the first sub-filter, as in the generic version */
+	start = newest + cfg->blk_in - 2 +
+		(cfg->num_of_subfilters - 1) * cfg->idm;
+
+	for (i = 0; i < cfg->num_of_subfilters; i++) {
+		while (start >= lines_length)
+			start -= lines_length;
+		while (start < 0)
+			start += lines_length;
+
+		for (j = 0; j < nch; j++)
+			wp[j] = sat_int32((rnd + src_sse_dot
+				(cp, fir->fir_delay + j * 2 * lines_length +
+				 start, cfg->subfilter_length)) >> qshift);
+
+		wp += cfg->odm * nch;
+		src_inc_wrap(&wp, out_delay_end, out_size);
+		cp += cfg->subfilter_length;
+		start -= cfg->idm;
+	}
+}
+
+void src_polyphase_stage_cir(struct src_stage_prm *s)
+{
+	struct src_state *fir = s->state;
+	struct src_stage *cfg = s->stage;
+	int32_t *out_delay_end = &fir->out_delay[fir->out_delay_size];
+	const size_t out_size = fir->out_delay_size * sizeof(int32_t);
+	const int nch = s->nch;
+	const int lines_length = fir->fir_delay_size /
+		(SRC_FIR_DELAY_COPIES * nch);
+	const int blk_out_words = nch * cfg->num_of_subfilters;
+	int32_t *x_rptr = (int32_t *)s->x_rptr;
+	int32_t *y_wptr = (int32_t *)s->y_wptr;
+	int32_t *x_end_addr = (int32_t *)s->x_end_addr;
+	int32_t *y_end_addr = (int32_t *)s->y_end_addr;
+	int32_t *line;
+	int w = fir->fir_wp - fir->fir_delay;
+	int n;
+	int m;
+	int i;
+	int j;
+
+	for (n = 0; n < s->times; n++) {
+		/* Input data to both copies of the lines, for s24 format
+		 * s->shift is 8
+		 */
+		for (i = 0; i < cfg->blk_in; i++) {
+			line = fir->fir_delay + w;
+			for (j = 0; j < nch; j++) {
+				line[0] = *x_rptr << s->shift;
+				line[lines_length] = line[0];
+				line += 2 * lines_length;
+				x_rptr++;
+			}
+
+			src_inc_wrap(&x_rptr, x_end_addr, s->x_size);
+			w = w ? w - 1 : lines_length - 1;
+		}
+
+		src_sse_filter(s, lines_length, w + 1);
+
+		/* Output, for s24 format s->shift is 8 */
+		for (m = 0; m < blk_out_words; m++) {
+			*y_wptr = *fir->out_rp >> s->shift;
+			y_wptr++;
+			fir->out_rp++;
+			src_inc_wrap(&y_wptr, y_end_addr, s->y_size);
+			src_inc_wrap(&fir->out_rp, out_delay_end, out_size);
+		}
+	}
+
+	fir->fir_wp = fir->fir_delay + w;
+	s->x_rptr = x_rptr;
+	s->y_wptr = y_wptr;
+}
+
+void src_polyphase_stage_cir_s16(struct src_stage_prm *s)
+{
+	struct src_state *fir = s->state;
+	struct src_stage *cfg = s->stage;
+	int32_t *out_delay_end = &fir->out_delay[fir->out_delay_size];
+	const size_t out_size = fir->out_delay_size * sizeof(int32_t);
+	const int nch = s->nch;
+	const int lines_length = fir->fir_delay_size /
+		(SRC_FIR_DELAY_COPIES * nch);
+	const int blk_out_words = nch * cfg->num_of_subfilters;
+	int16_t *x_rptr = (int16_t *)s->x_rptr;
+	int16_t *y_wptr = (int16_t *)s->y_wptr;
+	int16_t *x_end_addr = (int16_t *)s->x_end_addr;
+	int16_t *y_end_addr = (int16_t *)s->y_end_addr;
+	int32_t *line;
+	int w = fir->fir_wp - fir->fir_delay;
+	int n;
+	int m;
+	int i;
+	int j;
+
+	for (n = 0; n < s->times; n++) {
+		/* Input data, used fixed shift by 16 */
+		for (i = 0; i < cfg->blk_in; i++) {
+			line = fir->fir_delay + w;
+			for (j = 0; j < nch; j++) {
+				line[0] = Q_SHIFT_LEFT(*x_rptr, 15, 31);
+				line[lines_length] = line[0];
+				line += 2 * lines_length;
+				x_rptr++;
+			}
+
+			src_inc_wrap_s16(&x_rptr, x_end_addr, s->x_size);
+			w = w ? w - 1 : lines_length - 1;
+		}
+
+		src_sse_filter(s, lines_length, w + 1);
+
+		/* Output, use fixed shift by 16 */
+		for (m = 0; m < blk_out_words; m++) {
+			*y_wptr = Q_SHIFT_RND(*fir->out_rp, 31, 15);
+			y_wptr++;
+			fir->out_rp++;
+			src_inc_wrap_s16(&y_wptr, y_end_addr, s->y_size);
+			src_inc_wrap(&fir->out_rp, out_delay_end, out_size);
+		}
+	}
+
+	fir->fir_wp = fir->fir_delay + w;
+	s->x_rptr = x_rptr;
+	s->y_wptr = y_wptr;
+}
+
+#endif
@@ -698,6 +698,7 @@ static void volume_cache(struct comp_dev *dev, int cmd)
 /** \brief Volume component definition. */
 struct comp_driver comp_volume = {
 	.type	= SOF_COMP_VOLUME,
+	.flags	= COMP_DRV_FUSABLE | COMP_DRV_INPLACE,
 	.ops	= {
 		.new		= volume_new,
 		.free		= volume_free,
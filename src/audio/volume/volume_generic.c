@@ -92,12 +92,15 @@ static inline int32_t vol_mult_s32_to_s24(int32_t x, int32_t vol)
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 16 bit source buffer
  * to 32 bit destination buffer.
  */
-static void vol_s16_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s16_to_s32_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int16_t *src;
@@ -108,7 +111,7 @@ static void vol_s16_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.15 --> Q1.31 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s16(source, buff_frag);
 			dest = buffer_write_frag_s32(sink, buff_frag);
 			*dest = q_multsr_sat_32x32
@@ -126,12 +129,15 @@ static void vol_s16_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 32 bit source buffer
  * to 16 bit destination buffer.
  */
-static void vol_s32_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s32_to_s16_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int32_t *src;
@@ -142,7 +148,7 @@ static void vol_s32_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.31 --> Q1.15 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s32(source, buff_frag);
 			dest = buffer_write_frag_s16(sink, buff_frag);
 
@@ -159,12 +165,15 @@ static void vol_s32_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 32 bit source buffer
  * to 32 bit destination buffer.
  */
-static void vol_s32_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s32_to_s32_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int32_t *src;
@@ -175,7 +184,7 @@ static void vol_s32_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.31 --> Q1.31 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s32(source, buff_frag);
 			dest = buffer_write_frag_s32(sink, buff_frag);
 
@@ -194,12 +203,15 @@ static void vol_s32_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 16 bit source buffer
  * to 16 bit destination buffer.
  */
-static void vol_s16_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s16_to_s16_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int16_t *src;
@@ -210,7 +222,7 @@ static void vol_s16_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.15 --> Q1.15 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s16(source, buff_frag);
 			dest = buffer_write_frag_s16(sink, buff_frag);
 
@@ -229,12 +241,15 @@ static void vol_s16_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 16 bit source buffer
  * to 24/32 bit destination buffer.
  */
-static void vol_s16_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s16_to_s24_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int16_t *src;
@@ -245,7 +260,7 @@ static void vol_s16_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.15 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s16(source, buff_frag);
 			dest = buffer_write_frag_s32(sink, buff_frag);
 
@@ -262,12 +277,15 @@ static void vol_s16_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 24/32 bit source buffer
  * to 16 bit destination buffer.
  */
-static void vol_s24_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s24_to_s16_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int32_t *src;
@@ -278,7 +296,7 @@ static void vol_s24_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.23 --> Q1.15 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s32(source, buff_frag);
 			dest = buffer_write_frag_s16(sink, buff_frag);
 
@@ -295,12 +313,15 @@ static void vol_s24_to_s16(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 32 bit source buffer
  * to 24/32 bit destination buffer.
  */
-static void vol_s32_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s32_to_s24_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int32_t *src;
@@ -311,7 +332,7 @@ static void vol_s32_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.31 --> Q1.23 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s32(source, buff_frag);
 			dest = buffer_write_frag_s32(sink, buff_frag);
 
@@ -328,12 +349,15 @@ static void vol_s32_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 24/32 bit source buffer
  * to 32 bit destination buffer.
  */
-static void vol_s24_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s24_to_s32_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int32_t *src;
@@ -344,7 +368,7 @@ static void vol_s24_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.23 --> Q1.31 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s32(source, buff_frag);
 			dest = buffer_write_frag_s32(sink, buff_frag);
 
@@ -363,12 +387,15 @@ static void vol_s24_to_s32(struct comp_dev *dev, struct comp_buffer *sink,
  * \param[in,out] sink Destination buffer.
  * \param[in,out] source Source buffer.
  * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of channels.
  *
  * Copy and scale volume from 24/32 bit source buffer
  * to 24/32 bit destination buffer.
  */
-static void vol_s24_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
-			   struct comp_buffer *source, uint32_t frames)
+static inline __always_inline void
+vol_s24_to_s24_nch(struct comp_dev *dev, struct comp_buffer *sink,
+		   struct comp_buffer *source, uint32_t frames,
+		   const uint32_t nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
 	int32_t *src;
@@ -379,7 +406,7 @@ static void vol_s24_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
 
 	/* Samples are Q1.23 --> Q1.23 and volume is Q8.16 */
 	for (i = 0; i < frames; i++) {
-		for (channel = 0; channel < dev->params.channels; channel++) {
+		for (channel = 0; channel < nch; channel++) {
 			src = buffer_read_frag_s32(source, buff_frag);
 			dest = buffer_write_frag_s32(sink, buff_frag);
 
@@ -390,16 +417,139 @@ static void vol_s24_to_s24(struct comp_dev *dev, struct comp_buffer *sink,
 	}
 }
 
+/**
+ * \brief Instantiates volume processing function for a channel count.
+ * \param[in] func Name of the instantiated function.
+ * \param[in] name Processing function template.
+ * \param[in] nch Number of channels, a constant lets the compiler unroll
+ *		  the channel loop.
+ */
+#define VOL_FUNC(func, name, nch)					\
+static void func(struct comp_dev *dev, struct comp_buffer *sink,	\
+		 struct comp_buffer *source, uint32_t frames)		\
+{									\
+	name##_nch(dev, sink, source, frames, nch);			\
+}
+
+VOL_FUNC(vol_s16_to_s16, vol_s16_to_s16, dev->params.channels)
+VOL_FUNC(vol_s16_to_s16_1ch, vol_s16_to_s16, 1)
+VOL_FUNC(vol_s16_to_s16_2ch, vol_s16_to_s16, 2)
+VOL_FUNC(vol_s16_to_s16_4ch, vol_s16_to_s16, 4)
+VOL_FUNC(vol_s16_to_s16_6ch, vol_s16_to_s16, 6)
+VOL_FUNC(vol_s16_to_s16_8ch, vol_s16_to_s16, 8)
+
+VOL_FUNC(vol_s16_to_s32, vol_s16_to_s32, dev->params.channels)
+VOL_FUNC(vol_s16_to_s32_1ch, vol_s16_to_s32, 1)
+VOL_FUNC(vol_s16_to_s32_2ch, vol_s16_to_s32, 2)
+VOL_FUNC(vol_s16_to_s32_4ch, vol_s16_to_s32, 4)
+VOL_FUNC(vol_s16_to_s32_6ch, vol_s16_to_s32, 6)
+VOL_FUNC(vol_s16_to_s32_8ch, vol_s16_to_s32, 8)
+
+VOL_FUNC(vol_s32_to_s16, vol_s32_to_s16, dev->params.channels)
+VOL_FUNC(vol_s32_to_s16_1ch, vol_s32_to_s16, 1)
+VOL_FUNC(vol_s32_to_s16_2ch, vol_s32_to_s16, 2)
+VOL_FUNC(vol_s32_to_s16_4ch, vol_s32_to_s16, 4)
+VOL_FUNC(vol_s32_to_s16_6ch, vol_s32_to_s16, 6)
+VOL_FUNC(vol_s32_to_s16_8ch, vol_s32_to_s16, 8)
+
+VOL_FUNC(vol_s32_to_s32, vol_s32_to_s32, dev->params.channels)
+VOL_FUNC(vol_s32_to_s32_1ch, vol_s32_to_s32, 1)
+VOL_FUNC(vol_s32_to_s32_2ch, vol_s32_to_s32, 2)
+VOL_FUNC(vol_s32_to_s32_4ch, vol_s32_to_s32, 4)
+VOL_FUNC(vol_s32_to_s32_6ch, vol_s32_to_s32, 6)
+VOL_FUNC(vol_s32_to_s32_8ch, vol_s32_to_s32, 8)
+
+VOL_FUNC(vol_s16_to_s24, vol_s16_to_s24, dev->params.channels)
+VOL_FUNC(vol_s16_to_s24_1ch, vol_s16_to_s24, 1)
+VOL_FUNC(vol_s16_to_s24_2ch, vol_s16_to_s24, 2)
+VOL_FUNC(vol_s16_to_s24_4ch, vol_s16_to_s24, 4)
+VOL_FUNC(vol_s16_to_s24_6ch, vol_s16_to_s24, 6)
+VOL_FUNC(vol_s16_to_s24_8ch, vol_s16_to_s24, 8)
+
+VOL_FUNC(vol_s24_to_s16, vol_s24_to_s16, dev->params.channels)
+VOL_FUNC(vol_s24_to_s16_1ch, vol_s24_to_s16, 1)
+VOL_FUNC(vol_s24_to_s16_2ch, vol_s24_to_s16, 2)
+VOL_FUNC(vol_s24_to_s16_4ch, vol_s24_to_s16, 4)
+VOL_FUNC(vol_s24_to_s16_6ch, vol_s24_to_s16, 6)
+VOL_FUNC(vol_s24_to_s16_8ch, vol_s24_to_s16, 8)
+
+VOL_FUNC(vol_s32_to_s24, vol_s32_to_s24, dev->params.channels)
+VOL_FUNC(vol_s32_to_s24_1ch, vol_s32_to_s24, 1)
+VOL_FUNC(vol_s32_to_s24_2ch, vol_s32_to_s24, 2)
+VOL_FUNC(vol_s32_to_s24_4ch, vol_s32_to_s24, 4)
+VOL_FUNC(vol_s32_to_s24_6ch, vol_s32_to_s24, 6)
+VOL_FUNC(vol_s32_to_s24_8ch, vol_s32_to_s24, 8)
+
+VOL_FUNC(vol_s24_to_s32, vol_s24_to_s32, dev->params.channels)
+VOL_FUNC(vol_s24_to_s32_1ch, vol_s24_to_s32, 1)
+VOL_FUNC(vol_s24_to_s32_2ch, vol_s24_to_s32, 2)
+VOL_FUNC(vol_s24_to_s32_4ch, vol_s24_to_s32, 4)
+VOL_FUNC(vol_s24_to_s32_6ch, vol_s24_to_s32, 6)
+VOL_FUNC(vol_s24_to_s32_8ch, vol_s24_to_s32, 8)
+
+VOL_FUNC(vol_s24_to_s24, vol_s24_to_s24, dev->params.channels)
+VOL_FUNC(vol_s24_to_s24_1ch, vol_s24_to_s24, 1)
+VOL_FUNC(vol_s24_to_s24_2ch, vol_s24_to_s24, 2)
+VOL_FUNC(vol_s24_to_s24_4ch, vol_s24_to_s24, 4)
+VOL_FUNC(vol_s24_to_s24_6ch, vol_s24_to_s24, 6)
+VOL_FUNC(vol_s24_to_s24_8ch, vol_s24_to_s24, 8)
+
+/* specialised variants come first, entries with channels 0 match any */
 const struct comp_func_map func_map[] = {
-	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, vol_s16_to_s16},
-	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, vol_s16_to_s32},
-	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, vol_s32_to_s16},
-	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, vol_s32_to_s32},
-	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, vol_s16_to_s24},
-	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, vol_s24_to_s16},
-	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, vol_s32_to_s24},
-	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, vol_s24_to_s32},
-	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, vol_s16_to_s16_2ch, 2},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, vol_s16_to_s32_2ch, 2},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, vol_s32_to_s16_2ch, 2},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, vol_s32_to_s32_2ch, 2},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, vol_s16_to_s24_2ch, 2},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, vol_s24_to_s16_2ch, 2},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, vol_s32_to_s24_2ch, 2},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, vol_s24_to_s32_2ch, 2},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24_2ch, 2},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, vol_s16_to_s16_4ch, 4},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, vol_s16_to_s32_4ch, 4},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, vol_s32_to_s16_4ch, 4},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, vol_s32_to_s32_4ch, 4},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, vol_s16_to_s24_4ch, 4},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, vol_s24_to_s16_4ch, 4},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, vol_s32_to_s24_4ch, 4},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, vol_s24_to_s32_4ch, 4},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24_4ch, 4},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, vol_s16_to_s16_1ch, 1},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, vol_s16_to_s32_1ch, 1},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, vol_s32_to_s16_1ch, 1},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, vol_s32_to_s32_1ch, 1},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, vol_s16_to_s24_1ch, 1},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, vol_s24_to_s16_1ch, 1},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, vol_s32_to_s24_1ch, 1},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, vol_s24_to_s32_1ch, 1},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24_1ch, 1},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, vol_s16_to_s16_6ch, 6},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, vol_s16_to_s32_6ch, 6},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, vol_s32_to_s16_6ch, 6},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, vol_s32_to_s32_6ch, 6},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, vol_s16_to_s24_6ch, 6},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, vol_s24_to_s16_6ch, 6},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, vol_s32_to_s24_6ch, 6},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, vol_s24_to_s32_6ch, 6},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24_6ch, 6},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, vol_s16_to_s16_8ch, 8},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, vol_s16_to_s32_8ch, 8},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, vol_s32_to_s16_8ch, 8},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, vol_s32_to_s32_8ch, 8},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, vol_s16_to_s24_8ch, 8},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, vol_s24_to_s16_8ch, 8},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, vol_s32_to_s24_8ch, 8},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, vol_s24_to_s32_8ch, 8},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24_8ch, 8},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, vol_s16_to_s16, 0},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, vol_s16_to_s32, 0},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, vol_s32_to_s16, 0},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, vol_s32_to_s32, 0},
+	{SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, vol_s16_to_s24, 0},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, vol_s24_to_s16, 0},
+	{SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, vol_s32_to_s24, 0},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, vol_s24_to_s32, 0},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24, 0},
 };
 
 const size_t func_count = ARRAY_SIZE(func_map);
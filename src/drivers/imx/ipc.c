@@ -51,8 +51,6 @@ static void do_notify(void)
 	if (msg->cb)
 		msg->cb(msg->cb_data, msg->rx_data);
 
-	list_item_append(&msg->list, &_ipc->shared_ctx->empty_list);
-
 out:
 	spin_unlock_irq(&_ipc->lock, flags);
 
@@ -152,7 +150,7 @@ void ipc_platform_send_msg(struct ipc *ipc)
 	spin_lock_irq(&ipc->lock, flags);
 
 	/* any messages to send ? */
-	if (list_is_empty(&ipc->shared_ctx->msg_list)) {
+	if (!ipc_msg_pending(ipc)) {
 		ipc->shared_ctx->dsp_pending = 0;
 		goto out;
 	}
@@ -162,17 +160,15 @@ void ipc_platform_send_msg(struct ipc *ipc)
 		goto out;
 
 	/* now send the message */
-	msg = list_first_item(&ipc->shared_ctx->msg_list, struct ipc_msg,
-			      list);
+	msg = ipc_msg_get_next(ipc);
 	mailbox_dspbox_write(0, msg->tx_data, msg->tx_size);
-	list_item_del(&msg->list);
 	ipc->shared_ctx->dsp_msg = msg;
 	tracev_ipc("ipc: msg tx -> 0x%x", msg->header);
 
 	/* now interrupt host to tell it we have sent a message */
 	imx_mu_xcr_rmw(IMX_MU_xCR_GIRn(1), 0);
 
-	list_item_append(&msg->list, &ipc->shared_ctx->empty_list);
+	ipc_msg_put(ipc, msg);
 
 out:
 	spin_unlock_irq(&ipc->lock, flags);
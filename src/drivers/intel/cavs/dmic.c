@@ -18,6 +18,9 @@
 
 #define DMIC_MAX_MODES 50
 
+/* Number of computed decimator configurations kept for reuse */
+#define DMIC_CONFIG_CACHE_SIZE 2
+
 /* HW FIR pipeline needs 5 additional cycles per channel for internal
  * operations. This is used in MAX filter length check.
  */
@@ -54,6 +57,29 @@ struct dmic_configuration {
 	int32_t fir_b_scale;
 };
 
+/* Parameters the decimator configuration is computed from. The IO clock is
+ * fixed in a build so it is not part of the key.
+ */
+struct dmic_config_key {
+	uint32_t fifo_fs_a;
+	uint32_t fifo_fs_b;
+	uint32_t pdmclk_min;
+	uint32_t pdmclk_max;
+	uint16_t duty_min;
+	uint16_t duty_max;
+};
+
+/* Computed decimator configuration with the FIR coefficients scaled and
+ * formatted for the coefficient RAM, in the RAM order.
+ */
+struct dmic_config_cache {
+	struct dmic_config_key key;
+	struct dmic_configuration cfg;
+	uint32_t *coef_a;
+	uint32_t *coef_b;
+	uint32_t coef[];
+};
+
 struct pdm_controllers_configuration {
 	uint32_t cic_control;
 	uint32_t cic_config;
@@ -133,6 +159,9 @@ static const uint32_t coef_base_b[4] = {PDM0_COEFFICIENT_B, PDM1_COEFFICIENT_B,
 static struct sof_ipc_dai_dmic_params *dmic_prm[DMIC_HW_FIFOS];
 static int dmic_active_fifos;
 
+/* Recently used decimator configurations, the most recent first */
+static struct dmic_config_cache *dmic_cache[DMIC_CONFIG_CACHE_SIZE];
+
 static void dmic_write(struct dai *dai, uint32_t reg, uint32_t value)
 {
 	io_reg_write(dai_base(dai) + reg, value);
@@ -775,13 +804,12 @@ static int stereo_helper(int stereo[], int swap[])
 }
 
 static int configure_registers(struct dai *dai,
-			       struct dmic_configuration *cfg)
+			       struct dmic_config_cache *cc)
 {
+	struct dmic_configuration *cfg = &cc->cfg;
 	int stereo[DMIC_HW_CONTROLLERS];
 	int swap[DMIC_HW_CONTROLLERS];
 	uint32_t val;
-	int32_t ci;
-	uint32_t cu;
 	int ipm;
 	int of0;
 	int of1;
@@ -1010,39 +1038,149 @@ static int configure_registers(struct dai *dai,
 		dmic_write(dai, base[i] + OUT_GAIN_RIGHT_B, val);
 		trace_dmic("configure_registers(), OUT_GAIN_RIGHT_B = %u", val);
 
-		/* Write coef RAM A with scaled coefficient in reverse order */
+		/* Write coef RAM A and B with the scaled coefficients */
 		length = cfg->fir_a_length;
-		for (j = 0; j < length; j++) {
-			ci = (int32_t)Q_MULTSR_32X32(
-				(int64_t)cfg->fir_a->coef[j], cfg->fir_a_scale,
-				31, DMIC_FIR_SCALE_Q, DMIC_HW_FIR_COEF_Q);
-			cu = FIR_COEF_A(ci);
-			dmic_write(dai, coef_base_a[i]
-				   + ((length - j - 1) << 2), cu);
-		}
+		for (j = 0; j < length; j++)
+			dmic_write(dai, coef_base_a[i] + (j << 2),
+				   cc->coef_a[j]);
 
-		/* Write coef RAM B with scaled coefficient in reverse order */
 		length = cfg->fir_b_length;
-		for (j = 0; j < length; j++) {
-			ci = (int32_t)Q_MULTSR_32X32(
-				(int64_t)cfg->fir_b->coef[j], cfg->fir_b_scale,
-				31, DMIC_FIR_SCALE_Q, DMIC_HW_FIR_COEF_Q);
-			cu = FIR_COEF_B(ci);
-			dmic_write(dai, coef_base_b[i]
-				   + ((length - j - 1) << 2), cu);
-		}
+		for (j = 0; j < length; j++)
+			dmic_write(dai, coef_base_b[i] + (j << 2),
+				   cc->coef_b[j]);
 	}
 
 	return 0;
 }
 
-static int dmic_set_config(struct dai *dai, struct sof_ipc_dai_config *config)
+/* Scales the FIR coefficients with the computed scale to the coefficient
+ * RAM format. The RAM takes the coefficients in reverse order.
+ */
+static void fir_coef_ram(uint32_t *ram, struct pdm_decim *fir, int32_t scale,
+			 bool fifo_b)
 {
-	struct dmic_pdata *dmic = dai_get_drvdata(dai);
+	int32_t ci;
+	int j;
+
+	for (j = 0; j < fir->length; j++) {
+		ci = (int32_t)Q_MULTSR_32X32((int64_t)fir->coef[j], scale,
+					     31, DMIC_FIR_SCALE_Q,
+					     DMIC_HW_FIR_COEF_Q);
+		ram[fir->length - j - 1] = fifo_b ? FIR_COEF_B(ci) :
+			FIR_COEF_A(ci);
+	}
+}
+
+/* Match and select optimal decimators configuration for FIFOs A and B
+ * paths. Successful completion returns a new cache entry that contains the
+ * CIC and FIR settings and the FIR coefficients ready for the coefficient
+ * RAM write.
+ */
+static struct dmic_config_cache *
+dmic_config_compute(struct dmic_config_key *key, int di)
+{
+	struct dmic_config_cache *cc;
 	struct matched_modes modes_ab;
 	struct dmic_configuration cfg;
 	struct decim_modes modes_a;
 	struct decim_modes modes_b;
+	int ret;
+
+	find_modes(&modes_a, key->fifo_fs_a, di);
+	if (modes_a.num_of_modes == 0 && key->fifo_fs_a > 0) {
+		trace_dmic_error("dmic_config_compute() error: "
+				 "No modes found found for FIFO A");
+		return NULL;
+	}
+
+	find_modes(&modes_b, key->fifo_fs_b, di);
+	if (modes_b.num_of_modes == 0 && key->fifo_fs_b > 0) {
+		trace_dmic_error("dmic_config_compute() error: "
+				 "No modes found for FIFO B");
+		return NULL;
+	}
+
+	match_modes(&modes_ab, &modes_a, &modes_b);
+	ret = select_mode(&cfg, &modes_ab);
+	if (ret < 0) {
+		trace_dmic_error("dmic_config_compute() error: "
+				 "select_mode() failed");
+		return NULL;
+	}
+
+	cc = rzalloc(RZONE_RUNTIME, SOF_MEM_CAPS_RAM, sizeof(*cc) +
+		     (cfg.fir_a_length + cfg.fir_b_length) * sizeof(uint32_t));
+	if (!cc) {
+		trace_dmic_error("dmic_config_compute() error: alloc failed");
+		return NULL;
+	}
+
+	cc->key = *key;
+	cc->cfg = cfg;
+	cc->coef_a = cc->coef;
+	cc->coef_b = cc->coef + cfg.fir_a_length;
+
+	if (cfg.fir_a_length)
+		fir_coef_ram(cc->coef_a, cfg.fir_a, cfg.fir_a_scale, false);
+
+	if (cfg.fir_b_length)
+		fir_coef_ram(cc->coef_b, cfg.fir_b, cfg.fir_b_scale, true);
+
+	return cc;
+}
+
+/* Returns the decimator configuration for the key. A recently used
+ * configuration is reused, otherwise a new one is computed and the least
+ * recently used is dropped.
+ */
+static struct dmic_config_cache *dmic_config_get(struct dmic_config_key *key,
+						 int di)
+{
+	struct dmic_config_cache *cc;
+	int i;
+
+	for (i = 0; i < DMIC_CONFIG_CACHE_SIZE && dmic_cache[i]; i++) {
+		if (!memcmp(&dmic_cache[i]->key, key, sizeof(*key)))
+			break;
+	}
+
+	if (i < DMIC_CONFIG_CACHE_SIZE && dmic_cache[i]) {
+		trace_dmic("dmic_config_get(), cached configuration %d", i);
+		cc = dmic_cache[i];
+	} else {
+		cc = dmic_config_compute(key, di);
+		if (!cc)
+			return NULL;
+
+		i = DMIC_CONFIG_CACHE_SIZE - 1;
+		if (dmic_cache[i])
+			rfree(dmic_cache[i]);
+	}
+
+	/* Move to the front as the most recently used */
+	for (; i > 0; i--)
+		dmic_cache[i] = dmic_cache[i - 1];
+	dmic_cache[0] = cc;
+
+	return cc;
+}
+
+static void dmic_config_cache_free(void)
+{
+	int i;
+
+	for (i = 0; i < DMIC_CONFIG_CACHE_SIZE; i++) {
+		rfree(dmic_cache[i]);
+		dmic_cache[i] = NULL;
+	}
+}
+
+static int dmic_set_config(struct dai *dai, struct sof_ipc_dai_config *config)
+{
+	struct dmic_pdata *dmic = dai_get_drvdata(dai);
+	struct dmic_config_key key;
+	struct dmic_config_cache *cc;
+	struct dmic_configuration *cfg;
 	int32_t unmute_ramp_time_ms;
 	int32_t step_db;
 	size_t size;
@@ -1159,49 +1297,42 @@ static int dmic_set_config(struct dai *dai, struct sof_ipc_dai_config *config)
 		return -EINVAL;
 	}
 
-	/* Match and select optimal decimators configuration for FIFOs A and B
-	 * paths. This setup phase is still abstract. Successful completion
-	 * points struct cfg to FIR coefficients and contains the scale value
-	 * to use for FIR coefficient RAM write as well as the CIC and FIR
-	 * shift values.
+	/* Get the decimators configuration for FIFOs A and B paths. This
+	 * setup phase is still abstract. The search for the modes and the
+	 * scaling of the FIR coefficients are done only when the parameters
+	 * have not been recently used.
 	 */
-	find_modes(&modes_a, dmic_prm[0]->fifo_fs, di);
-	if (modes_a.num_of_modes == 0 && dmic_prm[0]->fifo_fs > 0) {
-		trace_dmic_error("dmic_set_config() error: "
-				 "No modes found found for FIFO A");
-		return -EINVAL;
-	}
-
-	find_modes(&modes_b, dmic_prm[1]->fifo_fs, di);
-	if (modes_b.num_of_modes == 0 && dmic_prm[1]->fifo_fs > 0) {
+	memset(&key, 0, sizeof(key));
+	key.fifo_fs_a = dmic_prm[0]->fifo_fs;
+	key.fifo_fs_b = dmic_prm[1]->fifo_fs;
+	key.pdmclk_min = dmic_prm[di]->pdmclk_min;
+	key.pdmclk_max = dmic_prm[di]->pdmclk_max;
+	key.duty_min = dmic_prm[di]->duty_min;
+	key.duty_max = dmic_prm[di]->duty_max;
+
+	cc = dmic_config_get(&key, di);
+	if (!cc) {
 		trace_dmic_error("dmic_set_config() error: "
-				 "No modes found for FIFO B");
-		return -EINVAL;
-	}
-
-	match_modes(&modes_ab, &modes_a, &modes_b);
-	ret = select_mode(&cfg, &modes_ab);
-	if (ret < 0) {
-		trace_dmic_error("dmic_set_config() error: "
-				 "select_mode() failed");
+				 "no decimator configuration");
 		return -EINVAL;
 	}
 
+	cfg = &cc->cfg;
 	trace_dmic("dmic_set_config(), cfg clkdiv = %u, mcic = %u",
-		   cfg.clkdiv, cfg.mcic);
+		   cfg->clkdiv, cfg->mcic);
 	trace_dmic("dmic_set_config(), cfg mfir_a = %u, mfir_b = %u",
-		   cfg.mfir_a, cfg.mfir_b);
-	trace_dmic("dmic_set_config(), cfg cic_shift = %u", cfg.cic_shift);
+		   cfg->mfir_a, cfg->mfir_b);
+	trace_dmic("dmic_set_config(), cfg cic_shift = %u", cfg->cic_shift);
 	trace_dmic("dmic_set_config(), cfg fir_a_shift = %u, "
-		   "cfg.fir_b_shift = %u", cfg.fir_a_shift, cfg.fir_b_shift);
+		   "cfg.fir_b_shift = %u", cfg->fir_a_shift, cfg->fir_b_shift);
 	trace_dmic("dmic_set_config(), cfg fir_a_length = %u, "
-		   "fir_b_length = %u", cfg.fir_a_length, cfg.fir_b_length);
+		   "fir_b_length = %u", cfg->fir_a_length, cfg->fir_b_length);
 
 	/* Struct reg contains a mirror of actual HW registers. Determine
 	 * register bits configuration from decimator configuration and the
 	 * requested parameters.
 	 */
-	ret = configure_registers(dai, &cfg);
+	ret = configure_registers(dai, cc);
 	if (ret < 0) {
 		trace_dmic_error("dmic_set_config() error: "
 				 "cannot configure registers");
@@ -1547,6 +1678,8 @@ static int dmic_remove(struct dai *dai)
 	for (i = 0; i < DMIC_HW_FIFOS; i++)
 		dmic_prm[i] = NULL;
 
+	dmic_config_cache_free();
+
 	return 0;
 }
 
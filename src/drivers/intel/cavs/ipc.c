@@ -200,7 +200,7 @@ void ipc_platform_send_msg(struct ipc *ipc)
 	spin_lock_irq(&ipc->lock, flags);
 
 	/* any messages to send ? */
-	if (list_is_empty(&ipc->shared_ctx->msg_list)) {
+	if (!ipc_msg_pending(ipc)) {
 		ipc->shared_ctx->dsp_pending = 0;
 		goto out;
 	}
@@ -214,10 +214,8 @@ void ipc_platform_send_msg(struct ipc *ipc)
 		goto out;
 
 	/* now send the message */
-	msg = list_first_item(&ipc->shared_ctx->msg_list, struct ipc_msg,
-			      list);
+	msg = ipc_msg_get_next(ipc);
 	mailbox_dspbox_write(0, msg->tx_data, msg->tx_size);
-	list_item_del(&msg->list);
 	ipc->shared_ctx->dsp_msg = msg;
 	tracev_ipc("ipc: msg tx -> 0x%x", msg->header);
 
@@ -230,7 +228,7 @@ void ipc_platform_send_msg(struct ipc *ipc)
 	ipc_write(IPC_DIPCIDR, 0x80000000 | msg->header);
 #endif
 
-	list_item_append(&msg->list, &ipc->shared_ctx->empty_list);
+	ipc_msg_put(ipc, msg);
 
 out:
 	spin_unlock_irq(&ipc->lock, flags);
@@ -0,0 +1,131 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2019 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file include/ipc/debug.h
+ * \brief IPC debug status definitions
+ */
+
+#ifndef __INCLUDE_UAPI_IPC_DEBUG_H__
+#define __INCLUDE_UAPI_IPC_DEBUG_H__
+
+#include <ipc/header.h>
+
+/*
+ * Memory usage
+ */
+
+/* heap zones reported in sof_ipc_dbg_heap_usage */
+#define SOF_IPC_MEM_ZONE_SYS		0
+#define SOF_IPC_MEM_ZONE_SYS_RUNTIME	1
+#define SOF_IPC_MEM_ZONE_RUNTIME	2
+#define SOF_IPC_MEM_ZONE_BUFFER		3
+
+/* usage of one heap */
+struct sof_ipc_dbg_heap_usage {
+	uint32_t zone;		/* SOF_IPC_MEM_ZONE_ */
+	uint32_t id;		/* heap index within zone */
+	uint32_t used;		/* bytes allocated */
+	uint32_t free;		/* bytes free */
+	uint32_t peak;		/* high-water mark of allocated bytes */
+	uint32_t allocs;	/* number of live allocations */
+	uint32_t max_free;	/* largest contiguous free region in bytes */
+} __attribute__((packed));
+
+/* heap usage attributed to one pipeline */
+struct sof_ipc_dbg_pipe_usage {
+	uint32_t pipeline_id;
+	uint32_t used;		/* bytes allocated */
+	uint32_t peak;		/* high-water mark of allocated bytes */
+	uint32_t allocs;	/* number of live allocations */
+} __attribute__((packed));
+
+/*
+ * Memory usage reply - SOF_IPC_DEBUG_MEM_USAGE
+ *
+ * Followed by num_heaps sof_ipc_dbg_heap_usage and then num_pipes
+ * sof_ipc_dbg_pipe_usage elements. Lists are truncated to fit the mailbox.
+ */
+struct sof_ipc_dbg_mem_usage {
+	struct sof_ipc_reply rhdr;
+	uint32_t num_heaps;
+	uint32_t num_pipes;
+
+	/* buffer pool */
+	uint32_t pool_hits;	/* buffer allocations served from pool */
+	uint32_t pool_misses;	/* buffer allocations served from heap */
+	uint32_t pool_bytes;	/* bytes retained by the pool */
+
+	/* host notifications */
+	uint32_t msg_coalesced;	/* payloads replaced before they were sent */
+	uint32_t msg_dropped;	/* messages lost for lack of space */
+} __attribute__((packed));
+
+/*
+ * MCPS usage, loads are in thousands of cycles per second
+ */
+
+/* committed and measured load of one core */
+struct sof_ipc_dbg_core_mcps {
+	uint32_t core;
+	uint32_t budget;	/* admission budget, 0 if not limited */
+	uint32_t committed;	/* declared load of running pipelines */
+	uint32_t load;		/* measured busy time in per mille */
+} __attribute__((packed));
+
+/* declared and measured load of one pipeline */
+struct sof_ipc_dbg_pipe_mcps {
+	uint32_t pipeline_id;
+	uint32_t core;
+	uint32_t declared;	/* from topology period_mips */
+	uint32_t measured;	/* worst case period since stream start */
+} __attribute__((packed));
+
+/*
+ * MCPS usage reply - SOF_IPC_DEBUG_MCPS_USAGE
+ *
+ * Followed by num_cores sof_ipc_dbg_core_mcps and then num_pipes
+ * sof_ipc_dbg_pipe_mcps elements. Lists are truncated to fit the mailbox.
+ */
+struct sof_ipc_dbg_mcps_usage {
+	struct sof_ipc_reply rhdr;
+	uint32_t num_cores;
+	uint32_t num_pipes;
+
+	/* reserved for future use */
+	uint32_t reserved[2];
+} __attribute__((packed));
+
+/*
+ * Load breakdown, all values are per mille of the last load window and
+ * nested activities are only accounted to the innermost one
+ */
+
+/* activities of one core */
+struct sof_ipc_dbg_core_load {
+	uint32_t core;
+	uint32_t busy;		/* running scheduled tasks */
+	uint32_t idle;		/* waiting for interrupts */
+	uint32_t ll;		/* low latency scheduler tasks */
+	uint32_t edf;		/* EDF scheduler tasks */
+	uint32_t irq;		/* all interrupt handlers */
+	uint32_t irq_top;	/* busiest level 1 interrupt */
+	uint32_t irq_top_load;
+} __attribute__((packed));
+
+/*
+ * Load usage reply - SOF_IPC_DEBUG_LOAD_USAGE
+ *
+ * Followed by num_cores sof_ipc_dbg_core_load elements.
+ */
+struct sof_ipc_dbg_load_usage {
+	struct sof_ipc_reply rhdr;
+	uint32_t num_cores;
+
+	/* reserved for future use */
+	uint32_t reserved[3];
+} __attribute__((packed));
+
+#endif
@@ -71,6 +71,7 @@
 #define SOF_IPC_GLB_TRACE_MSG			SOF_GLB_TYPE(0x9U)
 #define SOF_IPC_GLB_GDB_DEBUG                   SOF_GLB_TYPE(0xAU)
 #define SOF_IPC_GLB_TEST			SOF_GLB_TYPE(0xBU)
+#define SOF_IPC_GLB_DEBUG			SOF_GLB_TYPE(0xCU)
 
 /** @} */
 
@@ -159,6 +160,16 @@
 
 /** @} */
 
+/** \name DSP Command: Debug - status queries
+ *  @{
+ */
+
+#define SOF_IPC_DEBUG_MEM_USAGE			SOF_CMD_TYPE(0x001)
+#define SOF_IPC_DEBUG_MCPS_USAGE		SOF_CMD_TYPE(0x002)
+#define SOF_IPC_DEBUG_LOAD_USAGE		SOF_CMD_TYPE(0x003)
+
+/** @} */
+
 /** \name IPC Message Definitions
  * @{
  */
@@ -208,12 +219,26 @@ struct sof_ipc_reply {
  * commands are split into blocks and each block has a header. This header
  * identifies the command type and the number of commands before the next
  * header.
+ *
+ * The message starts with a header where hdr.cmd is SOF_IPC_GLB_COMPOUND,
+ * hdr.size is the size of the whole message and count is the total number
+ * of commands. Each command is a complete IPC structure of the block type.
+ * Commands are applied in order and the message may be larger than
+ * SOF_IPC_MSG_MAX_SIZE, up to the size of the host mailbox. Only topology
+ * new, connect and complete commands are supported. If a command fails,
+ * every object created earlier by the same message is freed again.
  */
 struct sof_ipc_compound_hdr {
 	struct sof_ipc_cmd_hdr hdr;
 	uint32_t count;		/**< count of 0 means end of compound sequence */
 } __attribute__((packed));
 
+/** Reply to SOF_IPC_GLB_COMPOUND */
+struct sof_ipc_compound_reply {
+	struct sof_ipc_reply rhdr;
+	uint32_t count;		/**< commands applied, index of failed one */
+} __attribute__((packed));
+
 /**
  * OOPS header architecture specific data.
  */
@@ -46,6 +46,7 @@
 
 /* generic PCM flags for runtime settings */
 #define SOF_PCM_FLAG_XRUN_STOP	(1 << 0) /**< Stop on any XRUN */
+#define SOF_PCM_FLAG_POSN_SHARED (1 << 1) /**< Host polls stream positions */
 
 /* stream PCM frame format */
 enum sof_ipc_frame {
@@ -137,6 +138,13 @@ struct sof_ipc_stream {
 #define	SOF_TIME_WALL_64	(1 << 18)
 #define	SOF_TIME_STAMP_64	(1 << 19)
 
+/*
+ * Stream position, sent with SOF_IPC_STREAM_POSITION and kept up to date in
+ * the mailbox stream region at posn_offset. In the stream region rhdr.error
+ * is a sequence count which is odd while the DSP updates the position, so
+ * a polling host (SOF_PCM_FLAG_POSN_SHARED) retries its copy until it reads
+ * the same even count before and after it.
+ */
 struct sof_ipc_stream_posn {
 	struct sof_ipc_reply rhdr;
 	uint32_t comp_id;	/**< host component ID */
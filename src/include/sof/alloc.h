@@ -14,8 +14,10 @@
 #include <sof/string.h>
 #include <stdint.h>
 #include <sof/bit.h>
+#include <sof/list.h>
 #include <sof/platform.h>
 #include <platform/platform.h>
+#include <platform/cpu.h>
 #include <arch/spinlock.h>
 #include <ipc/topology.h>
 struct sof;
@@ -53,14 +55,65 @@ struct sof;
 struct dma_copy;
 struct dma_sg_config;
 
+/* number of pipelines heap usage can be attributed to, slot 0 is unowned */
+#define HEAP_OWNER_COUNT	16
+#define HEAP_OWNER_SLOT_NONE	0
+
+/* pipeline ID of unused heap owner slots */
+#define HEAP_OWNER_NONE		0xffffffff
+
 struct mm_info {
 	uint32_t used;
 	uint32_t free;
+	uint32_t peak;		/* high-water mark of used bytes */
+	uint32_t allocs;	/* number of live allocations */
+};
+
+/* heap usage attributed to one pipeline */
+struct mm_owner {
+	uint32_t id;		/* pipeline ID or HEAP_OWNER_NONE */
+	uint32_t used;		/* bytes currently allocated */
+	uint32_t peak;		/* high-water mark of used bytes */
+	uint32_t allocs;	/* number of live allocations */
+};
+
+/* number of allocations made before the seal whose space can be reused */
+#define ARENA_SLOTS	16
+
+/* allocation made in an arena before it was sealed */
+struct mm_arena_slot {
+	uint32_t offset;	/* offset in arena region */
+	uint32_t size;		/* size in bytes */
+	bool free;		/* released, can take a new allocation */
+};
+
+/*
+ * Pipeline arena. A single buffer heap region reserved for one pipeline.
+ * Runtime and buffer allocations made on behalf of the owning pipeline are
+ * bump allocated from it and the region goes back to the heap in one piece
+ * once the pipeline is freed and its last allocation released.
+ */
+struct mm_arena {
+	struct list_item list;	/* in memmap arena list */
+	uint32_t owner;		/* pipeline ID */
+	uint32_t caps;		/* caps allocations must fit in */
+	void *base;		/* arena region */
+	uint32_t size;		/* arena region size in bytes */
+	uint32_t top;		/* offset of next free byte */
+	uint32_t last;		/* offset of most recent allocation */
+	uint32_t mark;		/* top when arena was sealed */
+	uint32_t pinned;	/* live allocations below mark */
+	uint32_t live;		/* live allocations above mark */
+	struct mm_arena_slot slot[ARENA_SLOTS];	/* pinned allocations */
+	uint32_t slots;		/* pinned allocations with a slot */
+	bool sealed;		/* mark is set */
+	bool released;		/* owner is gone */
 };
 
 struct block_hdr {
 	uint16_t size;		/* size in blocks for continuous allocation */
-	uint16_t used;		/* usage flags for page */
+	uint8_t used;		/* usage flags for page */
+	uint8_t owner;		/* owner slot of allocation in first block */
 } __packed;
 
 struct block_map {
@@ -98,6 +151,15 @@ struct mm {
 
 	struct mm_info total;
 	uint32_t heap_trace_updated;	/* updates that can be presented */
+
+	/* heap usage per pipeline and owner slot in use on each core */
+	struct mm_owner owner[HEAP_OWNER_COUNT];
+	uint32_t owner_slot[PLATFORM_CORE_COUNT];
+
+	/* pipeline arenas and arena of current owner on each core */
+	struct list_item arena_list;
+	struct mm_arena *arena[PLATFORM_CORE_COUNT];
+
 	spinlock_t lock;	/* all allocs and frees are atomic */
 } __aligned(PLATFORM_DCACHE_ALIGN);
 
@@ -216,4 +278,38 @@ void free_heap(int zone);
 void heap_trace_all(int force);
 void heap_trace(struct mm_heap *heap, int size);
 
+/*
+ * Copy usage of heap index in zone (RZONE_ type) and its largest contiguous
+ * free region in bytes. Returns -EINVAL if there is no such heap.
+ */
+int heap_get_info(int zone, int index, struct mm_info *info,
+		  uint32_t *max_free);
+
+/*
+ * Heap usage attribution. Allocations made on this core between
+ * heap_set_owner() and heap_clear_owner() are accounted to the pipeline.
+ */
+void heap_set_owner(uint32_t pipeline_id);
+void heap_clear_owner(void);
+
+/* copy pipeline usage for owner slot, returns -EINVAL if slot is unused */
+int heap_get_owner_info(int slot, struct mm_owner *owner);
+
+/*
+ * Pipeline arenas. While the owning pipeline is set by heap_set_owner(),
+ * runtime and buffer allocations are served from its arena when they fit.
+ * arena_alloc() allocations made before arena_seal() are expected to live
+ * as long as the pipeline, later ones are recycled once all of them are
+ * freed. The space of the first ARENA_SLOTS allocations made before the
+ * seal is reused by any later allocation that fits once they are freed.
+ * rfree() works on all arena allocations.
+ */
+struct mm_arena *arena_new(uint32_t owner, uint32_t caps, size_t bytes);
+void *arena_alloc(struct mm_arena *arena, size_t bytes);
+void arena_seal(struct mm_arena *arena);
+void arena_free(struct mm_arena *arena);
+
+/* check whether ptr is allocated from any pipeline arena */
+bool arena_contains(void *ptr);
+
 #endif
@@ -8,6 +8,7 @@
 #ifndef __INCLUDE_AUDIO_BUFFER_H__
 #define __INCLUDE_AUDIO_BUFFER_H__
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 #include <sof/lock.h>
@@ -17,6 +18,7 @@
 #include <sof/trace.h>
 #include <sof/schedule/schedule.h>
 #include <sof/cache.h>
+#include <sof/platform.h>
 #include <ipc/topology.h>
 
 struct comp_dev;
@@ -33,21 +35,45 @@ struct comp_dev;
 #define BUFF_CB_TYPE_PRODUCE	BIT(0)
 #define BUFF_CB_TYPE_CONSUME	BIT(1)
 
+#if CONFIG_BUFFER_XCORE
+/* runtime data written by one side of a cross-core buffer in own lines */
+#define BUFFER_XCORE_ALIGNED	__aligned(PLATFORM_DCACHE_ALIGN)
+#else
+#define BUFFER_XCORE_ALIGNED
+#endif
+
 /* audio component buffer - connects 2 audio components together in pipeline */
 struct comp_buffer {
 
 	/* runtime data */
 	uint32_t size;	/* runtime buffer size in bytes (period multiple) */
 	uint32_t alloc_size;	/* allocated size in bytes */
-	uint32_t avail;		/* available bytes for reading */
-	uint32_t free;		/* free bytes for writing */
-	void *w_ptr;		/* buffer write pointer */
-	void *r_ptr;		/* buffer read position */
 	void *addr;		/* buffer base address */
 	void *end_addr;		/* buffer end address */
 
+	/* producer side runtime data */
+	void *w_ptr BUFFER_XCORE_ALIGNED;	/* buffer write pointer */
+	uint32_t free;		/* free bytes for writing */
+	uint32_t produced;	/* cross-core bytes published to the sink */
+
+	/* cache maintenance, batched to once per period */
+	uint32_t cache_pending;		/* bytes before w_ptr to write back */
+	uint32_t cache_ops;		/* cache operations issued */
+	uint32_t cache_ops_sync;	/* cache_ops at the last sync */
+
+	/* consumer side runtime data */
+	void *r_ptr BUFFER_XCORE_ALIGNED;	/* buffer read position */
+	uint32_t avail;		/* available bytes for reading */
+	uint32_t consumed;	/* cross-core bytes released to the source */
+	uint32_t visible;	/* cross-core bytes invalidated for reading */
+
 	/* IPC configuration */
-	struct sof_ipc_buffer ipc_buffer;
+	struct sof_ipc_buffer ipc_buffer BUFFER_XCORE_ALIGNED;
+
+	/* connects pipelines that may run on different cores, updated
+	 * without the lock and with cache maintenance of the data region
+	 */
+	bool xcore;
 
 	/* connected components */
 	struct comp_dev *source;	/* source component */
@@ -57,6 +83,10 @@ struct comp_buffer {
 	struct list_item source_list;	/* list in comp buffers */
 	struct list_item sink_list;	/* list in comp buffers */
 
+	/* in-place processing, buffers sharing one backing store */
+	struct comp_buffer *alias_source;	/* upstream buffer we alias */
+	struct comp_buffer *alias_sink;		/* buffer aliasing us */
+
 	/* callbacks */
 	void (*cb)(void *data, uint32_t bytes);
 	void *cb_data;
@@ -113,23 +143,51 @@ struct comp_buffer {
 
 typedef void (*cache_buff_op)(struct comp_buffer *);
 
+/* buffer pool statistics */
+struct buffer_pool_stats {
+	uint32_t hits;		/* allocations served from the pool */
+	uint32_t misses;	/* allocations served from the heap */
+	uint32_t entries;	/* backing stores retained */
+	uint32_t bytes;		/* bytes retained */
+};
+
 /* pipeline buffer creation and destruction */
 struct comp_buffer *buffer_new(struct sof_ipc_buffer *desc);
 int buffer_set_size(struct comp_buffer *buffer, uint32_t size);
 void buffer_free(struct comp_buffer *buffer);
 
+/* share backing store of source with buffer for in-place processing */
+int buffer_alias(struct comp_buffer *buffer, struct comp_buffer *source);
+void buffer_unalias(struct comp_buffer *buffer);
+
+/* buffer pool init, status and release of all retained memory, flush
+ * returns the number of released bytes
+ */
+void buffer_pool_init(void);
+void buffer_pool_get_stats(struct buffer_pool_stats *stats);
+uint32_t buffer_pool_flush(void);
+
 /* called by a component after producing data into this buffer */
 void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes);
 
 /* called by a component after consuming data from this buffer */
 void comp_update_buffer_consume(struct comp_buffer *buffer, uint32_t bytes);
 
+/* write back data produced for DMA since the last sync, once per period */
+void buffer_cache_sync(struct comp_buffer *buffer);
+
+/* take data and space published by the other side of a cross-core buffer,
+ * called on the sink and on the source core respectively before copying
+ */
+void buffer_xcore_pull(struct comp_buffer *buffer);
+void buffer_xcore_reclaim(struct comp_buffer *buffer);
+
 static inline void buffer_zero(struct comp_buffer *buffer)
 {
 	tracev_buffer("buffer_zero()");
 
 	bzero(buffer->addr, buffer->size);
-	if (buffer->ipc_buffer.caps & SOF_MEM_CAPS_DMA)
+	if (buffer->ipc_buffer.caps & SOF_MEM_CAPS_DMA || buffer->xcore)
 		dcache_writeback_region(buffer->addr, buffer->size);
 }
 
@@ -194,6 +252,10 @@ static inline void buffer_reset_pos(struct comp_buffer *buffer)
 
 	/* there are no avail samples at reset */
 	buffer->avail = 0;
+	buffer->cache_pending = 0;
+	buffer->produced = 0;
+	buffer->consumed = 0;
+	buffer->visible = 0;
 
 	/* clear buffer contents */
 	buffer_zero(buffer);
@@ -220,6 +282,10 @@ static inline void buffer_init(struct comp_buffer *buffer, uint32_t size)
 	buffer->end_addr = buffer->addr + size;
 	buffer->free = size;
 	buffer->avail = 0;
+	buffer->cache_pending = 0;
+	buffer->produced = 0;
+	buffer->consumed = 0;
+	buffer->visible = 0;
 	buffer_zero(buffer);
 }
 #endif
@@ -0,0 +1,20 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2019 Intel Corporation. All rights reserved.
+ */
+
+/* Rates for coefficient sets loaded at run time. The stages of a rate pair
+ * are known while a set for it is loaded, the other conversions use the
+ * placeholder stages.
+ */
+#if SRC_SHORT
+int16_t fir_one = 16384;
+#else
+int32_t fir_one = 1073741824;
+#endif
+struct src_stage src_1_1_0_0 =  { 0, 0, 1, 1, 1, 1, 1, 0, -1, &fir_one };
+struct src_stage src_0_0_0_0 =  { 0, 0, 0, 0, 0, 0, 0, 0,  0, &fir_one };
+int src_in_fs[15] = { 8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100,
+	 48000, 50000, 64000, 88200, 96000, 176400, 192000};
+int src_out_fs[10] = { 8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100,
+	 48000, 50000};
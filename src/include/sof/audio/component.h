@@ -132,6 +132,16 @@
  */
 #define COMP_ATTR_COPY_TYPE	0	/**< Comp copy type attribute */
 #define COMP_ATTR_HOST_BUFFER	1	/**< Comp host buffer attribute */
+#define COMP_ATTR_PCM_FLAGS	2	/**< Comp PCM flags, SOF_PCM_FLAG_ */
+/** @}*/
+
+/** \name Component driver flags
+ *  @{
+ */
+/** Single source/sink stage that can run fused with adjacent stages */
+#define COMP_DRV_FUSABLE	BIT(0)
+/** Processes data in place if source and sink formats match */
+#define COMP_DRV_INPLACE	BIT(1)
 /** @}*/
 
 /** \name Trace macros
@@ -220,6 +230,7 @@ struct comp_ops {
 struct comp_driver {
 	uint32_t type;		/**< SOF_COMP_ for driver */
 	uint32_t module_id;	/**< module id */
+	uint32_t flags;		/**< COMP_DRV_ flags */
 
 	struct comp_ops ops;	/**< component operations */
 
@@ -235,10 +246,13 @@ struct comp_dev {
 	/* runtime */
 	uint16_t state;		   /**< COMP_STATE_ */
 	uint16_t is_dma_connected; /**< component is connected to DMA */
+	bool bypass;		   /**< transparent, copy only forwards data */
 	spinlock_t lock;	   /**< lock for this component */
 	uint64_t position;	   /**< component rendering position */
 	uint32_t frames;	   /**< number of frames we copy to sink */
 	struct pipeline *pipeline; /**< pipeline we belong to */
+	struct comp_dev *fuse_head; /**< first stage of our fused chain */
+	struct comp_dev *fuse_next; /**< next stage of our fused chain */
 
 	/** common runtime configuration for downstream/upstream */
 	struct sof_ipc_stream_params params;
@@ -428,6 +442,14 @@ static inline int comp_prepare(struct comp_dev *dev)
 	return 0;
 }
 
+/**
+ * Forwards data of a bypassed component from its source to its sink. The
+ * data is copied unless the sink is aliased onto the source.
+ * @param dev Component device.
+ * @return 0 if succeeded, error code otherwise.
+ */
+int comp_bypass_copy(struct comp_dev *dev);
+
 /**
  * Copy component buffers - mandatory.
  * @param dev Component device.
@@ -437,9 +459,32 @@ static inline int comp_copy(struct comp_dev *dev)
 {
 	assert(dev->drv->ops.copy);
 
+	if (dev->bypass)
+		return comp_bypass_copy(dev);
+
 	return dev->drv->ops.copy(dev);
 }
 
+/**
+ * Declares component transparent, so its copy() is skipped and data is
+ * forwarded unchanged from source to sink. Only valid for components with
+ * one source and one sink using the same frame format. Pipeline copies
+ * run atomically against component commands, so the change takes effect
+ * at the next period boundary. Set from prepare() the pipeline lets the
+ * sink share memory with the source, so bypass must then not be cleared
+ * before reset.
+ * @param dev Component device.
+ * @param bypass True to bypass the component.
+ */
+static inline void comp_set_bypass(struct comp_dev *dev, bool bypass)
+{
+	if (dev->bypass != bypass)
+		trace_comp("comp_set_bypass(), comp.id = %u bypass = %u",
+			   dev->comp.id, bypass);
+
+	dev->bypass = bypass;
+}
+
 /**
  * Component reset and free runtime resources.
  * @param dev Component device.
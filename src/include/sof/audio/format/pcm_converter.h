@@ -0,0 +1,206 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2019 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file include/sof/audio/format/pcm_converter.h
+ * \brief PCM sample format block converters
+ *
+ * Converters process a block of samples at once. Integer conversions to a
+ * narrower format round half up and saturate, conversions from float scale
+ * full range to [-1.0, 1.0), round half away from zero and saturate, NaN
+ * converts to zero. S24_4LE samples are read from the low 24 bits of the
+ * container and written sign extended.
+ */
+
+#ifndef __INCLUDE_AUDIO_FORMAT_PCM_CONVERTER_H__
+#define __INCLUDE_AUDIO_FORMAT_PCM_CONVERTER_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <config.h>
+#include <sof/audio/format.h>
+#include <ipc/stream.h>
+
+struct comp_buffer;
+
+/* Select optimized code variant. Defining PCM_CONVERTER_GENERIC to 1
+ * forces the generic one, which is useful for testing.
+ */
+#ifndef PCM_CONVERTER_GENERIC
+#if defined __XCC__
+#include <xtensa/config/core-isa.h>
+#endif
+#if defined __XCC__ && XCHAL_HAVE_HIFI3 == 1
+#define PCM_CONVERTER_GENERIC	0
+#define PCM_CONVERTER_HIFI3	1
+#define PCM_CONVERTER_SSE	0
+#elif defined __SSE2__
+#define PCM_CONVERTER_GENERIC	0
+#define PCM_CONVERTER_HIFI3	0
+#define PCM_CONVERTER_SSE	1
+#else
+#define PCM_CONVERTER_GENERIC	1
+#define PCM_CONVERTER_HIFI3	0
+#define PCM_CONVERTER_SSE	0
+#endif
+#else
+#define PCM_CONVERTER_HIFI3	0
+#define PCM_CONVERTER_SSE	0
+#endif
+
+/** \brief Converts samples from contiguous memory to contiguous memory. */
+typedef void (*pcm_converter_func)(const void *source, void *sink,
+				   uint32_t samples);
+
+/** \brief PCM converter functions map item. */
+struct pcm_func_map {
+	uint8_t source;			/**< source frame format */
+	uint8_t sink;			/**< sink frame format */
+	pcm_converter_func func;	/**< block converter */
+};
+
+/** \brief Converters between different formats for the selected arch. */
+extern const struct pcm_func_map pcm_func_map[];
+extern const size_t pcm_func_count;
+
+/**
+ * \brief Finds converter between frame formats.
+ * \param[in] source Source frame format.
+ * \param[in] sink Sink frame format.
+ * \return Converter or NULL if formats are not supported.
+ */
+const struct pcm_func_map *pcm_get_conversion(enum sof_ipc_frame source,
+					      enum sof_ipc_frame sink);
+
+/**
+ * \brief Converts samples between circular buffers.
+ * \param[in] conv Converter returned by pcm_get_conversion().
+ * \param[in] source Source buffer, read from r_ptr.
+ * \param[in] ioffset Offset from source r_ptr in samples.
+ * \param[in,out] sink Sink buffer, written from w_ptr.
+ * \param[in] ooffset Offset from sink w_ptr in samples.
+ * \param[in] samples Number of samples to convert.
+ *
+ * Pointers of the buffers are not updated.
+ */
+void pcm_convert(const struct pcm_func_map *conv, struct comp_buffer *source,
+		 uint32_t ioffset, struct comp_buffer *sink, uint32_t ooffset,
+		 uint32_t samples);
+
+/* Single sample conversions, the reference for all code variants */
+
+static inline int32_t pcm_s24_sext(int32_t x)
+{
+	return (int32_t)((uint32_t)x << 8) >> 8;
+}
+
+static inline int32_t pcm_s16_to_s24(int16_t x)
+{
+	return (int32_t)((uint32_t)(int32_t)x << 8);
+}
+
+static inline int32_t pcm_s16_to_s32(int16_t x)
+{
+	return (int32_t)((uint32_t)(int32_t)x << 16);
+}
+
+static inline int16_t pcm_s24_to_s16(int32_t x)
+{
+	return sat_int16(Q_SHIFT_RND(pcm_s24_sext(x), 23, 15));
+}
+
+static inline int32_t pcm_s24_to_s32(int32_t x)
+{
+	return (int32_t)((uint32_t)x << 8);
+}
+
+static inline int16_t pcm_s32_to_s16(int32_t x)
+{
+	return sat_int16(Q_SHIFT_RND(x, 31, 15));
+}
+
+static inline int32_t pcm_s32_to_s24(int32_t x)
+{
+	return sat_int24(Q_SHIFT_RND(x, 31, 23));
+}
+
+static inline float pcm_s16_to_float(int16_t x)
+{
+	return (float)x * (1.0f / 32768.0f);
+}
+
+static inline float pcm_s24_to_float(int32_t x)
+{
+	return (float)pcm_s24_sext(x) * (1.0f / 8388608.0f);
+}
+
+static inline float pcm_s32_to_float(int32_t x)
+{
+	return (float)x * (1.0f / 2147483648.0f);
+}
+
+/* Rounds half away from zero, y must be within int32_t range. */
+static inline int32_t pcm_float_round(float y)
+{
+	int32_t t = (int32_t)y;
+	float r = y - (float)t;
+
+	if (r >= 0.5f)
+		t++;
+	else if (r <= -0.5f)
+		t--;
+
+	return t;
+}
+
+static inline int16_t pcm_float_to_s16(float x)
+{
+	float y = x * 32768.0f;
+
+	/* NaN */
+	if (y != y)
+		return 0;
+
+	if (y >= 32768.0f)
+		return INT16_MAX;
+	if (y <= -32768.0f)
+		return INT16_MIN;
+
+	return sat_int16(pcm_float_round(y));
+}
+
+static inline int32_t pcm_float_to_s24(float x)
+{
+	float y = x * 8388608.0f;
+
+	/* NaN */
+	if (y != y)
+		return 0;
+
+	if (y >= 8388608.0f)
+		return INT24_MAXVALUE;
+	if (y <= -8388608.0f)
+		return INT24_MINVALUE;
+
+	return sat_int24(pcm_float_round(y));
+}
+
+static inline int32_t pcm_float_to_s32(float x)
+{
+	float y = x * 2147483648.0f;
+
+	/* NaN */
+	if (y != y)
+		return 0;
+
+	if (y >= 2147483648.0f)
+		return INT32_MAX;
+	if (y <= -2147483648.0f)
+		return INT32_MIN;
+
+	return pcm_float_round(y);
+}
+
+#endif /* __INCLUDE_AUDIO_FORMAT_PCM_CONVERTER_H__ */
@@ -53,6 +53,7 @@
 
 struct ipc_pipeline_dev;
 struct ipc;
+struct mm_arena;
 
 /* Pipeline status to stop execution of current path */
 #define PPL_STATUS_PATH_STOP	1
@@ -89,6 +90,9 @@ struct pipeline {
 
 	/* position update */
 	uint32_t posn_offset;		/* position update array offset*/
+
+	/* memory arena of pipeline buffers and component state */
+	struct mm_arena *arena;
 };
 
 /* static pipeline */
@@ -107,6 +111,25 @@ static inline bool pipeline_is_preload(struct pipeline *p)
 	return p->preload;
 }
 
+/* load declared by topology in thousands of cycles per second */
+static inline uint32_t pipeline_declared_kcps(struct pipeline *p)
+{
+	if (!p->ipc_pipe.period)
+		return 0;
+
+	return (uint64_t)p->ipc_pipe.period_mips * 1000 / p->ipc_pipe.period;
+}
+
+/* worst case load measured since start in thousands of cycles per second */
+static inline uint32_t pipeline_measured_kcps(struct pipeline *p)
+{
+	if (!p->ipc_pipe.period)
+		return 0;
+
+	return (uint64_t)schedule_task_cycles(&p->pipe_task) * 1000 /
+		p->ipc_pipe.period;
+}
+
 /* checks if pipeline is scheduled with timer */
 static inline bool pipeline_is_timer_driven(struct pipeline *p)
 {
@@ -146,6 +169,9 @@ void pipeline_cache(struct pipeline *p, struct comp_dev *dev, int cmd);
 /* trigger pipeline - atomic */
 int pipeline_trigger(struct pipeline *p, struct comp_dev *host_cd, int cmd);
 
+/* move a pipeline that is not running to another core */
+int pipeline_set_core(struct pipeline *p, uint32_t core);
+
 /* static pipeline creation */
 int init_static_pipeline(struct ipc *ipc);
 
@@ -60,6 +60,7 @@ struct comp_func_map {
 	/**< selector processing function */
 	void (*sel_func)(struct comp_dev *dev, struct comp_buffer *sink,
 			 struct comp_buffer *source, uint32_t frames);
+	uint32_t in_channels;	/**< input stream channels, 0 for any */
 };
 
 /** \brief Map of formats with dedicated processing functions. */
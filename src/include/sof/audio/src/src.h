@@ -8,18 +8,31 @@
 #ifndef SRC_H
 #define SRC_H
 
+#include <sof/audio/src/src_config.h>
+#include <stdint.h>
+
+/* Longest cyclic schedule of the stages */
+#define SRC_SCHED_MAX_LENGTH	1024
+
+/* Schedule steps run in one copy to catch up with late data */
+#define SRC_SCHED_MAX_STEPS	2
+
 struct src_param {
 	int fir_s1;
 	int fir_s2;
 	int out_s1;
 	int out_s2;
+	int coef_s1;
+	int coef_s2;
 	int sbuf_length;
 	int src_multich;
 	int total;
 	int blk_in;
 	int blk_out;
-	int stage1_times;
-	int stage2_times;
+	int sched_steps;
+	int sched_length;
+	int period_frames;
+	int period_fs;
 	int idx_in;
 	int idx_out;
 	int nch;
@@ -45,6 +58,15 @@ struct src_state {
 	int32_t *out_delay;
 	int32_t *fir_wp;
 	int32_t *out_rp;
+#if SRC_SSE
+	int64_t *coefs;		/* scaled coefficients of the stage */
+#endif
+};
+
+/* Stage repeats of one step in the cyclic schedule */
+struct src_sched {
+	uint16_t stage1_times;
+	uint16_t stage2_times;
 };
 
 struct polyphase_src {
@@ -53,6 +75,7 @@ struct polyphase_src {
 	struct src_stage *stage2;
 	struct src_state state1;
 	struct src_state state2;
+	struct src_sched *sched;
 };
 
 struct src_stage_prm {
@@ -106,8 +129,14 @@ void src_polyphase_stage_cir(struct src_stage_prm *s);
 
 void src_polyphase_stage_cir_s16(struct src_stage_prm *s);
 
+#if SRC_SSE
+void src_polyphase_stage_init(struct src_state *state,
+			      struct src_stage *stage, int nch,
+			      int64_t *coefs);
+#endif
+
 int src_buffer_lengths(struct src_param *p, int fs_in, int fs_out, int nch,
-		       int source_frames);
+		       int period_frames, int period_fs);
 
 int32_t src_input_rates(void);
 
@@ -23,6 +23,7 @@
 #define SRC_GENERIC	1
 #define SRC_HIFIEP	0
 #define SRC_HIFI3	0
+#define SRC_SSE		0
 #endif
 
 /* Select optimized code variant when xt-xcc compiler is used */
@@ -40,6 +41,7 @@
 #define SRC_HIFI3	1
 #define SRC_HIFIEP	0
 #endif
+#define SRC_SSE		0
 #else
 /* GCC */
 #if defined(CONFIG_LIBRARY)
@@ -47,10 +49,25 @@
 #else
 #define SRC_SHORT	1  /* Use 16 bit filter coefficients for speed */
 #endif
+#if defined(CONFIG_LIBRARY) && defined(__SSE4_1__)
+#define SRC_GENERIC	0
+#define SRC_SSE		1  /* SSE4.1 or AVX2 engine for the host */
+#else
 #define SRC_GENERIC	1
+#define SRC_SSE		0
+#endif
 #define SRC_HIFIEP	0
 #define SRC_HIFI3	0
 #endif
 #endif
 
+/* The SSE engine keeps per channel delay lines twice to read the taps
+ * without a circular wrap.
+ */
+#if SRC_SSE
+#define SRC_FIR_DELAY_COPIES	2
+#else
+#define SRC_FIR_DELAY_COPIES	1
+#endif
+
 #endif
@@ -108,6 +108,7 @@ struct comp_func_map {
 	/**< volume processing function */
 	void (*func)(struct comp_dev *dev, struct comp_buffer *sink,
 		     struct comp_buffer *source, uint32_t frames);
+	uint16_t channels;			/**< channels, 0 for any */
 };
 
 /** \brief Map of formats with dedicated processing functions. */
@@ -134,6 +135,9 @@ static inline scale_vol vol_get_processing_function(struct comp_dev *dev)
 			continue;
 		if (cd->sink_format != func_map[i].sink)
 			continue;
+		if (func_map[i].channels &&
+		    func_map[i].channels != dev->params.channels)
+			continue;
 
 		return func_map[i].func;
 	}
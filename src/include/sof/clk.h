@@ -11,6 +11,8 @@
 #include <stdint.h>
 #include <arch/timer.h>
 
+struct sof;
+
 #define CLOCK_NOTIFY_PRE	0
 #define CLOCK_NOTIFY_POST	1
 
@@ -41,4 +43,35 @@ void platform_timer_set_delta(struct timer *timer, uint64_t ns);
 
 void clock_init(void);
 
+/* clock governor defaults, loads are in per mille of the running clock */
+#define CLK_GOV_TARGET		700	/* load aimed for after scaling */
+#define CLK_GOV_HYSTERESIS	150	/* extra headroom to scale down */
+#define CLK_GOV_DOWN_DELAY	8	/* low windows before scaling down */
+#define CLK_GOV_SATURATED	950	/* load of a core missing deadlines */
+
+/* load driven clock scaling policy over an ascending frequency table */
+struct clk_gov {
+	const struct freq_table *tab;
+	uint32_t count;		/* number of frequencies */
+	uint32_t idx;		/* current frequency index */
+	uint32_t target;
+	uint32_t hysteresis;
+	uint32_t down_delay;
+	uint32_t low_windows;	/* consecutive windows allowing a lower clock */
+	uint32_t verify;	/* next window follows a transition */
+	uint32_t transitions;	/* number of frequency changes */
+	uint32_t misses;	/* saturated windows right after a transition */
+};
+
+void clk_gov_init(struct clk_gov *gov, const struct freq_table *tab,
+		  uint32_t count, uint32_t freq);
+
+/* returns frequency index for the next window given the load of the last
+ * one and the load committed by running pipelines in kcps
+ */
+uint32_t clk_gov_update(struct clk_gov *gov, uint32_t load,
+			uint32_t committed);
+
+void clock_governor_init(struct sof *sof);
+
 #endif
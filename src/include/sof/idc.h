@@ -14,6 +14,7 @@
 #ifndef __INCLUDE_IDC_H__
 #define __INCLUDE_IDC_H__
 
+#include <sof/lock.h>
 #include <sof/schedule/schedule.h>
 #include <sof/trace.h>
 #include <stdint.h>
@@ -36,6 +37,18 @@
 /** \brief IDC send non-blocking flag. */
 #define IDC_NON_BLOCKING	1
 
+/**
+ * \brief IDC send non-blocking flag, the message is dropped if an identical
+ * one is still waiting in the ring.
+ */
+#define IDC_COALESCE		2
+
+/** \brief Number of messages in flight between a pair of cores. */
+#define IDC_RING_SIZE		8
+
+/** \brief Maximum size of the payload copied along with a message. */
+#define IDC_PAYLOAD_SIZE	32
+
 /** \brief IDC send timeout in microseconds. */
 #define IDC_TIMEOUT	10000
 
@@ -79,6 +92,10 @@
 #define IDC_MSG_NOTIFY		IDC_TYPE(0x5)
 #define IDC_MSG_NOTIFY_EXT	IDC_EXTENSION(0x0)
 
+/** \brief IDC doorbell message, target drains its rings. */
+#define IDC_MSG_RING		IDC_TYPE(0x6)
+#define IDC_MSG_RING_EXT	IDC_EXTENSION(0x0)
+
 /** \brief Decodes IDC message type. */
 #define iTS(x)	(((x) >> IDC_TYPE_SHIFT) & IDC_TYPE_MASK)
 
@@ -87,6 +104,33 @@ struct idc_msg {
 	uint32_t header;	/**< header value */
 	uint32_t extension;	/**< extension value */
 	uint32_t core;		/**< core id */
+	uint32_t size;		/**< payload size */
+	void *payload;		/**< payload copied into the ring */
+	void (*cb)(void *data, int ret);	/**< run by sender when done */
+	void *cb_data;		/**< completion callback data */
+};
+
+/** \brief IDC message slot of a ring. */
+struct idc_ring_msg {
+	struct idc_msg msg;	/**< message, core is the initiator */
+	int ret;		/**< result of the target */
+	uint8_t payload[IDC_PAYLOAD_SIZE];	/**< copy of the payload */
+};
+
+/**
+ * \brief IDC messages from one core to another, in uncached shared memory.
+ *
+ * Counters are free running. The source posts at tail and reaps completions,
+ * the target claims messages at head and completes them in order.
+ */
+struct idc_ring {
+	spinlock_t lock;	/**< serialises the source and the target */
+	uint32_t tail;		/**< next message to post */
+	uint32_t head;		/**< next message to claim */
+	uint32_t done;		/**< next message to complete */
+	uint32_t reaped;	/**< next completion to reap */
+	uint32_t coalesced;	/**< messages dropped as duplicates */
+	struct idc_ring_msg msg[IDC_RING_SIZE];	/**< message slots */
 };
 
 /** \brief IDC data. */
@@ -97,4 +141,13 @@ struct idc {
 	struct task idc_task;		/**< IDC processing task */
 };
 
+int idc_cmd(struct idc_msg *msg);
+
+int idc_ring_init(void);
+int idc_ring_post(struct idc_msg *msg, uint32_t mode, uint32_t *seq);
+int idc_ring_status(int target, uint32_t seq);
+int idc_ring_pending(int source);
+int idc_ring_process(int source);
+void idc_ring_reap(int target);
+
 #endif
@@ -9,11 +9,13 @@
 #ifndef __INCLUDE_IPC_H__
 #define __INCLUDE_IPC_H__
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <sof/trace.h>
 #include <sof/dai.h>
 #include <sof/lock.h>
 #include <platform/platform.h>
+#include <ipc/stream.h>
 #include <ipc/topology.h>
 #include <sof/audio/pipeline.h>
 #include <sof/audio/component.h>
@@ -30,7 +32,7 @@ struct dai_config;
 #define trace_ipc_error(format, ...) \
 	trace_error(TRACE_CLASS_IPC, format, ##__VA_ARGS__)
 
-#define MSG_QUEUE_SIZE		12
+#define MSG_QUEUE_SIZE		8
 
 #define COMP_TYPE_COMPONENT	1
 #define COMP_TYPE_BUFFER	2
@@ -72,13 +74,42 @@ struct ipc_msg {
 	void *cb_data;
 };
 
+/*
+ * Coalescing slot for messages where only the latest one matters, like
+ * stream positions. Queueing into a pending slot overwrites its payload
+ * and keeps its place in the queue.
+ */
+struct ipc_msg_slot {
+	uint32_t header;
+	uint32_t tx_size;
+	uint8_t tx_data[sizeof(struct sof_ipc_stream_posn)];
+	uint32_t queued;	/* on slot_list waiting to be sent */
+	struct list_item list;
+};
+
 struct ipc_shared_context {
 	struct ipc_msg *dsp_msg;	/* current message to host */
 	uint32_t dsp_pending;
-	struct list_item msg_list;
+	struct list_item msg_list;	/* priority lane, sent first */
 	struct list_item empty_list;
 	struct ipc_msg message[MSG_QUEUE_SIZE];
 
+	/* per stream (posn_offset) position and xrun slots, DMA trace slot */
+	struct list_item slot_list;
+	struct ipc_msg_slot posn_slot[PLATFORM_MAX_STREAMS];
+	struct ipc_msg_slot xrun_slot[PLATFORM_MAX_STREAMS];
+	struct ipc_msg_slot trace_slot;
+	struct ipc_msg slot_msg;	/* slot being sent to host */
+
+	/* stream region sequence counts, written by the master and the
+	 * pipeline cores under the IPC lock
+	 */
+	uint32_t posn_seq[PLATFORM_MAX_STREAMS];
+
+	/* notification statistics */
+	uint32_t msg_coalesced;	/* slot payloads overwritten before sent */
+	uint32_t msg_dropped;	/* messages lost for lack of space */
+
 	struct list_item comp_list;	/* list of component devices */
 };
 
@@ -102,6 +133,9 @@ struct ipc {
 	/* context shared between cores */
 	struct ipc_shared_context *shared_ctx;
 
+	/* declared load of active pipelines per core, kcps */
+	uint32_t committed_kcps[PLATFORM_CORE_COUNT];
+
 	/* processing task */
 	struct task ipc_task;
 
@@ -140,13 +174,20 @@ void ipc_schedule_process(struct ipc *ipc);
 
 int ipc_stream_send_position(struct comp_dev *cdev,
 		struct sof_ipc_stream_posn *posn);
+void ipc_stream_publish_position(struct comp_dev *cdev,
+				 struct sof_ipc_stream_posn *posn);
 int ipc_send_comp_notification(struct comp_dev *cdev,
 			       struct sof_ipc_comp_event *event);
 int ipc_stream_send_xrun(struct comp_dev *cdev,
 	struct sof_ipc_stream_posn *posn);
 
 int ipc_queue_host_message(struct ipc *ipc, uint32_t header, void *tx_data,
-			   size_t tx_bytes, uint32_t replace);
+			   size_t tx_bytes);
+
+/* outbound queue access for platform drivers, ipc->lock held by caller */
+bool ipc_msg_pending(struct ipc *ipc);
+struct ipc_msg *ipc_msg_get_next(struct ipc *ipc);
+void ipc_msg_put(struct ipc *ipc, struct ipc_msg *msg);
 
 void ipc_platform_do_cmd(struct ipc *ipc);
 void ipc_platform_send_msg(struct ipc *ipc);
@@ -206,6 +247,18 @@ int ipc_pipeline_new(struct ipc *ipc, struct sof_ipc_pipe_new *pipeline);
 int ipc_pipeline_free(struct ipc *ipc, uint32_t comp_id);
 int ipc_pipeline_complete(struct ipc *ipc, uint32_t comp_id);
 
+/*
+ * Move a stream's pipelines that are not running to the least loaded core.
+ */
+int ipc_pipeline_rebalance(struct ipc *ipc, struct pipeline *p);
+
+/*
+ * Pipeline MCPS admission, loads in thousands of cycles per second.
+ */
+uint32_t ipc_core_committed_kcps(struct ipc *ipc, uint32_t core);
+void ipc_core_committed_update(struct ipc *ipc);
+int ipc_pipeline_admit(struct ipc *ipc, struct pipeline *p);
+
 /*
  * Pipeline component and buffer connections.
  */
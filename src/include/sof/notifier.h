@@ -18,15 +18,45 @@ struct sof;
 #define NOTIFIER_TARGET_CORE_MASK(x)	(1 << x)
 #define NOTIFIER_TARGET_CORE_ALL_MASK	0xFFFFFFFF
 
+/* events waiting for delivery on a core */
+#define NOTIFIER_QUEUE_SIZE	8
+
+/* event data copied along with queued events */
+#define NOTIFIER_DATA_SIZE	24
+
 enum notify_id {
 	NOTIFIER_ID_CPU_FREQ = 0,
 	NOTIFIER_ID_SSP_FREQ,
 	NOTIFIER_ID_KPB_CLIENT_EVT,
+	NOTIFIER_ID_COUNT,
+};
+
+/* queued event */
+struct notify_event {
+	uint32_t id;
+	uint32_t message;
+	uint32_t data_size;
+	uint64_t time;				/* queueing time */
+	uint8_t data[NOTIFIER_DATA_SIZE];
+};
+
+/* delivery statistics of a core */
+struct notify_stats {
+	uint32_t events;	/* delivered events */
+	uint32_t overflows;	/* events delivered at once, queue full */
+	uint32_t queued_max;	/* deepest queue */
+	uint64_t latency_sum;	/* ticks from queueing to delivery */
+	uint64_t latency_max;
 };
 
 struct notify {
 	spinlock_t lock;	/* notifier lock */
-	struct list_item list;	/* list of notifiers */
+	struct list_item list[NOTIFIER_ID_COUNT];	/* notifiers by id */
+	struct notify_event queue[NOTIFIER_QUEUE_SIZE];	/* pending events */
+	uint32_t head;		/* next event to deliver */
+	uint32_t tail;		/* next free queue entry */
+	uint32_t dispatching;	/* queue drained by an earlier caller */
+	struct notify_stats stats;
 };
 
 struct notify_data {
@@ -49,7 +79,8 @@ struct notify **arch_notify_get(void);
 void notifier_register(struct notifier *notifier);
 void notifier_unregister(struct notifier *notifier);
 
-void notifier_notify(void);
+int notifier_notify_remote(void *payload, uint32_t size);
+void notifier_stats_get(struct notify_stats *stats);
 void notifier_event(struct notify_data *notify_data);
 
 void init_system_notify(struct sof *sof);
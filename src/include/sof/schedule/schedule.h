@@ -83,6 +83,7 @@ struct task {
 	struct list_item irq_list;	/* list for assigned irq level */
 	const struct scheduler_ops *ops;
 	void *private;
+	uint32_t *run_max;	/* uncached longest run in timer ticks */
 };
 
 struct edf_schedule_data;
@@ -118,4 +119,51 @@ int schedule_task_cancel(struct task *task);
 
 void schedule_task_free(struct task *task);
 
+/* run task function, its execution time is accounted to the core load */
+uint64_t schedule_task_run(struct task *task);
+
+/* longest run of a task in core cycles */
+uint32_t schedule_task_cycles(struct task *task);
+
+/* close the load window of every core, called periodically */
+void schedule_load_update(void);
+
+/* busy part of the last load window of a core in per mille */
+uint32_t schedule_load_get(int core);
+
+/* level 1 interrupts accounted per core */
+#define SCHEDULE_LOAD_IRQS	32
+
+/* activities of a core over the last load window in per mille, nested
+ * runs are only accounted to the innermost activity
+ */
+struct schedule_load_stats {
+	uint32_t idle;				/* waiting for interrupts */
+	uint32_t sched[SOF_SCHEDULE_COUNT];	/* running tasks */
+	uint32_t irq;				/* all interrupt handlers */
+	uint32_t irq_top;			/* busiest level 1 interrupt */
+	uint32_t irq_top_load;
+};
+
+void schedule_load_stats_get(int core, struct schedule_load_stats *stats);
+
+/* account time spent waiting for interrupts */
+void schedule_load_idle_enter(void);
+void schedule_load_idle_exit(void);
+
+/* account time spent in a level 1 interrupt handler, the mark returned on
+ * entry is passed with the handler run time on exit
+ */
+uint32_t schedule_load_irq_enter(void);
+void schedule_load_irq_exit(int irq, uint32_t mark, uint32_t run);
+
+/* private load window of a consumer sampling at its own rate */
+struct schedule_load_window {
+	uint32_t busy;
+	uint64_t start;
+};
+
+/* busy part of a core since the previous sample in per mille */
+uint32_t schedule_load_sample(int core, struct schedule_load_window *win);
+
 #endif /* __INCLUDE_SOF_SCHEDULER_H__ */
@@ -36,6 +36,10 @@ struct sa;
 
 #define __aligned(x) __attribute__((__aligned__(x)))
 
+#ifndef __always_inline
+#define __always_inline __attribute__((always_inline))
+#endif
+
 /* count number of var args */
 #define PP_NARG(...) (sizeof((unsigned int[]){0, ##__VA_ARGS__}) \
 	/ sizeof(unsigned int) - 1)
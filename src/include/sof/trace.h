@@ -107,8 +107,8 @@ char *get_trace_class(uint32_t trace_class);
 		     has_ids, format, ...)				\
 do {									\
 	if (test_bench_trace) {						\
-		char *msg = "%s " format;				\
-		fprintf(stderr, msg, get_trace_class(comp_class),	\
+		char *__msg = "%s " format;				\
+		fprintf(stderr, __msg, get_trace_class(comp_class),	\
 			##__VA_ARGS__);					\
 		fprintf(stderr, "\n");					\
 	}								\
@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2019 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __INCLUDE_UAPI_USER_SRC_H__
+#define __INCLUDE_UAPI_USER_SRC_H__
+
+#include <stdint.h>
+
+#define SOF_SRC_COEF_MAX_SIZE 65536 /* Max size of a coefficient blob */
+
+#define SOF_SRC_COEF_MAX_SETS 8 /* A blob can define max 8 rate pairs */
+
+/*
+ * Coefficient sets for SRC firmware built without compiled in tables.
+ *
+ * The blob starts with struct sof_src_coef_config followed by num_sets
+ * struct sof_src_coef_set. Every set describes the two conversion stages
+ * of one source/sink rate pair in the same way as the struct src_stage
+ * exported by tools/tune/src. A single stage conversion has a second stage
+ * with filter_length 1 and one coefficient of value one.
+ *
+ * The coefficients of stage 1 and stage 2 follow the stage descriptions.
+ * Their width is coef_bits, 16 bits for Q1.15 or 32 bits for Q1.31, and
+ * must match the firmware build. The coefficients of each stage are padded
+ * with zeros to a multiple of 32 bits.
+ */
+
+struct sof_src_coef_stage {
+	int32_t idm;
+	int32_t odm;
+	int32_t num_of_subfilters;
+	int32_t subfilter_length;
+	int32_t filter_length;
+	int32_t blk_in;
+	int32_t blk_out;
+	int32_t halfband;
+	int32_t shift;
+
+	/* reserved */
+	uint32_t reserved;
+} __attribute__((packed));
+
+struct sof_src_coef_set {
+	uint32_t size; /* Bytes of the set including the coefficients */
+	uint32_t source_rate;
+	uint32_t sink_rate;
+
+	/* reserved */
+	uint32_t reserved[3];
+
+	struct sof_src_coef_stage stage[2];
+	int32_t coef[];
+} __attribute__((packed));
+
+struct sof_src_coef_config {
+	uint32_t size; /* Bytes of the blob */
+	uint16_t coef_bits;
+	uint16_t num_sets;
+
+	/* reserved */
+	uint32_t reserved[4];
+
+	int32_t data[];
+} __attribute__((packed));
+
+#endif /* __INCLUDE_UAPI_USER_SRC_H__ */
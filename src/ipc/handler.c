@@ -42,6 +42,7 @@
 #include <ipc/topology.h>
 #include <ipc/pm.h>
 #include <ipc/control.h>
+#include <ipc/debug.h>
 #include <sof/dma-trace.h>
 #include <sof/cpu.h>
 #include <sof/idc.h>
@@ -113,6 +114,22 @@ static inline struct sof_ipc_cmd_hdr *mailbox_validate(void)
 	/* read component values from the inbox */
 	mailbox_hostbox_read(hdr, SOF_IPC_MSG_MAX_SIZE, 0, sizeof(*hdr));
 
+	/* compound commands are read one by one by their handler */
+	if (iGS(hdr->cmd) == SOF_IPC_GLB_COMPOUND) {
+		if (hdr->size < sizeof(struct sof_ipc_compound_hdr) ||
+		    hdr->size > MAILBOX_HOSTBOX_SIZE) {
+			trace_ipc_error("ipc: compound size 0x%x", hdr->size);
+			return NULL;
+		}
+
+		mailbox_hostbox_read(hdr + 1,
+				     SOF_IPC_MSG_MAX_SIZE - sizeof(*hdr),
+				     sizeof(*hdr),
+				     sizeof(struct sof_ipc_compound_hdr) -
+				     sizeof(*hdr));
+		return hdr;
+	}
+
 	/* validate component header */
 	if (hdr->size > SOF_IPC_MSG_MAX_SIZE) {
 		trace_ipc_error("ipc: msg too big at 0x%x", hdr->size);
@@ -241,6 +258,14 @@ static int ipc_stream_pcm_params(uint32_t stream)
 	}
 	cd->params = pcm_params.params;
 
+	/* runtime PCM flags, e.g. host polling positions instead of IPC */
+	err = comp_set_attribute(cd, COMP_ATTR_PCM_FLAGS, &pcm_params.flags);
+	if (err < 0) {
+		trace_ipc_error("ipc: comp %d setting pcm flags failed %d",
+				pcm_params.comp_id, err);
+		goto error;
+	}
+
 #ifdef CONFIG_HOST_PTABLE
 
 	/*
@@ -355,6 +380,46 @@ static int ipc_stream_pcm_free(uint32_t header)
 	return pipeline_reset(pcm_dev->cd->pipeline, pcm_dev->cd);
 }
 
+/*
+ * Write position into the stream region seqlock style. Sequence count in
+ * rhdr.error is made odd before and even after the update so a host
+ * polling the region can detect and retry torn copies. Positions are written
+ * by the master core on request and by the pipeline core, the IPC lock keeps
+ * the updates of a stream apart.
+ */
+static void ipc_stream_write_posn(struct pipeline *p,
+				  struct sof_ipc_stream_posn *posn)
+{
+	uint32_t stream = p->posn_offset / sizeof(*posn);
+	size_t seq_offset = p->posn_offset +
+		offsetof(struct sof_ipc_stream_posn, rhdr.error);
+	int32_t error = posn->rhdr.error;
+	uint32_t *seq;
+	uint32_t flags;
+
+	if (stream >= PLATFORM_MAX_STREAMS) {
+		trace_ipc_error("ipc: pipe %d invalid posn_offset %u",
+				p->ipc_pipe.pipeline_id, p->posn_offset);
+		return;
+	}
+
+	spin_lock_irq(&_ipc->lock, flags);
+
+	seq = &_ipc->shared_ctx->posn_seq[stream];
+
+	(*seq)++;
+	mailbox_stream_write(seq_offset, seq, sizeof(*seq));
+
+	posn->rhdr.error = *seq;
+	mailbox_stream_write(p->posn_offset, posn, sizeof(*posn));
+	posn->rhdr.error = error;
+
+	(*seq)++;
+	mailbox_stream_write(seq_offset, seq, sizeof(*seq));
+
+	spin_unlock_irq(&_ipc->lock, flags);
+}
+
 /* get stream position */
 static int ipc_stream_position(uint32_t header)
 {
@@ -386,24 +451,187 @@ static int ipc_stream_position(uint32_t header)
 	pipeline_get_timestamp(pcm_dev->cd->pipeline, pcm_dev->cd, &posn);
 
 	/* copy positions to stream region */
-	mailbox_stream_write(pcm_dev->cd->pipeline->posn_offset,
-			     &posn, sizeof(posn));
+	ipc_stream_write_posn(pcm_dev->cd->pipeline, &posn);
 
 	return 1;
 }
 
+/* locks held by caller */
+static inline struct ipc_msg *msg_get_empty(struct ipc *ipc)
+{
+	struct ipc_msg *msg = NULL;
+
+	if (!list_is_empty(&ipc->shared_ctx->empty_list)) {
+		msg = list_first_item(&ipc->shared_ctx->empty_list,
+				      struct ipc_msg, list);
+		list_item_del(&msg->list);
+	}
+
+	return msg;
+}
+
+/* locks held by caller */
+static inline int msg_slot_update(struct ipc *ipc, struct ipc_msg_slot *slot,
+				  uint32_t header, void *tx_data,
+				  size_t tx_bytes)
+{
+	if (tx_bytes > sizeof(slot->tx_data)) {
+		ipc->shared_ctx->msg_dropped++;
+		return -EINVAL;
+	}
+
+	slot->header = header;
+	slot->tx_size = tx_bytes;
+	assert(!memcpy_s(slot->tx_data, sizeof(slot->tx_data), tx_data,
+			 tx_bytes));
+
+	/* pending slot keeps its place, host gets the latest payload */
+	if (slot->queued) {
+		ipc->shared_ctx->msg_coalesced++;
+		return 0;
+	}
+
+	slot->queued = 1;
+	list_item_append(&slot->list, &ipc->shared_ctx->slot_list);
+	ipc->shared_ctx->dsp_pending = 1;
+
+	return 0;
+}
+
+/* queue message into coalescing slot, only the latest payload is sent */
+static int ipc_queue_slot_message(struct ipc *ipc, struct ipc_msg_slot *slot,
+				  uint32_t header, void *tx_data,
+				  size_t tx_bytes)
+{
+	uint32_t flags;
+	int ret;
+
+	spin_lock_irq(&ipc->lock, flags);
+	ret = msg_slot_update(ipc, slot, header, tx_data, tx_bytes);
+	spin_unlock_irq(&ipc->lock, flags);
+
+	return ret;
+}
+
+/* position and xrun slots are indexed by the stream position offset */
+static int ipc_queue_stream_message(struct ipc *ipc, struct comp_dev *cdev,
+				    struct ipc_msg_slot *slots,
+				    struct sof_ipc_stream_posn *posn)
+{
+	uint32_t stream = cdev->pipeline->posn_offset / sizeof(*posn);
+	uint32_t flags;
+
+	if (stream >= PLATFORM_MAX_STREAMS) {
+		trace_ipc_error("ipc: comp %d invalid posn_offset %u",
+				cdev->comp.id, cdev->pipeline->posn_offset);
+		spin_lock_irq(&ipc->lock, flags);
+		ipc->shared_ctx->msg_dropped++;
+		spin_unlock_irq(&ipc->lock, flags);
+		return -EINVAL;
+	}
+
+	return ipc_queue_slot_message(ipc, &slots[stream],
+				      posn->rhdr.hdr.cmd, posn, sizeof(*posn));
+}
+
+int ipc_queue_host_message(struct ipc *ipc, uint32_t header, void *tx_data,
+			   size_t tx_bytes)
+{
+	struct ipc_msg *msg = NULL;
+	uint32_t flags;
+	int ret = 0;
+
+	spin_lock_irq(&ipc->lock, flags);
+
+	msg = msg_get_empty(ipc);
+	if (msg == NULL) {
+		trace_ipc_error("ipc: msg hdr for 0x%08x not queued", header);
+		ipc->shared_ctx->msg_dropped++;
+		ret = -EBUSY;
+		goto out;
+	}
+
+	/* prepare the message */
+	msg->header = header;
+	msg->tx_size = tx_bytes;
+
+	/* copy mailbox data to message */
+	if (tx_bytes > 0 && tx_bytes < SOF_IPC_MSG_MAX_SIZE)
+		assert(!memcpy_s(msg->tx_data, msg->tx_size, tx_data,
+				 tx_bytes));
+
+	/* now queue the message */
+	ipc->shared_ctx->dsp_pending = 1;
+	list_item_append(&msg->list, &ipc->shared_ctx->msg_list);
+
+out:
+	spin_unlock_irq(&ipc->lock, flags);
+	return ret;
+}
+
+/* locks held by caller */
+bool ipc_msg_pending(struct ipc *ipc)
+{
+	return !list_is_empty(&ipc->shared_ctx->msg_list) ||
+		!list_is_empty(&ipc->shared_ctx->slot_list);
+}
+
+/* locks held by caller, priority lane goes ahead of coalesced slots */
+struct ipc_msg *ipc_msg_get_next(struct ipc *ipc)
+{
+	struct ipc_shared_context *ctx = ipc->shared_ctx;
+	struct ipc_msg_slot *slot;
+	struct ipc_msg *msg;
+
+	if (!list_is_empty(&ctx->msg_list)) {
+		msg = list_first_item(&ctx->msg_list, struct ipc_msg, list);
+		list_item_del(&msg->list);
+		return msg;
+	}
+
+	if (list_is_empty(&ctx->slot_list))
+		return NULL;
+
+	slot = list_first_item(&ctx->slot_list, struct ipc_msg_slot, list);
+	list_item_del(&slot->list);
+	slot->queued = 0;
+
+	/* slot can be updated again as soon as the lock is dropped */
+	msg = &ctx->slot_msg;
+	msg->header = slot->header;
+	msg->tx_size = slot->tx_size;
+	assert(!memcpy_s(msg->tx_data, sizeof(msg->tx_data), slot->tx_data,
+			 slot->tx_size));
+
+	return msg;
+}
+
+/* locks held by caller */
+void ipc_msg_put(struct ipc *ipc, struct ipc_msg *msg)
+{
+	if (msg != &ipc->shared_ctx->slot_msg)
+		list_item_append(&msg->list, &ipc->shared_ctx->empty_list);
+}
+
 /* send stream position */
 int ipc_stream_send_position(struct comp_dev *cdev,
 	struct sof_ipc_stream_posn *posn)
+{
+	ipc_stream_publish_position(cdev, posn);
+	return ipc_queue_stream_message(_ipc, cdev, _ipc->shared_ctx->posn_slot,
+					posn);
+}
+
+/* update stream position for host polling, no IPC is sent */
+void ipc_stream_publish_position(struct comp_dev *cdev,
+				 struct sof_ipc_stream_posn *posn)
 {
 	posn->rhdr.hdr.cmd = SOF_IPC_GLB_STREAM_MSG | SOF_IPC_STREAM_POSITION |
 		cdev->comp.id;
 	posn->rhdr.hdr.size = sizeof(*posn);
 	posn->comp_id = cdev->comp.id;
 
-	mailbox_stream_write(cdev->pipeline->posn_offset, posn, sizeof(*posn));
-	return ipc_queue_host_message(_ipc, posn->rhdr.hdr.cmd, posn,
-				      sizeof(*posn), 0);
+	ipc_stream_write_posn(cdev->pipeline, posn);
 }
 
 /* send component notification */
@@ -417,7 +645,7 @@ int ipc_send_comp_notification(struct comp_dev *cdev,
 	event->src_comp_id = cdev->comp.id;
 
 	return ipc_queue_host_message(_ipc, event->rhdr.hdr.cmd, event,
-				      sizeof(*event), 0);
+				      sizeof(*event));
 }
 
 /* send stream position TODO: send compound message  */
@@ -430,9 +658,9 @@ int ipc_stream_send_xrun(struct comp_dev *cdev,
 	posn->rhdr.hdr.size = sizeof(*posn);
 	posn->comp_id = cdev->comp.id;
 
-	mailbox_stream_write(cdev->pipeline->posn_offset, posn, sizeof(*posn));
-	return ipc_queue_host_message(_ipc, posn->rhdr.hdr.cmd, posn,
-				      sizeof(*posn), 0);
+	ipc_stream_write_posn(cdev->pipeline, posn);
+	return ipc_queue_stream_message(_ipc, cdev, _ipc->shared_ctx->xrun_slot,
+					posn);
 }
 
 static int ipc_stream_trigger(uint32_t header)
@@ -476,6 +704,24 @@ static int ipc_stream_trigger(uint32_t header)
 		return -ENODEV;
 	}
 
+#if CONFIG_PIPELINE_PLACEMENT
+	/* streams are moved off overloaded cores only when starting */
+	if (cmd == COMP_TRIGGER_START) {
+		ret = ipc_pipeline_rebalance(_ipc, pcm_dev->cd->pipeline);
+		if (ret < 0)
+			return ret;
+	}
+#endif
+
+#if CONFIG_PIPELINE_MCPS_BUDGET
+	/* streams only start if their core can take the declared load */
+	if (cmd == COMP_TRIGGER_START) {
+		ret = ipc_pipeline_admit(_ipc, pcm_dev->cd->pipeline);
+		if (ret < 0)
+			return ret;
+	}
+#endif
+
 	/* trigger the component */
 	ret = pipeline_trigger(pcm_dev->cd->pipeline, pcm_dev->cd, cmd);
 	if (ret < 0) {
@@ -483,6 +729,9 @@ static int ipc_stream_trigger(uint32_t header)
 				stream.comp_id, ipc_cmd, ret);
 	}
 
+	/* some pipelines may have changed state even if trigger failed */
+	ipc_core_committed_update(_ipc);
+
 	return ret;
 }
 
@@ -747,8 +996,8 @@ int ipc_dma_trace_send_position(void)
 	posn.messages = _ipc->dmat->messages;
 	posn.rhdr.hdr.size = sizeof(posn);
 
-	return ipc_queue_host_message(_ipc, posn.rhdr.hdr.cmd, &posn,
-				      sizeof(posn), 1);
+	return ipc_queue_slot_message(_ipc, &_ipc->shared_ctx->trace_slot,
+				      posn.rhdr.hdr.cmd, &posn, sizeof(posn));
 }
 
 static int ipc_glb_debug_message(uint32_t header)
@@ -793,6 +1042,230 @@ static int ipc_glb_gdb_debug(uint32_t header)
 
 }
 
+/*
+ * Debug status IPC Operations.
+ */
+
+/* append heap usage of all heaps in zone, returns bytes appended */
+static int ipc_mem_usage_heaps(void *data, int space, int zone,
+			       uint32_t ipc_zone, uint32_t *num_heaps)
+{
+	struct sof_ipc_dbg_heap_usage *elem = data;
+	struct mm_info info;
+	uint32_t max_free;
+	int size = 0;
+	int i;
+
+	for (i = 0; heap_get_info(zone, i, &info, &max_free) == 0; i++) {
+		if (size + sizeof(*elem) > space)
+			break;
+
+		elem->zone = ipc_zone;
+		elem->id = i;
+		elem->used = info.used;
+		elem->free = info.free;
+		elem->peak = info.peak;
+		elem->allocs = info.allocs;
+		elem->max_free = max_free;
+
+		(*num_heaps)++;
+		size += sizeof(*elem);
+		elem++;
+	}
+
+	return size;
+}
+
+static int ipc_debug_mem_usage(uint32_t header)
+{
+	struct sof_ipc_dbg_mem_usage *usage = _ipc->comp_data;
+	struct sof_ipc_dbg_pipe_usage *pipe;
+	struct buffer_pool_stats pool;
+	struct mm_owner owner;
+	int space = MIN(MAILBOX_HOSTBOX_SIZE, SOF_IPC_MSG_MAX_SIZE);
+	int size = sizeof(*usage);
+	uint32_t flags;
+	int i;
+
+	trace_ipc("ipc: debug -> mem usage");
+
+	bzero(usage, sizeof(*usage));
+
+	buffer_pool_get_stats(&pool);
+	usage->pool_hits = pool.hits;
+	usage->pool_misses = pool.misses;
+	usage->pool_bytes = pool.bytes;
+
+	spin_lock_irq(&_ipc->lock, flags);
+	usage->msg_coalesced = _ipc->shared_ctx->msg_coalesced;
+	usage->msg_dropped = _ipc->shared_ctx->msg_dropped;
+	spin_unlock_irq(&_ipc->lock, flags);
+
+	/* busiest heaps first, lists are truncated to fit the mailbox */
+	size += ipc_mem_usage_heaps((void *)usage + size, space - size,
+				    RZONE_RUNTIME, SOF_IPC_MEM_ZONE_RUNTIME,
+				    &usage->num_heaps);
+	size += ipc_mem_usage_heaps((void *)usage + size, space - size,
+				    RZONE_BUFFER, SOF_IPC_MEM_ZONE_BUFFER,
+				    &usage->num_heaps);
+	size += ipc_mem_usage_heaps((void *)usage + size, space - size,
+				    RZONE_SYS_RUNTIME,
+				    SOF_IPC_MEM_ZONE_SYS_RUNTIME,
+				    &usage->num_heaps);
+	size += ipc_mem_usage_heaps((void *)usage + size, space - size,
+				    RZONE_SYS, SOF_IPC_MEM_ZONE_SYS,
+				    &usage->num_heaps);
+
+	for (i = 0; i < HEAP_OWNER_COUNT; i++) {
+		if (size + sizeof(*pipe) > space)
+			break;
+
+		if (heap_get_owner_info(i, &owner) < 0)
+			continue;
+
+		pipe = (void *)usage + size;
+		pipe->pipeline_id = owner.id;
+		pipe->used = owner.used;
+		pipe->peak = owner.peak;
+		pipe->allocs = owner.allocs;
+
+		usage->num_pipes++;
+		size += sizeof(*pipe);
+	}
+
+	usage->rhdr.hdr.cmd = header;
+	usage->rhdr.hdr.size = size;
+	usage->rhdr.error = 0;
+	mailbox_hostbox_write(0, usage, size);
+
+	return 1;
+}
+
+static int ipc_debug_mcps_usage(uint32_t header)
+{
+	struct sof_ipc_dbg_mcps_usage *usage = _ipc->comp_data;
+	struct sof_ipc_dbg_core_mcps *core;
+	struct sof_ipc_dbg_pipe_mcps *pipe;
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	int space = MIN(MAILBOX_HOSTBOX_SIZE, SOF_IPC_MSG_MAX_SIZE);
+	int size = sizeof(*usage);
+	int i;
+
+	trace_ipc("ipc: debug -> mcps usage");
+
+	bzero(usage, sizeof(*usage));
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (size + sizeof(*core) > space)
+			break;
+
+		if (!cpu_is_core_enabled(i))
+			continue;
+
+		core = (void *)usage + size;
+		core->core = i;
+		core->budget = CONFIG_PIPELINE_MCPS_BUDGET * 1000;
+		core->committed = ipc_core_committed_kcps(_ipc, i);
+		core->load = schedule_load_get(i);
+
+		usage->num_cores++;
+		size += sizeof(*core);
+	}
+
+	list_for_item(clist, &_ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_PIPELINE)
+			continue;
+
+		if (size + sizeof(*pipe) > space)
+			break;
+
+		pipe = (void *)usage + size;
+		pipe->pipeline_id = icd->pipeline->ipc_pipe.pipeline_id;
+		pipe->core = icd->pipeline->ipc_pipe.core;
+		pipe->declared = pipeline_declared_kcps(icd->pipeline);
+		pipe->measured = pipeline_measured_kcps(icd->pipeline);
+
+		/* topology underestimates the pipeline */
+		if (pipe->declared && pipe->measured > pipe->declared)
+			trace_ipc_error("ipc: pipeline %u measured %u kcps, "
+					"declared %u", pipe->pipeline_id,
+					pipe->measured, pipe->declared);
+
+		usage->num_pipes++;
+		size += sizeof(*pipe);
+	}
+
+	usage->rhdr.hdr.cmd = header;
+	usage->rhdr.hdr.size = size;
+	usage->rhdr.error = 0;
+	mailbox_hostbox_write(0, usage, size);
+
+	return 1;
+}
+
+static int ipc_debug_load_usage(uint32_t header)
+{
+	struct sof_ipc_dbg_load_usage *usage = _ipc->comp_data;
+	struct sof_ipc_dbg_core_load *core;
+	struct schedule_load_stats stats;
+	int space = MIN(MAILBOX_HOSTBOX_SIZE, SOF_IPC_MSG_MAX_SIZE);
+	int size = sizeof(*usage);
+	int i;
+
+	trace_ipc("ipc: debug -> load usage");
+
+	bzero(usage, sizeof(*usage));
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (size + sizeof(*core) > space)
+			break;
+
+		if (!cpu_is_core_enabled(i))
+			continue;
+
+		schedule_load_stats_get(i, &stats);
+
+		core = (void *)usage + size;
+		core->core = i;
+		core->busy = schedule_load_get(i);
+		core->idle = stats.idle;
+		core->ll = stats.sched[SOF_SCHEDULE_LL];
+		core->edf = stats.sched[SOF_SCHEDULE_EDF];
+		core->irq = stats.irq;
+		core->irq_top = stats.irq_top;
+		core->irq_top_load = stats.irq_top_load;
+
+		usage->num_cores++;
+		size += sizeof(*core);
+	}
+
+	usage->rhdr.hdr.cmd = header;
+	usage->rhdr.hdr.size = size;
+	usage->rhdr.error = 0;
+	mailbox_hostbox_write(0, usage, size);
+
+	return 1;
+}
+
+static int ipc_glb_debug_status_message(uint32_t header)
+{
+	uint32_t cmd = iCS(header);
+
+	switch (cmd) {
+	case SOF_IPC_DEBUG_MEM_USAGE:
+		return ipc_debug_mem_usage(header);
+	case SOF_IPC_DEBUG_MCPS_USAGE:
+		return ipc_debug_mcps_usage(header);
+	case SOF_IPC_DEBUG_LOAD_USAGE:
+		return ipc_debug_load_usage(header);
+	default:
+		trace_ipc_error("ipc: unknown debug status cmd 0x%x", cmd);
+		return -EINVAL;
+	}
+}
+
 /*
  * Topology IPC Operations.
  */
@@ -800,21 +1273,17 @@ static int ipc_glb_gdb_debug(uint32_t header)
 static int ipc_comp_cmd(struct comp_dev *dev, int cmd,
 			struct sof_ipc_ctrl_data *data, int size)
 {
-	struct idc_msg comp_cmd_msg;
-
 	/* pipeline running on other core */
 	if (dev->pipeline && dev->pipeline->status == COMP_STATE_ACTIVE &&
 	    cpu_get_id() != dev->pipeline->ipc_pipe.core) {
+		struct idc_msg comp_cmd_msg = { IDC_MSG_COMP_CMD,
+			IDC_MSG_COMP_CMD_EXT(cmd),
+			dev->pipeline->ipc_pipe.core };
 
 		/* check if requested core is enabled */
 		if (!cpu_is_core_enabled(dev->pipeline->ipc_pipe.core))
 			return -EINVAL;
 
-		/* build IDC message */
-		comp_cmd_msg.header = IDC_MSG_COMP_CMD;
-		comp_cmd_msg.extension = IDC_MSG_COMP_CMD_EXT(cmd);
-		comp_cmd_msg.core = dev->pipeline->ipc_pipe.core;
-
 		/* send IDC component command message */
 		return idc_send_msg(&comp_cmd_msg, IDC_BLOCKING);
 	} else {
@@ -1046,6 +1515,171 @@ static int ipc_glb_tplg_message(uint32_t header)
 	}
 }
 
+/* object created by a compound message, freed again on rollback */
+struct ipc_compound_undo {
+	uint32_t id;
+	int (*free_func)(struct ipc *ipc, uint32_t id);
+};
+
+/* apply one topology command of a compound message, locks not held */
+static int ipc_compound_tplg_cmd(struct sof_ipc_cmd_hdr *hdr,
+				 struct ipc_compound_undo *undo)
+{
+	struct sof_ipc_pipe_comp_connect connect;
+	struct sof_ipc_pipe_ready ready;
+	struct sof_ipc_comp *comp;
+	struct sof_ipc_buffer *buffer;
+	struct sof_ipc_pipe_new *pipe;
+	int ret;
+
+	if (iGS(hdr->cmd) != SOF_IPC_GLB_TPLG_MSG)
+		return -EINVAL;
+
+	undo->free_func = NULL;
+
+	switch (iCS(hdr->cmd)) {
+	case SOF_IPC_TPLG_COMP_NEW:
+		comp = (struct sof_ipc_comp *)hdr;
+		ret = ipc_comp_new(_ipc, comp);
+		undo->id = comp->id;
+		undo->free_func = ipc_comp_free;
+		break;
+	case SOF_IPC_TPLG_BUFFER_NEW:
+		buffer = (struct sof_ipc_buffer *)hdr;
+		ret = ipc_buffer_new(_ipc, buffer);
+		undo->id = buffer->comp.id;
+		undo->free_func = ipc_buffer_free;
+		break;
+	case SOF_IPC_TPLG_PIPE_NEW:
+		pipe = (struct sof_ipc_pipe_new *)hdr;
+		ret = ipc_pipeline_new(_ipc, pipe);
+		undo->id = pipe->comp_id;
+		undo->free_func = ipc_pipeline_free;
+		break;
+	case SOF_IPC_TPLG_COMP_CONNECT:
+		IPC_COPY_CMD(connect, hdr);
+		ret = ipc_comp_connect(_ipc, &connect);
+		break;
+	case SOF_IPC_TPLG_PIPE_COMPLETE:
+		IPC_COPY_CMD(ready, hdr);
+		ret = ipc_pipeline_complete(_ipc, ready.comp_id);
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	/* nothing to undo for a failed command */
+	if (ret < 0)
+		undo->free_func = NULL;
+
+	return ret;
+}
+
+/*
+ * Apply a compound message, see struct sof_ipc_compound_hdr. Commands are
+ * copied one at a time from the host mailbox into comp_data and handled
+ * like standalone IPCs, a single reply is sent for all of them.
+ */
+static int ipc_glb_compound_message(uint32_t header)
+{
+	struct sof_ipc_compound_hdr compound;
+	struct sof_ipc_compound_hdr block;
+	struct sof_ipc_compound_reply reply;
+	struct sof_ipc_cmd_hdr *hdr = _ipc->comp_data;
+	struct ipc_compound_undo *undo;
+	size_t offset = sizeof(compound);
+	uint32_t block_cmds = 0;
+	uint32_t done = 0;
+	uint32_t applied = 0;
+	int ret = 0;
+
+	/* copy message with ABI safe method */
+	IPC_COPY_CMD(compound, _ipc->comp_data);
+
+	trace_ipc("ipc: compound -> %d cmds", compound.count);
+
+	/* every command takes at least its header, count comes from the host
+	 * and must not overflow the undo list size
+	 */
+	if (!compound.count || compound.count >
+	    (compound.hdr.size - sizeof(compound)) /
+	    sizeof(struct sof_ipc_cmd_hdr)) {
+		trace_ipc_error("ipc: compound count %u invalid",
+				compound.count);
+		return -EINVAL;
+	}
+
+	undo = rzalloc(RZONE_RUNTIME, SOF_MEM_CAPS_RAM,
+		       sizeof(*undo) * compound.count);
+	if (!undo)
+		return -ENOMEM;
+
+	while (applied < compound.count) {
+		/* next block header */
+		if (!block_cmds) {
+			if (offset + sizeof(block) > compound.hdr.size) {
+				ret = -EINVAL;
+				break;
+			}
+
+			mailbox_hostbox_read(&block, sizeof(block), offset,
+					     sizeof(block));
+			offset += sizeof(block);
+			block_cmds = block.count;
+
+			/* end of sequence */
+			if (!block_cmds)
+				break;
+		}
+
+		mailbox_hostbox_read(hdr, SOF_IPC_MSG_MAX_SIZE, offset,
+				     sizeof(*hdr));
+		if (hdr->cmd != block.hdr.cmd ||
+		    hdr->size < sizeof(*hdr) ||
+		    hdr->size > SOF_IPC_MSG_MAX_SIZE ||
+		    offset + hdr->size > compound.hdr.size) {
+			ret = -EINVAL;
+			break;
+		}
+
+		mailbox_hostbox_read(hdr + 1,
+				     SOF_IPC_MSG_MAX_SIZE - sizeof(*hdr),
+				     offset + sizeof(*hdr),
+				     hdr->size - sizeof(*hdr));
+
+		ret = ipc_compound_tplg_cmd(hdr, &undo[done]);
+		if (ret < 0)
+			break;
+
+		if (undo[done].free_func)
+			done++;
+
+		offset += hdr->size;
+		block_cmds--;
+		applied++;
+	}
+
+	/* free objects in reverse order, buffers unlink their connections */
+	if (ret < 0) {
+		trace_ipc_error("ipc: compound cmd %d 0x%x failed %d",
+				applied, hdr->cmd, ret);
+
+		while (done--)
+			undo[done].free_func(_ipc, undo[done].id);
+	}
+
+	rfree(undo);
+
+	/* write result to the outbox */
+	reply.rhdr.hdr.size = sizeof(reply);
+	reply.rhdr.hdr.cmd = header;
+	reply.rhdr.error = ret < 0 ? ret : 0;
+	reply.count = applied;
+	mailbox_hostbox_write(0, &reply, sizeof(reply));
+	return 1;
+}
+
 #ifdef CONFIG_DEBUG
 static int ipc_glb_test_message(uint32_t header)
 {
@@ -1082,7 +1716,7 @@ int ipc_cmd(void)
 	case SOF_IPC_GLB_REPLY:
 		return 0;
 	case SOF_IPC_GLB_COMPOUND:
-		return -EINVAL;	/* TODO */
+		return ipc_glb_compound_message(hdr->cmd);
 	case SOF_IPC_GLB_TPLG_MSG:
 		return ipc_glb_tplg_message(hdr->cmd);
 	case SOF_IPC_GLB_PM_MSG:
@@ -1097,6 +1731,8 @@ int ipc_cmd(void)
 		return ipc_glb_debug_message(hdr->cmd);
 	case SOF_IPC_GLB_GDB_DEBUG:
 		return ipc_glb_gdb_debug(hdr->cmd);
+	case SOF_IPC_GLB_DEBUG:
+		return ipc_glb_debug_status_message(hdr->cmd);
 #ifdef CONFIG_DEBUG
 	case SOF_IPC_GLB_TEST:
 		return ipc_glb_test_message(hdr->cmd);
@@ -1107,148 +1743,6 @@ int ipc_cmd(void)
 	}
 }
 
-/* locks held by caller */
-static inline struct ipc_msg *msg_get_empty(struct ipc *ipc)
-{
-	struct ipc_msg *msg = NULL;
-
-	if (!list_is_empty(&ipc->shared_ctx->empty_list)) {
-		msg = list_first_item(&ipc->shared_ctx->empty_list,
-				      struct ipc_msg, list);
-		list_item_del(&msg->list);
-	}
-
-	return msg;
-}
-
-static inline struct ipc_msg *ipc_glb_stream_message_find(struct ipc *ipc,
-	struct sof_ipc_stream_posn *posn)
-{
-	struct list_item *plist;
-	struct ipc_msg *msg = NULL;
-	struct sof_ipc_stream_posn *old_posn = NULL;
-	uint32_t cmd;
-
-	/* Check whether the command is expected */
-	cmd = iCS(posn->rhdr.hdr.cmd);
-
-	switch (cmd) {
-	case SOF_IPC_STREAM_TRIG_XRUN:
-	case SOF_IPC_STREAM_POSITION:
-
-		/* iterate host message list for searching */
-		list_for_item(plist, &ipc->shared_ctx->msg_list) {
-			msg = container_of(plist, struct ipc_msg, list);
-			if (msg->header == posn->rhdr.hdr.cmd) {
-				old_posn = (struct sof_ipc_stream_posn *)
-					   msg->tx_data;
-				if (old_posn->comp_id == posn->comp_id)
-					return msg;
-			}
-		}
-		break;
-	default:
-		break;
-	}
-
-	/* no match */
-	return NULL;
-}
-
-static inline struct ipc_msg *ipc_glb_trace_message_find(struct ipc *ipc,
-	struct sof_ipc_dma_trace_posn *posn)
-{
-	struct list_item *plist;
-	struct ipc_msg *msg = NULL;
-	uint32_t cmd;
-
-	/* Check whether the command is expected */
-	cmd = iCS(posn->rhdr.hdr.cmd);
-
-	switch (cmd) {
-	case SOF_IPC_TRACE_DMA_POSITION:
-		/* iterate host message list for searching */
-		list_for_item(plist, &ipc->shared_ctx->msg_list) {
-			msg = container_of(plist, struct ipc_msg, list);
-			if (msg->header == posn->rhdr.hdr.cmd)
-				return msg;
-		}
-		break;
-	default:
-		break;
-	}
-
-	/* no match */
-	return NULL;
-}
-
-static inline struct ipc_msg *msg_find(struct ipc *ipc, uint32_t header,
-	void *tx_data)
-{
-	uint32_t type;
-
-	/* use different sub function for different global message type */
-	type = iGS(header);
-
-	switch (type) {
-	case SOF_IPC_GLB_STREAM_MSG:
-		return ipc_glb_stream_message_find(ipc,
-			(struct sof_ipc_stream_posn *)tx_data);
-	case SOF_IPC_GLB_TRACE_MSG:
-		return ipc_glb_trace_message_find(ipc,
-			(struct sof_ipc_dma_trace_posn *)tx_data);
-	default:
-		/* not found */
-		return NULL;
-	}
-}
-
-int ipc_queue_host_message(struct ipc *ipc, uint32_t header, void *tx_data,
-			   size_t tx_bytes, uint32_t replace)
-{
-	struct ipc_msg *msg = NULL;
-	uint32_t flags, found = 0;
-	int ret = 0;
-
-	spin_lock_irq(&ipc->lock, flags);
-
-	/* do we need to replace an existing message? */
-	if (replace)
-		msg = msg_find(ipc, header, tx_data);
-
-	/* do we need to use a new empty message? */
-	if (msg)
-		found = 1;
-	else
-		msg = msg_get_empty(ipc);
-
-	if (msg == NULL) {
-		trace_ipc_error("ipc: msg hdr for 0x%08x not found "
-				"replace %d", header, replace);
-		ret = -EBUSY;
-		goto out;
-	}
-
-	/* prepare the message */
-	msg->header = header;
-	msg->tx_size = tx_bytes;
-
-	/* copy mailbox data to message */
-	if (tx_bytes > 0 && tx_bytes < SOF_IPC_MSG_MAX_SIZE)
-		assert(!memcpy_s(msg->tx_data, msg->tx_size, tx_data,
-				 tx_bytes));
-
-	if (!found) {
-		/* now queue the message */
-		ipc->shared_ctx->dsp_pending = 1;
-		list_item_append(&msg->list, &ipc->shared_ctx->msg_list);
-	}
-
-out:
-	spin_unlock_irq(&ipc->lock, flags);
-	return ret;
-}
-
 /* process current message */
 int ipc_process_msg_queue(void)
 {
@@ -19,6 +19,8 @@
 #include <sof/audio/component.h>
 #include <sof/audio/pipeline.h>
 #include <sof/audio/buffer.h>
+#include <sof/cpu.h>
+#include <sof/schedule/schedule.h>
 
 /* Returns pipeline source component */
 #define ipc_get_ppl_src_comp(ipc, ppl_id) \
@@ -132,8 +134,10 @@ int ipc_comp_new(struct ipc *ipc, struct sof_ipc_comp *comp)
 		return -EINVAL;
 	}
 
-	/* create component */
+	/* create component, its state is accounted to the pipeline */
+	heap_set_owner(comp->pipeline_id);
 	cd = comp_new(comp);
+	heap_clear_owner();
 	if (cd == NULL) {
 		trace_ipc_error("ipc_comp_new() error: component cd = NULL");
 		return -EINVAL;
@@ -188,7 +192,9 @@ int ipc_buffer_new(struct ipc *ipc, struct sof_ipc_buffer *desc)
 	}
 
 	/* register buffer with pipeline */
+	heap_set_owner(desc->comp.pipeline_id);
 	buffer = buffer_new(desc);
+	heap_clear_owner();
 	if (buffer == NULL) {
 		trace_ipc_error("ipc_buffer_new() error: buffer_new() failed");
 		rfree(ibd);
@@ -268,6 +274,184 @@ int ipc_comp_connect(struct ipc *ipc,
 }
 
 
+#if CONFIG_PIPELINE_PLACEMENT
+/* number of pipelines running on the core */
+static uint32_t ipc_core_pipelines(struct ipc *ipc, uint32_t core)
+{
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	uint32_t count = 0;
+
+	list_for_item(clist, &ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type == COMP_TYPE_PIPELINE &&
+		    icd->pipeline->ipc_pipe.core == core)
+			count++;
+	}
+
+	return count;
+}
+
+/* Least loaded enabled core. Loads closer than the placement margin are
+ * treated as equal and the core with fewer pipelines wins then.
+ */
+static uint32_t ipc_pipeline_place(struct ipc *ipc)
+{
+	uint32_t best = PLATFORM_MASTER_CORE_ID;
+	uint32_t best_load = schedule_load_get(best);
+	uint32_t best_pipes = ipc_core_pipelines(ipc, best);
+	uint32_t load;
+	uint32_t pipes;
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (i == PLATFORM_MASTER_CORE_ID || !cpu_is_core_enabled(i))
+			continue;
+
+		load = schedule_load_get(i);
+		pipes = ipc_core_pipelines(ipc, i);
+
+		if (load + CONFIG_PIPELINE_PLACEMENT_MARGIN <= best_load ||
+		    (load < best_load + CONFIG_PIPELINE_PLACEMENT_MARGIN &&
+		     pipes < best_pipes)) {
+			best = i;
+			best_load = load;
+			best_pipes = pipes;
+		}
+	}
+
+	return best;
+}
+
+#if CONFIG_BUFFER_XCORE
+/* buffer between a pipeline scheduled by sched and a running pipeline
+ * scheduled by another component, its mode cannot change while in use
+ */
+static bool ipc_buffer_links_active(struct comp_buffer *buffer,
+				    struct comp_dev *sched)
+{
+	struct pipeline *source = buffer->source ?
+		buffer->source->pipeline : NULL;
+	struct pipeline *sink = buffer->sink ? buffer->sink->pipeline : NULL;
+
+	if (!source || !sink)
+		return false;
+
+	if (source->sched_comp == sched && sink->sched_comp != sched)
+		return sink->status == COMP_STATE_ACTIVE;
+
+	if (sink->sched_comp == sched && source->sched_comp != sched)
+		return source->status == COMP_STATE_ACTIVE;
+
+	return false;
+}
+#endif
+
+int ipc_pipeline_rebalance(struct ipc *ipc, struct pipeline *p)
+{
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	uint32_t core = ipc_pipeline_place(ipc);
+	int ret;
+
+	if (core == p->ipc_pipe.core ||
+	    schedule_load_get(p->ipc_pipe.core) <=
+	    schedule_load_get(core) + CONFIG_PIPELINE_PLACEMENT_MARGIN)
+		return 0;
+
+	/* pipelines scheduled together can only move together */
+	list_for_item(clist, &ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type == COMP_TYPE_PIPELINE &&
+		    icd->pipeline->sched_comp == p->sched_comp &&
+		    icd->pipeline->status == COMP_STATE_ACTIVE)
+			return 0;
+
+#if CONFIG_BUFFER_XCORE
+		if (icd->type == COMP_TYPE_BUFFER &&
+		    ipc_buffer_links_active(icd->cb, p->sched_comp))
+			return 0;
+#endif
+	}
+
+	list_for_item(clist, &ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_PIPELINE ||
+		    icd->pipeline->sched_comp != p->sched_comp)
+			continue;
+
+		ret = pipeline_set_core(icd->pipeline, core);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+#endif
+
+/* safe to call from any context, component list is not accessed */
+uint32_t ipc_core_committed_kcps(struct ipc *ipc, uint32_t core)
+{
+	uint32_t kcps;
+	uint32_t flags;
+
+	spin_lock_irq(&ipc->lock, flags);
+	kcps = ipc->committed_kcps[core];
+	spin_unlock_irq(&ipc->lock, flags);
+
+	return kcps;
+}
+
+/* recount declared load of active pipelines after a trigger, IPC task only */
+void ipc_core_committed_update(struct ipc *ipc)
+{
+	uint32_t kcps[PLATFORM_CORE_COUNT] = { 0 };
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	uint32_t flags;
+	int i;
+
+	list_for_item(clist, &ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type == COMP_TYPE_PIPELINE &&
+		    icd->pipeline->status == COMP_STATE_ACTIVE)
+			kcps[icd->pipeline->ipc_pipe.core] +=
+				pipeline_declared_kcps(icd->pipeline);
+	}
+
+	spin_lock_irq(&ipc->lock, flags);
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++)
+		ipc->committed_kcps[i] = kcps[i];
+	spin_unlock_irq(&ipc->lock, flags);
+}
+
+#if CONFIG_PIPELINE_MCPS_BUDGET
+int ipc_pipeline_admit(struct ipc *ipc, struct pipeline *p)
+{
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	uint32_t kcps = ipc_core_committed_kcps(ipc, p->ipc_pipe.core);
+
+	/* add pipelines of the stream that are not running yet */
+	list_for_item(clist, &ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type == COMP_TYPE_PIPELINE &&
+		    icd->pipeline->sched_comp == p->sched_comp &&
+		    icd->pipeline->status != COMP_STATE_ACTIVE)
+			kcps += pipeline_declared_kcps(icd->pipeline);
+	}
+
+	if (kcps > CONFIG_PIPELINE_MCPS_BUDGET * 1000) {
+		trace_ipc_error("ipc_pipeline_admit() error: core %u over "
+				"budget, %u kcps needed", p->ipc_pipe.core,
+				kcps);
+		return -EBUSY;
+	}
+
+	return 0;
+}
+#endif
+
 int ipc_pipeline_new(struct ipc *ipc,
 	struct sof_ipc_pipe_new *pipe_desc)
 {
@@ -298,14 +482,39 @@ int ipc_pipeline_new(struct ipc *ipc,
 		return -EINVAL;
 	}
 
+#if CONFIG_PIPELINE_PLACEMENT
+	/* keep pipelines sharing a scheduling component on one core */
+	if (icd->cd->pipeline)
+		pipe_desc->core = icd->cd->pipeline->ipc_pipe.core;
+	else
+		pipe_desc->core = ipc_pipeline_place(ipc);
+
+	trace_ipc("ipc_pipeline_new() pipeline %u placed on core %u",
+		  pipe_desc->pipeline_id, pipe_desc->core);
+#endif
+
 	/* create the pipeline */
+	heap_set_owner(pipe_desc->pipeline_id);
 	pipe = pipeline_new(pipe_desc, icd->cd);
+	heap_clear_owner();
 	if (pipe == NULL) {
 		trace_ipc_error("ipc_pipeline_new() error: "
 				"pipeline_new() failed");
 		return -ENOMEM;
 	}
 
+#if CONFIG_PIPELINE_MCPS_BUDGET
+	/* pipeline could never be started */
+	if (pipeline_declared_kcps(pipe) > CONFIG_PIPELINE_MCPS_BUDGET * 1000) {
+		trace_ipc_error("ipc_pipeline_new() error: pipeline %u needs "
+				"%u kcps over core budget",
+				pipe_desc->pipeline_id,
+				pipeline_declared_kcps(pipe));
+		pipeline_free(pipe);
+		return -EINVAL;
+	}
+#endif
+
 	/* allocate the IPC pipeline container */
 	ipc_pipe = rzalloc(RZONE_RUNTIME | RZONE_FLAG_UNCACHED,
 			   SOF_MEM_CAPS_RAM, sizeof(struct ipc_comp_dev));
@@ -454,6 +663,7 @@ int ipc_init(struct sof *sof)
 	sof->ipc->shared_ctx->dsp_msg = NULL;
 	list_init(&sof->ipc->shared_ctx->empty_list);
 	list_init(&sof->ipc->shared_ctx->msg_list);
+	list_init(&sof->ipc->shared_ctx->slot_list);
 	list_init(&sof->ipc->shared_ctx->comp_list);
 
 	for (i = 0; i < MSG_QUEUE_SIZE; i++)
@@ -10,6 +10,9 @@
  * from time to time (within a period of PLATFORM_IDLE_TIME). If the core does
  * not enter the idle loop through looping forever or scheduling some work
  * continuously then the SA will emit trace and panic().
+ *
+ * The SA also closes the scheduler load window of every core each period and
+ * reports the per-core utilisation.
  */
 
 #include <sof/sof.h>
@@ -18,6 +21,7 @@
 #include <sof/panic.h>
 #include <sof/alloc.h>
 #include <sof/clk.h>
+#include <sof/cpu.h>
 #include <sof/trace.h>
 #include <platform/timer.h>
 #include <platform/platform.h>
@@ -39,6 +43,34 @@ void sa_enter_idle(struct sof *sof)
 	sa->last_idle = platform_timer_get(platform_timer);
 }
 
+/*
+ * Close the load window and report utilisation of running cores. Every core
+ * gets the same fixed format lines per window so the logger output can
+ * be plotted, all values are per mille of the window.
+ */
+static void report_load(void)
+{
+	struct schedule_load_stats stats;
+	int i;
+
+	schedule_load_update();
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (!cpu_is_core_enabled(i))
+			continue;
+
+		schedule_load_stats_get(i, &stats);
+
+		trace_sa("report_load(), core %u load %u idle %u irq %u", i,
+			 schedule_load_get(i), stats.idle, stats.irq);
+		trace_sa("report_load(), core %u ll %u edf %u", i,
+			 stats.sched[SOF_SCHEDULE_LL],
+			 stats.sched[SOF_SCHEDULE_EDF]);
+		trace_sa("report_load(), core %u top irq %u load %u", i,
+			 stats.irq_top, stats.irq_top_load);
+	}
+}
+
 static uint64_t validate(void *data)
 {
 	struct sa *sa = data;
@@ -55,6 +87,8 @@ static uint64_t validate(void *data)
 		panic(SOF_IPC_PANIC_IDLE);
 	}
 
+	report_load();
+
 	return PLATFORM_IDLE_TIME;
 }
 
@@ -79,4 +113,8 @@ void sa_init(struct sof *sof)
 			   validate, sa, 0, 0);
 
 	schedule_task(&sa->work, PLATFORM_IDLE_TIME, 0, 0);
+
+#if CONFIG_CLOCK_GOVERNOR
+	clock_governor_init(sof);
+#endif
 }
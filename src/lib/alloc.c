@@ -6,6 +6,7 @@
 //         Keyon Jie <yang.jie@linux.intel.com>
 
 #include <sof/alloc.h>
+#include <sof/audio/buffer.h>
 #include <sof/sof.h>
 #include <sof/debug.h>
 #include <sof/panic.h>
@@ -95,6 +96,71 @@ static inline uint32_t heap_get_size(struct mm_heap *heap)
 	return size;
 }
 
+/* account new allocation to heap and to current owner of this core */
+static void alloc_account(struct mm_heap *heap, struct block_hdr *hdr,
+			  uint32_t bytes)
+{
+	struct mm_owner *owner;
+	uint32_t slot = memmap.owner_slot[cpu_get_id()];
+
+	heap->info.allocs++;
+	if (heap->info.used > heap->info.peak)
+		heap->info.peak = heap->info.used;
+
+	hdr->owner = slot;
+	if (slot == HEAP_OWNER_SLOT_NONE)
+		return;
+
+	owner = &memmap.owner[slot];
+	owner->used += bytes;
+	owner->allocs++;
+	if (owner->used > owner->peak)
+		owner->peak = owner->used;
+}
+
+/* remove freed allocation from heap and owner usage */
+static void free_account(struct mm_heap *heap, uint32_t slot, uint32_t bytes)
+{
+	struct mm_owner *owner;
+
+	heap->info.allocs--;
+
+	if (slot == HEAP_OWNER_SLOT_NONE || slot >= HEAP_OWNER_COUNT)
+		return;
+
+	owner = &memmap.owner[slot];
+	owner->used -= bytes;
+	owner->allocs--;
+}
+
+/* largest run of free blocks in any map of the heap, locks held by caller */
+static uint32_t heap_max_free(struct mm_heap *heap)
+{
+	struct block_map *map;
+	uint32_t max_free = 0;
+	uint32_t run;
+	int i;
+	int j;
+
+	for (i = 0; i < heap->blocks; i++) {
+		map = &heap->map[i];
+		run = 0;
+
+		for (j = 0; j < map->count; j++) {
+			if (map->block[j].used) {
+				run = 0;
+				continue;
+			}
+
+			run++;
+			if (run * map->block_size > max_free)
+				max_free = run * map->block_size;
+		}
+	}
+
+	return max_free;
+}
+
 #if CONFIG_DEBUG_BLOCK_FREE
 static void write_pattern(struct mm_heap *heap_map, int heap_depth,
 						  uint8_t pattern)
@@ -174,6 +240,8 @@ static void *rmalloc_sys(int zone, int caps, int core, size_t bytes)
 
 	cpu_heap->info.used += bytes;
 	cpu_heap->info.free -= alignment + bytes;
+	cpu_heap->info.peak = cpu_heap->info.used;
+	cpu_heap->info.allocs++;
 
 	/* other core should have the latest value */
 	if (core != cpu_get_id())
@@ -201,6 +269,7 @@ static void *alloc_block(struct mm_heap *heap, int level,
 	hdr->used = 1;
 	heap->info.used += map->block_size;
 	heap->info.free -= map->block_size;
+	alloc_account(heap, hdr, map->block_size);
 
 	/* find next free */
 	for (i = map->first_free; i < map->count; ++i) {
@@ -256,10 +325,11 @@ static void *alloc_cont_blocks(struct mm_heap *heap, int level,
 	hdr->size = count;
 	heap->info.used += count * map->block_size;
 	heap->info.free -= count * map->block_size;
+	alloc_account(heap, hdr, count * map->block_size);
 	map->first_free = map->first_free + count;
 
 	/* update each block */
-	for (current = start; current < count; current++) {
+	for (current = start; current < start + count; current++) {
 		hdr = &map->block[current];
 		hdr->used = 1;
 	}
@@ -389,11 +459,13 @@ static void free_block(void *ptr)
 
 	/* free block header and continuous blocks */
 	used_blocks = block + hdr->size;
+	free_account(heap, hdr->owner, hdr->size * block_map->block_size);
 
 	for (i = block; i < used_blocks; i++) {
 		hdr = &block_map->block[i];
 		hdr->size = 0;
 		hdr->used = 0;
+		hdr->owner = HEAP_OWNER_SLOT_NONE;
 		block_map->free_count++;
 		heap->info.used -= block_map->block_size;
 		heap->info.free += block_map->block_size;
@@ -486,6 +558,133 @@ void alloc_trace_buffer_heap(int zone, uint32_t caps, size_t bytes)
 
 #endif
 
+/* bump allocate from arena, locks held by caller */
+static void *arena_alloc_unlocked(struct mm_arena *arena, size_t bytes)
+{
+	uint32_t size = ALIGN_UP(bytes, PLATFORM_DCACHE_ALIGN);
+	struct mm_arena_slot *slot;
+	void *ptr;
+	int i;
+
+	if (!bytes)
+		return NULL;
+
+	/* space of a freed pinned allocation, e.g. a resized buffer */
+	for (i = 0; i < arena->slots; i++) {
+		slot = &arena->slot[i];
+		if (slot->free && slot->size >= size) {
+			slot->free = false;
+			arena->pinned++;
+			return (char *)arena->base + slot->offset;
+		}
+	}
+
+	if (size > arena->size - arena->top)
+		return NULL;
+
+	ptr = (char *)arena->base + arena->top;
+
+	if (arena->sealed) {
+		arena->last = arena->top;
+		arena->live++;
+	} else {
+		arena->pinned++;
+		if (arena->slots < ARENA_SLOTS) {
+			slot = &arena->slot[arena->slots++];
+			slot->offset = arena->top;
+			slot->size = size;
+			slot->free = false;
+		}
+	}
+
+	arena->top += size;
+
+	return ptr;
+}
+
+/* allocate from arena of current owner on this core if request fits */
+static void *arena_alloc_current(int zone, uint32_t caps, size_t bytes)
+{
+	struct mm_arena *arena = memmap.arena[cpu_get_id()];
+
+	if (!arena || arena->released)
+		return NULL;
+
+	/* uncached aliases and other memory types stay on the heaps */
+	if ((zone & RZONE_FLAG_MASK) == RZONE_FLAG_UNCACHED ||
+	    (arena->caps & caps) != caps)
+		return NULL;
+
+	return arena_alloc_unlocked(arena, bytes);
+}
+
+static struct mm_arena *arena_get_from_ptr(void *ptr)
+{
+	struct mm_arena *arena;
+	struct list_item *alist;
+
+	list_for_item(alist, &memmap.arena_list) {
+		arena = container_of(alist, struct mm_arena, list);
+		if (ptr >= arena->base &&
+		    ptr < (void *)((char *)arena->base + arena->size))
+			return arena;
+	}
+
+	return NULL;
+}
+
+static void _rfree_unlocked(void *ptr);
+
+/* give arena region back to the heap, locks held by caller */
+static void arena_drop(struct mm_arena *arena)
+{
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (memmap.arena[i] == arena)
+			memmap.arena[i] = NULL;
+	}
+
+	list_item_del(&arena->list);
+	_rfree_unlocked(arena->base);
+	_rfree_unlocked(arena);
+}
+
+/* release arena allocation, returns 0 if ptr is not from any arena */
+static int arena_release_ptr(void *ptr)
+{
+	struct mm_arena *arena = arena_get_from_ptr(ptr);
+	uint32_t offset;
+	int i;
+
+	if (!arena)
+		return 0;
+
+	offset = (char *)ptr - (char *)arena->base;
+
+	if (!arena->sealed || offset < arena->mark) {
+		arena->pinned--;
+
+		for (i = 0; i < arena->slots; i++) {
+			if (arena->slot[i].offset == offset)
+				arena->slot[i].free = true;
+		}
+	} else {
+		arena->live--;
+
+		/* recycle the tail: all of it or the latest allocation */
+		if (!arena->live)
+			arena->top = arena->mark;
+		else if (offset == arena->last)
+			arena->top = arena->last;
+	}
+
+	if (arena->released && !arena->pinned && !arena->live)
+		arena_drop(arena);
+
+	return 1;
+}
+
 /* allocate single block for system runtime */
 static void *rmalloc_sys_runtime(int zone, int caps, int core, size_t bytes)
 {
@@ -543,7 +742,9 @@ static void *_malloc_unlocked(int zone, uint32_t caps, size_t bytes)
 		ptr = rmalloc_sys_runtime(zone, caps, cpu_get_id(), bytes);
 		break;
 	case RZONE_RUNTIME:
-		ptr = rmalloc_runtime(zone, caps, bytes);
+		ptr = arena_alloc_current(zone, caps, bytes);
+		if (!ptr)
+			ptr = rmalloc_runtime(zone, caps, bytes);
 		break;
 	default:
 		trace_mem_error("rmalloc() error: invalid zone");
@@ -656,7 +857,11 @@ static void *_balloc_unlocked(int zone, uint32_t caps, size_t bytes)
 {
 	struct mm_heap *heap;
 	unsigned int i, n;
-	void *ptr = NULL;
+	void *ptr;
+
+	ptr = arena_alloc_current(zone, caps, bytes);
+	if (ptr)
+		return ptr;
 
 	for (i = 0, n = PLATFORM_HEAP_BUFFER, heap = memmap.buffer;
 	     i < PLATFORM_HEAP_BUFFER;
@@ -688,6 +893,12 @@ void *_balloc(int zone, uint32_t caps, size_t bytes)
 
 	spin_unlock_irq(&memmap.lock, flags);
 
+#if CONFIG_BUFFER_POOL
+	/* backing stores kept for new pipeline buffers go back first */
+	if (!ptr && buffer_pool_flush())
+		return _balloc(zone, caps, bytes);
+#endif
+
 	return ptr;
 }
 
@@ -703,6 +914,12 @@ static void _rfree_unlocked(void *ptr)
 	if (is_uncached(ptr))
 		ptr = uncache_to_cache(ptr);
 
+	/* arena allocations are returned with their arena */
+	if (arena_release_ptr(ptr)) {
+		memmap.heap_trace_updated = 1;
+		return;
+	}
+
 	/* use the heap dedicated for the selected core */
 	cpu_heap = memmap.system + cpu_get_id();
 
@@ -772,6 +989,12 @@ void *_brealloc(void *ptr, int zone, uint32_t caps, size_t bytes)
 
 	spin_unlock_irq(&memmap.lock, flags);
 
+#if CONFIG_BUFFER_POOL
+	/* backing stores kept for new pipeline buffers go back first */
+	if (!new_ptr && buffer_pool_flush())
+		return _brealloc(ptr, zone, caps, bytes);
+#endif
+
 	return new_ptr;
 }
 
@@ -816,6 +1039,7 @@ void free_heap(int zone)
 	cpu_heap = memmap.system + cpu_get_id();
 	cpu_heap->info.used = 0;
 	cpu_heap->info.free = cpu_heap->size;
+	cpu_heap->info.allocs = 0;
 
 	dcache_writeback_region(cpu_heap, sizeof(*cpu_heap));
 }
@@ -834,6 +1058,9 @@ void heap_trace(struct mm_heap *heap, int size)
 			       heap->caps);
 		trace_mem_init("  used %d free %d", heap->info.used,
 			       heap->info.free);
+		trace_mem_init("  peak %d allocs %d max free %d",
+			       heap->info.peak, heap->info.allocs,
+			       heap_max_free(heap));
 
 		/* map[j]'s base is calculated based on map[j-1] */
 		for (j = 1; j < heap->blocks; j++) {
@@ -853,12 +1080,33 @@ void heap_trace(struct mm_heap *heap, int size)
 
 void heap_trace_all(int force)
 {
+	struct mm_owner *owner;
+	struct mm_arena *arena;
+	struct list_item *alist;
+	int i;
+
 	/* has heap changed since last shown */
 	if (memmap.heap_trace_updated || force) {
 		trace_mem_init("heap: buffer status");
 		heap_trace(memmap.buffer, PLATFORM_HEAP_BUFFER);
 		trace_mem_init("heap: runtime status");
 		heap_trace(memmap.runtime, PLATFORM_HEAP_RUNTIME);
+
+		for (i = 1; i < HEAP_OWNER_COUNT; i++) {
+			owner = &memmap.owner[i];
+			if (owner->id == HEAP_OWNER_NONE)
+				continue;
+
+			trace_mem_init("heap: pipe %d used %d peak %d",
+				       owner->id, owner->used, owner->peak);
+			trace_mem_init("  allocs %d", owner->allocs);
+		}
+
+		list_for_item(alist, &memmap.arena_list) {
+			arena = container_of(alist, struct mm_arena, list);
+			trace_mem_init("heap: arena pipe %d size %d used %d",
+				       arena->owner, arena->size, arena->top);
+		}
 	}
 	memmap.heap_trace_updated = 0;
 }
@@ -867,10 +1115,232 @@ void heap_trace_all(int force) { }
 void heap_trace(struct mm_heap *heap, int size) { }
 #endif
 
+static struct mm_heap *heap_get(int zone, int index)
+{
+	switch (zone & RZONE_TYPE_MASK) {
+	case RZONE_SYS:
+		if (index < PLATFORM_HEAP_SYSTEM)
+			return &memmap.system[index];
+		break;
+	case RZONE_SYS_RUNTIME:
+		if (index < PLATFORM_HEAP_SYSTEM_RUNTIME)
+			return &memmap.system_runtime[index];
+		break;
+	case RZONE_RUNTIME:
+		if (index < PLATFORM_HEAP_RUNTIME)
+			return &memmap.runtime[index];
+		break;
+	case RZONE_BUFFER:
+		if (index < PLATFORM_HEAP_BUFFER)
+			return &memmap.buffer[index];
+		break;
+	default:
+		break;
+	}
+
+	return NULL;
+}
+
+int heap_get_info(int zone, int index, struct mm_info *info,
+		  uint32_t *max_free)
+{
+	struct mm_heap *heap;
+	uint32_t flags;
+
+	heap = heap_get(zone, index);
+	if (!heap || index < 0)
+		return -EINVAL;
+
+	spin_lock_irq(&memmap.lock, flags);
+
+	*info = heap->info;
+
+	/* system heap has no block map, free space is contiguous */
+	if ((zone & RZONE_TYPE_MASK) == RZONE_SYS)
+		*max_free = heap->info.free;
+	else
+		*max_free = heap_max_free(heap);
+
+	spin_unlock_irq(&memmap.lock, flags);
+
+	return 0;
+}
+
+static struct mm_arena *arena_get_from_owner(uint32_t pipeline_id)
+{
+	struct mm_arena *arena;
+	struct list_item *alist;
+
+	list_for_item(alist, &memmap.arena_list) {
+		arena = container_of(alist, struct mm_arena, list);
+		if (arena->owner == pipeline_id && !arena->released)
+			return arena;
+	}
+
+	return NULL;
+}
+
+void heap_set_owner(uint32_t pipeline_id)
+{
+	struct mm_owner *owner;
+	uint32_t slot = HEAP_OWNER_SLOT_NONE;
+	uint32_t flags;
+	int i;
+
+	spin_lock_irq(&memmap.lock, flags);
+
+	/* existing slot of this pipeline */
+	for (i = 1; i < HEAP_OWNER_COUNT; i++) {
+		if (memmap.owner[i].id == pipeline_id) {
+			slot = i;
+			goto out;
+		}
+	}
+
+	/* otherwise take an unused slot or one with no memory left */
+	for (i = 1; i < HEAP_OWNER_COUNT; i++) {
+		owner = &memmap.owner[i];
+		if (owner->id == HEAP_OWNER_NONE || !owner->allocs) {
+			owner->id = pipeline_id;
+			owner->used = 0;
+			owner->peak = 0;
+			owner->allocs = 0;
+			slot = i;
+			goto out;
+		}
+	}
+
+	trace_mem_error("heap_set_owner() error: no slot for pipe %d",
+			pipeline_id);
+
+out:
+	memmap.owner_slot[cpu_get_id()] = slot;
+	memmap.arena[cpu_get_id()] = arena_get_from_owner(pipeline_id);
+
+	spin_unlock_irq(&memmap.lock, flags);
+}
+
+void heap_clear_owner(void)
+{
+	memmap.owner_slot[cpu_get_id()] = HEAP_OWNER_SLOT_NONE;
+	memmap.arena[cpu_get_id()] = NULL;
+}
+
+int heap_get_owner_info(int slot, struct mm_owner *owner)
+{
+	uint32_t flags;
+	int ret = 0;
+
+	if (slot <= HEAP_OWNER_SLOT_NONE || slot >= HEAP_OWNER_COUNT)
+		return -EINVAL;
+
+	spin_lock_irq(&memmap.lock, flags);
+
+	if (memmap.owner[slot].id == HEAP_OWNER_NONE)
+		ret = -EINVAL;
+	else
+		*owner = memmap.owner[slot];
+
+	spin_unlock_irq(&memmap.lock, flags);
+
+	return ret;
+}
+
+struct mm_arena *arena_new(uint32_t owner, uint32_t caps, size_t bytes)
+{
+	struct mm_arena *arena;
+	uint32_t flags;
+
+	spin_lock_irq(&memmap.lock, flags);
+
+	arena = _malloc_unlocked(RZONE_RUNTIME, SOF_MEM_CAPS_RAM,
+				 sizeof(*arena));
+	if (!arena)
+		goto out;
+
+	bzero(arena, sizeof(*arena));
+
+	bytes = ALIGN_UP(bytes, PLATFORM_DCACHE_ALIGN);
+	arena->base = _balloc_unlocked(RZONE_BUFFER, caps, bytes);
+	if (!arena->base) {
+		_rfree_unlocked(arena);
+		arena = NULL;
+		goto out;
+	}
+
+	arena->owner = owner;
+	arena->caps = caps;
+	arena->size = bytes;
+
+	list_item_append(&arena->list, &memmap.arena_list);
+
+out:
+	spin_unlock_irq(&memmap.lock, flags);
+
+	return arena;
+}
+
+void *arena_alloc(struct mm_arena *arena, size_t bytes)
+{
+	uint32_t flags;
+	void *ptr;
+
+	spin_lock_irq(&memmap.lock, flags);
+	ptr = arena_alloc_unlocked(arena, bytes);
+	spin_unlock_irq(&memmap.lock, flags);
+
+	return ptr;
+}
+
+void arena_seal(struct mm_arena *arena)
+{
+	uint32_t flags;
+
+	spin_lock_irq(&memmap.lock, flags);
+
+	arena->mark = arena->top;
+	arena->sealed = true;
+
+	spin_unlock_irq(&memmap.lock, flags);
+}
+
+bool arena_contains(void *ptr)
+{
+	struct mm_arena *arena;
+	uint32_t flags;
+
+	if (is_uncached(ptr))
+		ptr = uncache_to_cache(ptr);
+
+	spin_lock_irq(&memmap.lock, flags);
+	arena = arena_get_from_ptr(ptr);
+	spin_unlock_irq(&memmap.lock, flags);
+
+	return arena != NULL;
+}
+
+void arena_free(struct mm_arena *arena)
+{
+	uint32_t flags;
+
+	if (!arena)
+		return;
+
+	spin_lock_irq(&memmap.lock, flags);
+
+	/* region goes back once the last allocation in it is freed */
+	arena->released = true;
+	if (!arena->pinned && !arena->live)
+		arena_drop(arena);
+
+	spin_unlock_irq(&memmap.lock, flags);
+}
+
 /* initialise map */
 void init_heap(struct sof *sof)
 {
 	extern uintptr_t _system_heap_start;
+	int i;
 
 	/* sanity check for malformed images or loader issues */
 	if (memmap.system[0].heap != (uintptr_t)&_system_heap_start)
@@ -878,6 +1348,14 @@ void init_heap(struct sof *sof)
 
 	spinlock_init(&memmap.lock);
 
+	for (i = 0; i < HEAP_OWNER_COUNT; i++)
+		memmap.owner[i].id = HEAP_OWNER_NONE;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++)
+		memmap.owner_slot[i] = HEAP_OWNER_SLOT_NONE;
+
+	list_init(&memmap.arena_list);
+
 	init_heap_map(memmap.system_runtime, PLATFORM_HEAP_SYSTEM_RUNTIME);
 
 	init_heap_map(memmap.runtime, PLATFORM_HEAP_RUNTIME);
@@ -13,6 +13,9 @@
 #include <sof/lock.h>
 #include <sof/notifier.h>
 #include <sof/cpu.h>
+#include <sof/ipc.h>
+#include <sof/math/numbers.h>
+#include <sof/schedule/schedule.h>
 #include <platform/clk.h>
 #include <platform/clk-map.h>
 #include <platform/platform.h>
@@ -164,3 +167,76 @@ void clock_init(void)
 			ssp_freq[SSP_DEFAULT_IDX].ticks_per_msec;
 	spinlock_init(&clk_pdata->clk[CLK_SSP].lock);
 }
+
+#if CONFIG_CLOCK_GOVERNOR
+/* scales the clock of the master core to the load of all cores */
+struct clock_governor {
+	struct clk_gov gov;
+	struct schedule_load_window win[PLATFORM_CORE_COUNT];
+	struct sof *sof;
+	struct task work;
+};
+
+static uint64_t clock_governor_run(void *data)
+{
+	struct clock_governor *cg = data;
+	int clock = CLK_CPU(cpu_get_id());
+	uint32_t load = 0;
+	uint32_t committed = 0;
+	uint32_t misses = cg->gov.misses;
+	uint32_t idx;
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (!cpu_is_core_enabled(i))
+			continue;
+
+		load = MAX(load, schedule_load_sample(i, &cg->win[i]));
+
+		/* counter kept by IPC, component list may be changing */
+		if (cg->sof->ipc)
+			committed = MAX(committed,
+					ipc_core_committed_kcps(cg->sof->ipc,
+								i));
+	}
+
+	/* the host may have set the clock in the meantime */
+	cg->gov.idx = clock_get_nearest_freq_idx(cpu_freq,
+						 ARRAY_SIZE(cpu_freq),
+						 clock_get_freq(clock));
+	idx = cg->gov.idx;
+
+	if (clk_gov_update(&cg->gov, load, committed) != idx) {
+		trace_clk("clock_governor_run(), load %u committed %u kcps, "
+			  "freq %u -> %u", load, committed, cpu_freq[idx].freq,
+			  cpu_freq[cg->gov.idx].freq);
+		clock_set_freq(clock, cpu_freq[cg->gov.idx].freq);
+	}
+
+	if (cg->gov.misses != misses)
+		trace_clk_error("clock_governor_run() error: core saturated "
+				"after transition, %u misses", cg->gov.misses);
+
+	return CONFIG_CLOCK_GOVERNOR_PERIOD;
+}
+
+void clock_governor_init(struct sof *sof)
+{
+	struct clock_governor *cg;
+	int i;
+
+	cg = rzalloc(RZONE_SYS, SOF_MEM_CAPS_RAM, sizeof(*cg));
+	cg->sof = sof;
+
+	clk_gov_init(&cg->gov, cpu_freq, ARRAY_SIZE(cpu_freq),
+		     clock_get_freq(CLK_CPU(cpu_get_id())));
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++)
+		schedule_load_sample(i, &cg->win[i]);
+
+	schedule_task_init(&cg->work, SOF_SCHEDULE_LL, SOF_TASK_PRI_HIGH,
+			   clock_governor_run, cg, cpu_get_id(), 0);
+
+	schedule_task(&cg->work, CONFIG_CLOCK_GOVERNOR_PERIOD, 0, 0);
+}
+#endif
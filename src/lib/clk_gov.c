@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/*
+ * Clock governor policy. Scales the clock up as soon as the load of a window
+ * would exceed the target at the current frequency and down one step at a
+ * time once the load stayed low enough for the lower frequency for a number
+ * of windows. The window following a transition is verified, a saturated
+ * core is counted as a deadline miss and brought to the highest frequency.
+ *
+ * The policy has no platform dependencies so the testbench can evaluate it
+ * offline on recorded load traces.
+ */
+
+#include <sof/clk.h>
+#include <sof/math/numbers.h>
+#include <stdint.h>
+
+/* lowest frequency running the demand in kcps below the load */
+static uint32_t clk_gov_idx(struct clk_gov *gov, uint64_t demand,
+			    uint32_t load)
+{
+	uint32_t i;
+
+	for (i = 0; i < gov->count - 1; i++) {
+		if (demand * 1000 <= (uint64_t)gov->tab[i].freq / 1000 * load)
+			break;
+	}
+
+	return i;
+}
+
+static uint32_t clk_gov_set(struct clk_gov *gov, uint32_t idx)
+{
+	if (idx != gov->idx) {
+		gov->idx = idx;
+		gov->transitions++;
+		gov->verify = 1;
+	}
+
+	gov->low_windows = 0;
+
+	return idx;
+}
+
+void clk_gov_init(struct clk_gov *gov, const struct freq_table *tab,
+		  uint32_t count, uint32_t freq)
+{
+	uint32_t i;
+
+	/* nearest frequency that is >= freq */
+	for (i = 0; i < count - 1; i++) {
+		if (freq <= tab[i].freq)
+			break;
+	}
+
+	gov->tab = tab;
+	gov->count = count;
+	gov->idx = i;
+	gov->target = CLK_GOV_TARGET;
+	gov->hysteresis = CLK_GOV_HYSTERESIS;
+	gov->down_delay = CLK_GOV_DOWN_DELAY;
+	gov->low_windows = 0;
+	gov->verify = 0;
+	gov->transitions = 0;
+	gov->misses = 0;
+}
+
+uint32_t clk_gov_update(struct clk_gov *gov, uint32_t load,
+			uint32_t committed)
+{
+	uint64_t demand;
+	uint32_t verify = gov->verify;
+
+	gov->verify = 0;
+
+	/* real demand of a saturated core is unknown */
+	if (load >= CLK_GOV_SATURATED) {
+		if (verify)
+			gov->misses++;
+
+		return clk_gov_set(gov, gov->count - 1);
+	}
+
+	/* busy cycles of the window, never below the declared load */
+	demand = (uint64_t)load * gov->tab[gov->idx].freq / 1000000;
+	demand = MAX(demand, committed);
+
+	if (clk_gov_idx(gov, demand, gov->target) > gov->idx)
+		return clk_gov_set(gov, clk_gov_idx(gov, demand, gov->target));
+
+	if (clk_gov_idx(gov, demand, gov->target - gov->hysteresis) >=
+	    gov->idx) {
+		gov->low_windows = 0;
+		return gov->idx;
+	}
+
+	if (++gov->low_windows < gov->down_delay)
+		return gov->idx;
+
+	return clk_gov_set(gov, gov->idx - 1);
+}
@@ -0,0 +1,391 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2018 Intel Corporation. All rights reserved.
+//
+// Author: Tomasz Lauda <tomasz.lauda@linux.intel.com>
+
+/**
+ * \file lib/idc.c
+ * \brief Architecture independent IDC message handling
+ * \authors Tomasz Lauda <tomasz.lauda@linux.intel.com>
+ */
+
+#include <arch/cpu.h>
+#include <arch/idc.h>
+#include <platform/cpu.h>
+#include <sof/alloc.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/cache.h>
+#include <sof/cpu.h>
+#include <sof/idc.h>
+#include <sof/ipc.h>
+#include <sof/lock.h>
+#include <sof/notifier.h>
+#include <sof/string.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+extern struct ipc *_ipc;
+
+/** \brief Rings of all core pairs, allocated by the master core. */
+static struct idc_ring *idc_rings;
+
+/**
+ * \brief Returns ring carrying messages from source to target core.
+ * \param[in] source Source core id.
+ * \param[in] target Target core id.
+ * \return Pointer to IDC ring.
+ */
+static struct idc_ring *idc_ring_get(int source, int target)
+{
+	/* no ring from a core to itself */
+	return &idc_rings[source * (PLATFORM_CORE_COUNT - 1) +
+			  (target < source ? target : target - 1)];
+}
+
+/**
+ * \brief Initializes IDC rings, cancels messages left for the current core.
+ * \return Error code.
+ */
+int idc_ring_init(void)
+{
+	struct idc_ring *ring;
+	int core = cpu_get_id();
+	uint32_t flags;
+	int i;
+
+	if (core == PLATFORM_MASTER_CORE_ID && !idc_rings) {
+		idc_rings = rzalloc(RZONE_SYS | RZONE_FLAG_UNCACHED,
+				    SOF_MEM_CAPS_RAM, sizeof(*idc_rings) *
+				    PLATFORM_CORE_COUNT *
+				    (PLATFORM_CORE_COUNT - 1));
+		if (!idc_rings) {
+			trace_idc_error("idc_ring_init() error: alloc failed");
+			return -ENOMEM;
+		}
+
+		for (i = 0; i < PLATFORM_CORE_COUNT *
+		     (PLATFORM_CORE_COUNT - 1); i++)
+			spinlock_init(&idc_rings[i].lock);
+
+		/* slave cores read the pointer from memory */
+		dcache_writeback_region(&idc_rings, sizeof(idc_rings));
+	} else if (core != PLATFORM_MASTER_CORE_ID) {
+		dcache_invalidate_region(&idc_rings, sizeof(idc_rings));
+	}
+
+	if (!idc_rings)
+		return -ENODEV;
+
+	/* messages pending when the core went down are never executed */
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (i == core)
+			continue;
+
+		ring = idc_ring_get(i, core);
+
+		spin_lock_irq(&ring->lock, flags);
+		for (; ring->done != ring->tail; ring->done++)
+			ring->msg[ring->done % IDC_RING_SIZE].ret = -ECANCELED;
+		ring->head = ring->tail;
+		spin_unlock_irq(&ring->lock, flags);
+	}
+
+	return 0;
+}
+
+/**
+ * \brief Checks if pending message is identical to the new one.
+ * \param[in] slot Pending message.
+ * \param[in] msg New message.
+ * \return True if the new message can be dropped.
+ */
+static bool idc_ring_msg_equal(struct idc_ring_msg *slot,
+			       struct idc_msg *msg)
+{
+	return slot->msg.header == msg->header &&
+		slot->msg.extension == msg->extension &&
+		slot->msg.size == msg->size &&
+		!memcmp(slot->payload, msg->payload, msg->size);
+}
+
+/**
+ * \brief Posts message into the ring of the target core.
+ *
+ * The caller rings the doorbell of the target core afterwards. Coalesced
+ * messages keep the completion callback of the pending message.
+ *
+ * \param[in] msg Pointer to IDC message.
+ * \param[in] mode Send mode, pending duplicates are dropped in coalesce mode.
+ * \param[out] seq Sequence number of the message.
+ * \return Error code, -EBUSY if the ring is full.
+ */
+int idc_ring_post(struct idc_msg *msg, uint32_t mode, uint32_t *seq)
+{
+	struct idc_ring *ring;
+	struct idc_ring_msg *slot;
+	uint32_t flags;
+	uint32_t i;
+	int ret = 0;
+
+	if (!idc_rings)
+		return -ENODEV;
+
+	if (msg->size > IDC_PAYLOAD_SIZE) {
+		trace_idc_error("idc_ring_post() error: payload size %u",
+				msg->size);
+		return -EINVAL;
+	}
+
+	/* free slots of completed messages */
+	idc_ring_reap(msg->core);
+
+	ring = idc_ring_get(cpu_get_id(), msg->core);
+
+	spin_lock_irq(&ring->lock, flags);
+
+	if (mode == IDC_COALESCE) {
+		for (i = ring->head; i != ring->tail; i++) {
+			slot = &ring->msg[i % IDC_RING_SIZE];
+			if (idc_ring_msg_equal(slot, msg)) {
+				ring->coalesced++;
+				*seq = i;
+				goto out;
+			}
+		}
+	}
+
+	if (ring->tail - ring->reaped == IDC_RING_SIZE) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	slot = &ring->msg[ring->tail % IDC_RING_SIZE];
+	slot->msg = *msg;
+	slot->msg.core = cpu_get_id();
+	slot->ret = 0;
+	if (msg->size)
+		assert(!memcpy_s(slot->payload, sizeof(slot->payload),
+				 msg->payload, msg->size));
+
+	*seq = ring->tail++;
+
+out:
+	spin_unlock_irq(&ring->lock, flags);
+
+	return ret;
+}
+
+/**
+ * \brief Returns status of a message posted by the current core.
+ * \param[in] target Target core id.
+ * \param[in] seq Sequence number of the message.
+ * \return Result of the target, -EINPROGRESS if not yet completed.
+ */
+int idc_ring_status(int target, uint32_t seq)
+{
+	struct idc_ring *ring = idc_ring_get(cpu_get_id(), target);
+
+	if ((int32_t)(ring->done - seq) <= 0)
+		return -EINPROGRESS;
+
+	return ring->msg[seq % IDC_RING_SIZE].ret;
+}
+
+/**
+ * \brief Returns number of messages from source waiting for current core.
+ * \param[in] source Source core id.
+ * \return Number of messages.
+ */
+int idc_ring_pending(int source)
+{
+	struct idc_ring *ring = idc_ring_get(source, cpu_get_id());
+
+	return ring->tail - ring->head;
+}
+
+/**
+ * \brief Executes messages from source core until its ring is empty.
+ * \param[in] source Source core id.
+ * \return Number of executed messages.
+ */
+int idc_ring_process(int source)
+{
+	struct idc_ring *ring = idc_ring_get(source, cpu_get_id());
+	uint8_t payload[IDC_PAYLOAD_SIZE];
+	struct idc_ring_msg *slot;
+	struct idc_msg msg;
+	uint32_t flags;
+	int count = 0;
+	int ret;
+
+	for (;;) {
+		spin_lock_irq(&ring->lock, flags);
+
+		if (ring->head == ring->tail) {
+			spin_unlock_irq(&ring->lock, flags);
+			break;
+		}
+
+		/* claimed message can't be coalesced anymore */
+		slot = &ring->msg[ring->head++ % IDC_RING_SIZE];
+		msg = slot->msg;
+		assert(!memcpy_s(payload, sizeof(payload), slot->payload,
+				 msg.size));
+		msg.payload = payload;
+
+		spin_unlock_irq(&ring->lock, flags);
+
+		ret = idc_cmd(&msg);
+
+		spin_lock_irq(&ring->lock, flags);
+		slot->ret = ret;
+		ring->done++;
+		spin_unlock_irq(&ring->lock, flags);
+
+		count++;
+	}
+
+	return count;
+}
+
+/**
+ * \brief Runs completion callbacks of messages sent to target core.
+ * \param[in] target Target core id.
+ */
+void idc_ring_reap(int target)
+{
+	struct idc_ring *ring;
+	struct idc_ring_msg *slot;
+	void (*cb)(void *data, int ret);
+	void *cb_data;
+	uint32_t flags;
+	int ret;
+
+	if (!idc_rings)
+		return;
+
+	ring = idc_ring_get(cpu_get_id(), target);
+
+	for (;;) {
+		spin_lock_irq(&ring->lock, flags);
+
+		if (ring->reaped == ring->done) {
+			spin_unlock_irq(&ring->lock, flags);
+			break;
+		}
+
+		slot = &ring->msg[ring->reaped++ % IDC_RING_SIZE];
+		cb = slot->msg.cb;
+		cb_data = slot->msg.cb_data;
+		ret = slot->ret;
+
+		spin_unlock_irq(&ring->lock, flags);
+
+		if (cb)
+			cb(cb_data, ret);
+	}
+}
+
+/**
+ * \brief Executes IDC pipeline trigger message.
+ * \param[in] msg Pointer to IDC message, payload is the host component id.
+ * \return Error code.
+ */
+static int idc_pipeline_trigger(struct idc_msg *msg)
+{
+	uint32_t cmd = msg->extension;
+	uint32_t *comp_id = msg->payload;
+	struct ipc_comp_dev *pcm_dev;
+	int ret;
+
+	if (msg->size != sizeof(*comp_id))
+		return -EINVAL;
+
+	/* check whether component exists */
+	pcm_dev = ipc_get_comp(_ipc, *comp_id);
+	if (!pcm_dev)
+		return -ENODEV;
+
+	/* check whether we are executing from the right core */
+	if (arch_cpu_get_id() != pcm_dev->cd->pipeline->ipc_pipe.core)
+		return -EINVAL;
+
+	/* invalidate pipeline on start */
+	if (cmd == COMP_TRIGGER_START)
+		pipeline_cache(pcm_dev->cd->pipeline,
+			       pcm_dev->cd, CACHE_INVALIDATE);
+
+	/* trigger pipeline */
+	ret = pipeline_trigger(pcm_dev->cd->pipeline, pcm_dev->cd, cmd);
+
+	/* writeback pipeline on stop */
+	if (cmd == COMP_TRIGGER_STOP)
+		pipeline_cache(pcm_dev->cd->pipeline,
+			       pcm_dev->cd, CACHE_WRITEBACK_INV);
+
+	return ret;
+}
+
+/**
+ * \brief Executes IDC component command message.
+ * \param[in] cmd Component command.
+ * \return Error code.
+ */
+static int idc_component_command(uint32_t cmd)
+{
+	struct sof_ipc_ctrl_data *data = _ipc->comp_data;
+	struct ipc_comp_dev *comp_dev;
+	int ret;
+
+	/* invalidate control data */
+	dcache_invalidate_region(data, sizeof(*data));
+	dcache_invalidate_region(data + 1,
+				 data->rhdr.hdr.size - sizeof(*data));
+
+	/* check whether component exists */
+	comp_dev = ipc_get_comp(_ipc, data->comp_id);
+	if (!comp_dev)
+		return -ENODEV;
+
+	/* check whether we are executing from the right core */
+	if (arch_cpu_get_id() != comp_dev->cd->pipeline->ipc_pipe.core)
+		return -EINVAL;
+
+	/* execute component command */
+	ret = comp_cmd(comp_dev->cd, cmd, data, data->rhdr.hdr.size);
+
+	/* writeback control data */
+	dcache_writeback_region(data, data->rhdr.hdr.size);
+
+	return ret;
+}
+
+/**
+ * \brief Executes IDC message based on type.
+ * \param[in,out] msg Pointer to IDC message.
+ * \return Error code.
+ */
+int idc_cmd(struct idc_msg *msg)
+{
+	uint32_t type = iTS(msg->header);
+
+	switch (type) {
+	case iTS(IDC_MSG_POWER_DOWN):
+		cpu_power_down_core();
+		return 0;
+	case iTS(IDC_MSG_PPL_TRIGGER):
+		return idc_pipeline_trigger(msg);
+	case iTS(IDC_MSG_COMP_CMD):
+		return idc_component_command(msg->extension);
+	case iTS(IDC_MSG_NOTIFY):
+		return notifier_notify_remote(msg->payload, msg->size);
+	default:
+		trace_idc_error("idc_cmd() error: invalid msg->header = %u",
+				msg->header);
+		return -EINVAL;
+	}
+}
@@ -8,11 +8,59 @@
 #include <sof/interrupt.h>
 #include <sof/interrupt-map.h>
 #include <sof/alloc.h>
+#include <sof/cpu.h>
+#include <sof/schedule/schedule.h>
 #include <arch/interrupt.h>
 #include <platform/interrupt.h>
+#include <platform/platform.h>
+#include <platform/timer.h>
+#include <sof/drivers/timer.h>
 #include <stdint.h>
 #include <stdlib.h>
 
+/* level 1 handler wrapped to account its run time to the core load */
+struct irq_handler_timed {
+	void (*handler)(void *arg);
+	void *arg;
+	int irq;
+};
+
+/* level 1 handlers of a core, only ever accessed by that core */
+struct irq_cpu_handlers {
+	struct irq_handler_timed handler[SCHEDULE_LOAD_IRQS];
+} __aligned(PLATFORM_DCACHE_ALIGN);
+
+static struct irq_cpu_handlers irq_handlers[PLATFORM_CORE_COUNT];
+
+static void irq_timed_handler(void *arg)
+{
+	struct irq_handler_timed *timed = arg;
+	uint32_t mark = schedule_load_irq_enter();
+	uint64_t start = platform_timer_get(platform_timer);
+
+	timed->handler(timed->arg);
+
+	schedule_load_irq_exit(timed->irq, mark,
+			       platform_timer_get(platform_timer) - start);
+}
+
+static int irq_register_timed(int irq, void (*handler)(void *arg),
+			      void *arg)
+{
+	struct irq_handler_timed *timed;
+	int num = SOF_IRQ_NUMBER(irq);
+
+	if (num >= SCHEDULE_LOAD_IRQS)
+		return arch_interrupt_register(irq, handler, arg);
+
+	timed = &irq_handlers[cpu_get_id()].handler[num];
+	timed->handler = handler;
+	timed->arg = arg;
+	timed->irq = num;
+
+	return arch_interrupt_register(irq, irq_timed_handler, timed);
+}
+
 static int irq_register_child(struct irq_desc *parent, int irq, int unmask,
 			      void (*handler)(void *arg), void *arg)
 {
@@ -44,8 +92,8 @@ static int irq_register_child(struct irq_desc *parent, int irq, int unmask,
 
 	/* do we need to register parent ? */
 	if (parent->num_children == 0) {
-		ret = arch_interrupt_register(parent->irq,
-					      parent->handler, parent);
+		ret = irq_register_timed(parent->irq, parent->handler,
+					 parent);
 	}
 
 	/* increment number of children */
@@ -153,7 +201,7 @@ int interrupt_register(uint32_t irq, int unmask, void (*handler)(void *arg),
 	/* no parent means we are registering DSP internal IRQ */
 	parent = platform_irq_get_parent(irq);
 	if (parent == NULL)
-		return arch_interrupt_register(irq, handler, arg);
+		return irq_register_timed(irq, handler, arg);
 	else
 		return irq_register_child(parent, irq, unmask, handler, arg);
 }
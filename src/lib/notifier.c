@@ -11,92 +11,216 @@
 #include <sof/cpu.h>
 #include <sof/idc.h>
 #include <platform/idc.h>
+#include <sof/string.h>
 #include <platform/cpu.h>
-
-static struct notify_data _notify_data;
+#include <platform/platform.h>
+#include <sof/drivers/timer.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* event sent to another core, the event data is copied along */
+struct notify_remote {
+	uint32_t id;
+	uint32_t message;
+	uint8_t data[NOTIFIER_DATA_SIZE];
+};
+
+STATIC_ASSERT(sizeof(struct notify_remote) <= IDC_PAYLOAD_SIZE,
+	      notify_remote_fits_idc_payload);
 
 void notifier_register(struct notifier *notifier)
 {
 	struct notify *notify = *arch_notify_get();
+	uint32_t flags;
+
+	if (notifier->id >= NOTIFIER_ID_COUNT) {
+		trace_idc_error("notifier_register() error: invalid id %d",
+				notifier->id);
+		return;
+	}
 
-	spin_lock(&notify->lock);
-	list_item_prepend(&notifier->list, &notify->list);
-	spin_unlock(&notify->lock);
+	spin_lock_irq(&notify->lock, flags);
+	list_item_prepend(&notifier->list, &notify->list[notifier->id]);
+	spin_unlock_irq(&notify->lock, flags);
 }
 
 void notifier_unregister(struct notifier *notifier)
 {
 	struct notify *notify = *arch_notify_get();
+	uint32_t flags;
 
-	spin_lock(&notify->lock);
+	spin_lock_irq(&notify->lock, flags);
 	list_item_del(&notifier->list);
-	spin_unlock(&notify->lock);
+	spin_unlock_irq(&notify->lock, flags);
 }
 
-void notifier_notify(void)
+/* runs callbacks of the event id, clients may unregister from them */
+static void notifier_deliver(struct notify *notify,
+			     struct notify_event *event)
 {
-	struct notify *notify = *arch_notify_get();
 	struct list_item *wlist;
+	struct list_item *tlist;
 	struct notifier *n;
+	uint64_t latency;
 
-	if (!list_is_empty(&notify->list)) {
-		dcache_invalidate_region(&_notify_data, sizeof(_notify_data));
-		dcache_invalidate_region(_notify_data.data,
-					 _notify_data.data_size);
-
-		/* iterate through notifiers and send event to
-		 * interested clients
-		 */
-		list_for_item(wlist, &notify->list) {
-			n = container_of(wlist, struct notifier, list);
-			if (n->id == _notify_data.id)
-				n->cb(_notify_data.message, n->cb_data,
-				      _notify_data.data);
-		}
+	latency = platform_timer_get(platform_timer) - event->time;
+
+	list_for_item_safe(wlist, tlist, &notify->list[event->id]) {
+		n = container_of(wlist, struct notifier, list);
+		n->cb(event->message, n->cb_data, event->data);
 	}
+
+	notify->stats.events++;
+	notify->stats.latency_sum += latency;
+	if (latency > notify->stats.latency_max)
+		notify->stats.latency_max = latency;
 }
 
-void notifier_event(struct notify_data *notify_data)
+/*
+ * Queues event for the current core and delivers the queue, unless an
+ * earlier caller is delivering it already. Events raised by callbacks or by
+ * interrupts during delivery are then delivered by that caller in order
+ * without blocking the new one.
+ */
+static void notifier_queue(uint32_t id, uint32_t message, void *data,
+			   uint32_t data_size)
 {
 	struct notify *notify = *arch_notify_get();
+	struct notify_event event;
+	struct notify_event *e;
+	uint32_t flags;
+
+	event.id = id;
+	event.message = message;
+	event.data_size = data_size;
+	event.time = platform_timer_get(platform_timer);
+	if (data_size)
+		assert(!memcpy_s(event.data, sizeof(event.data), data,
+				 data_size));
+
+	spin_lock_irq(&notify->lock, flags);
+
+	if (notify->tail - notify->head == NOTIFIER_QUEUE_SIZE) {
+		/* never drop events, deliver this one out of order */
+		notify->stats.overflows++;
+		spin_unlock_irq(&notify->lock, flags);
+		notifier_deliver(notify, &event);
+		return;
+	}
+
+	notify->queue[notify->tail++ % NOTIFIER_QUEUE_SIZE] = event;
+	if (notify->tail - notify->head > notify->stats.queued_max)
+		notify->stats.queued_max = notify->tail - notify->head;
+
+	if (notify->dispatching) {
+		spin_unlock_irq(&notify->lock, flags);
+		return;
+	}
+
+	notify->dispatching = 1;
+
+	while (notify->head != notify->tail) {
+		e = &notify->queue[notify->head % NOTIFIER_QUEUE_SIZE];
+		event = *e;
+		notify->head++;
+
+		spin_unlock_irq(&notify->lock, flags);
+		notifier_deliver(notify, &event);
+		spin_lock_irq(&notify->lock, flags);
+	}
+
+	notify->dispatching = 0;
+
+	spin_unlock_irq(&notify->lock, flags);
+}
+
+int notifier_notify_remote(void *payload, uint32_t size)
+{
+	struct notify_remote *remote = payload;
+
+	if (size < offsetof(struct notify_remote, data) ||
+	    remote->id >= NOTIFIER_ID_COUNT)
+		return -EINVAL;
+
+	notifier_queue(remote->id, remote->message, remote->data,
+		       size - offsetof(struct notify_remote, data));
+
+	return 0;
+}
+
+void notifier_event(struct notify_data *notify_data)
+{
+	struct notify_remote remote;
 	struct idc_msg notify_msg = { IDC_MSG_NOTIFY, IDC_MSG_NOTIFY_EXT };
 	int i = 0;
 
-	spin_lock(&notify->lock);
+	if (notify_data->id >= NOTIFIER_ID_COUNT ||
+	    notify_data->data_size > sizeof(remote.data)) {
+		trace_idc_error("notifier_event() error: id %d data size %u",
+				notify_data->id, notify_data->data_size);
+		return;
+	}
 
-	_notify_data = *notify_data;
-	dcache_writeback_region(_notify_data.data, _notify_data.data_size);
-	dcache_writeback_region(&_notify_data, sizeof(_notify_data));
+	/* event data of the caller is gone once other cores run it */
+	remote.id = notify_data->id;
+	remote.message = notify_data->message;
+	if (notify_data->data_size)
+		assert(!memcpy_s(remote.data, sizeof(remote.data),
+				 notify_data->data, notify_data->data_size));
+	notify_msg.size = offsetof(struct notify_remote, data) +
+		notify_data->data_size;
+	notify_msg.payload = &remote;
 
 	/* notify selected targets */
 	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
-		if (_notify_data.target_core_mask & (1 << i)) {
+		if (notify_data->target_core_mask & (1 << i)) {
 			if (i == cpu_get_id()) {
-				notifier_notify();
+				notifier_queue(notify_data->id,
+					       notify_data->message,
+					       notify_data->data,
+					       notify_data->data_size);
 			} else if (cpu_is_core_enabled(i)) {
+				/* repeated events pending on a busy core are
+				 * delivered once
+				 */
 				notify_msg.core = i;
-				idc_send_msg(&notify_msg, IDC_BLOCKING);
+				idc_send_msg(&notify_msg, IDC_COALESCE);
 			}
 		}
 	}
+}
 
-	spin_unlock(&notify->lock);
+void notifier_stats_get(struct notify_stats *stats)
+{
+	struct notify *notify = *arch_notify_get();
+	uint32_t flags;
+
+	spin_lock_irq(&notify->lock, flags);
+	*stats = notify->stats;
+	spin_unlock_irq(&notify->lock, flags);
 }
 
 void init_system_notify(struct sof *sof)
 {
 	struct notify **notify = arch_notify_get();
+	int i;
+
 	*notify = rzalloc(RZONE_SYS, SOF_MEM_CAPS_RAM, sizeof(**notify));
 
-	list_init(&(*notify)->list);
+	for (i = 0; i < NOTIFIER_ID_COUNT; i++)
+		list_init(&(*notify)->list[i]);
 	spinlock_init(&(*notify)->lock);
 }
 
 void free_system_notify(void)
 {
 	struct notify *notify = *arch_notify_get();
+	uint32_t flags;
+	int i;
 
-	spin_lock(&notify->lock);
-	list_item_del(&notify->list);
-	spin_unlock(&notify->lock);
+	spin_lock_irq(&notify->lock, flags);
+	for (i = 0; i < NOTIFIER_ID_COUNT; i++)
+		list_item_del(&notify->list[i]);
+	spin_unlock_irq(&notify->lock, flags);
 }
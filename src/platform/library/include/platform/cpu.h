@@ -8,9 +8,13 @@
 #ifndef __INCLUDE_LIB_PLATFORM_CPU__
 #define __INCLUDE_LIB_PLATFORM_CPU__
 
-#define PLATFORM_CORE_COUNT	1
+#include <config.h>
 
-#define MAX_CORE_COUNT	1
+/** \brief Number of emulated DSP cores */
+#define PLATFORM_CORE_COUNT	CONFIG_CORE_COUNT
+
+/** \brief Maximum allowed number of emulated DSP cores */
+#define MAX_CORE_COUNT	8
 
 #define PLATFORM_MASTER_CORE_ID	0
 
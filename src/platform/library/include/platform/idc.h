@@ -8,18 +8,21 @@
 #ifndef __INCLUDE_LIB_PLATFORM_IDC_H__
 #define __INCLUDE_LIB_PLATFORM_IDC_H__
 
+#include <arch/idc.h>
+
 static inline int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 {
-	return 0;
+	return arch_idc_send_msg(msg, mode);
 }
 
 static inline void idc_process_msg_queue(void)
 {
+	arch_idc_process_msg_queue();
 }
 
 static inline int idc_init(void)
 {
-	return 0;
+	return arch_idc_init();
 }
 
 #endif
@@ -513,7 +513,7 @@ static void edf_schedule_idle(void)
 
 		/* run task if we find any queued */
 		if (task->state == SOF_TASK_STATE_QUEUED) {
-			ret = task->func(task->data);
+			ret = schedule_task_run(task);
 
 			if (ret == 0) {
 				/* task done, remove it from the list */
@@ -192,7 +192,7 @@ static void run_ll(struct ll_schedule_data *queue, uint32_t *flags)
 		if (ll_task->state == SOF_TASK_STATE_PENDING) {
 			/* work can run in non atomic context */
 			spin_unlock_irq(&queue->lock, *flags);
-			reschedule_usecs = ll_task->func(ll_task->data);
+			reschedule_usecs = schedule_task_run(ll_task);
 			spin_lock_irq(&queue->lock, *flags);
 
 			/* do we need reschedule this work ? */
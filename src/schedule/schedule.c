@@ -8,6 +8,39 @@
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/edf_schedule.h>
 #include <sof/schedule/ll_schedule.h>
+#include <sof/alloc.h>
+#include <sof/clk.h>
+#include <sof/cpu.h>
+#include <sof/math/numbers.h>
+#include <platform/platform.h>
+#include <platform/clk.h>
+#include <platform/timer.h>
+#include <sof/drivers/timer.h>
+
+/* running activity totals of a core in ticks, exclusive of nested runs */
+struct schedule_load_time {
+	uint32_t idle;
+	uint32_t sched[SOF_SCHEDULE_COUNT];
+	uint32_t irq[SCHEDULE_LOAD_IRQS];
+};
+
+/* per-core load, shared between cores */
+struct schedule_load {
+	uint32_t busy;		/* ticks spent running tasks, wraps */
+	uint32_t busy_last;	/* busy at the start of the current window */
+	uint32_t depth;		/* nesting of preempting task runs */
+	uint32_t load;		/* busy per mille of the last window */
+	uint64_t window_start;	/* start of the current window */
+
+	uint32_t nested;	/* ticks of runs nested in the current one */
+	uint32_t idle_mark;	/* nested at idle entry */
+	uint64_t idle_start;
+	struct schedule_load_time time;
+	struct schedule_load_time time_last;	/* time at window start */
+	struct schedule_load_stats stats;	/* last window */
+};
+
+static struct schedule_load *sch_load;
 
 static const struct scheduler_ops *schedulers[SOF_SCHEDULE_COUNT] = {
 	&schedule_edf_ops,              /* SOF_SCHEDULE_EDF */
@@ -79,12 +112,197 @@ void schedule_task_complete(struct task *task)
 		task->ops->schedule_task_complete(task);
 }
 
+/* time of a run without the runs nested in it since mark was taken */
+static uint32_t schedule_load_exclusive(struct schedule_load *load,
+					uint32_t mark, uint32_t run)
+{
+	uint32_t nested = load->nested - mark;
+
+	load->nested = mark + run;
+
+	return run - nested;
+}
+
+uint64_t schedule_task_run(struct task *task)
+{
+	struct schedule_load *load = &sch_load[cpu_get_id()];
+	uint32_t mark = load->nested;
+	uint64_t start = platform_timer_get(platform_timer);
+	uint64_t ret;
+	uint32_t run;
+
+	load->depth++;
+
+	ret = task->func(task->data);
+
+	run = platform_timer_get(platform_timer) - start;
+
+	/* the master core reads the worst case while the task runs */
+	if (task->run_max && run > *task->run_max)
+		*task->run_max = run;
+
+	load->time.sched[task->type] += schedule_load_exclusive(load, mark,
+								 run);
+
+	/* tasks preempting another one are already covered by its time */
+	if (!--load->depth)
+		load->busy += run;
+
+	return ret;
+}
+
+void schedule_load_idle_enter(void)
+{
+	struct schedule_load *load = &sch_load[cpu_get_id()];
+
+	load->idle_mark = load->nested;
+	load->idle_start = platform_timer_get(platform_timer);
+}
+
+void schedule_load_idle_exit(void)
+{
+	struct schedule_load *load = &sch_load[cpu_get_id()];
+	uint32_t run = platform_timer_get(platform_timer) - load->idle_start;
+
+	/* interrupts waking the core are accounted on their own */
+	load->time.idle += schedule_load_exclusive(load, load->idle_mark, run);
+}
+
+uint32_t schedule_load_irq_enter(void)
+{
+	/* interrupts may come before the scheduler is initialised */
+	return sch_load ? sch_load[cpu_get_id()].nested : 0;
+}
+
+void schedule_load_irq_exit(int irq, uint32_t mark, uint32_t run)
+{
+	struct schedule_load *load;
+
+	if (!sch_load || irq >= SCHEDULE_LOAD_IRQS)
+		return;
+
+	load = &sch_load[cpu_get_id()];
+	load->time.irq[irq] += schedule_load_exclusive(load, mark, run);
+}
+
+uint32_t schedule_task_cycles(struct task *task)
+{
+	uint64_t ticks_per_sec = clock_ms_to_ticks(PLATFORM_DEFAULT_CLOCK,
+						   1000);
+
+	/* only tasks given an uncached slot are measured */
+	if (!task->run_max)
+		return 0;
+
+	return (uint64_t)*task->run_max *
+		clock_get_freq(CLK_CPU(task->core)) / ticks_per_sec;
+}
+
+static uint32_t schedule_load_permille(uint32_t ticks, uint64_t window)
+{
+	return MIN((uint64_t)ticks * 1000 / window, 1000);
+}
+
+/* break the window of a core down to activities */
+static void schedule_load_stats_update(struct schedule_load *load,
+				       uint64_t window)
+{
+	struct schedule_load_time time = load->time;
+	struct schedule_load_stats *stats = &load->stats;
+	uint32_t irq_max = 0;
+	uint32_t irq_sum = 0;
+	uint32_t irq;
+	int i;
+
+	stats->idle = schedule_load_permille(time.idle -
+					     load->time_last.idle, window);
+
+	for (i = 0; i < SOF_SCHEDULE_COUNT; i++)
+		stats->sched[i] = schedule_load_permille(time.sched[i] -
+				load->time_last.sched[i], window);
+
+	for (i = 0; i < SCHEDULE_LOAD_IRQS; i++) {
+		irq = time.irq[i] - load->time_last.irq[i];
+		irq_sum += irq;
+		if (irq > irq_max) {
+			irq_max = irq;
+			stats->irq_top = i;
+		}
+	}
+
+	stats->irq = schedule_load_permille(irq_sum, window);
+	stats->irq_top_load = schedule_load_permille(irq_max, window);
+
+	load->time_last = time;
+}
+
+void schedule_load_update(void)
+{
+	struct schedule_load *load;
+	uint64_t now = platform_timer_get(platform_timer);
+	uint64_t window;
+	uint32_t busy;
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		load = &sch_load[i];
+		busy = load->busy;
+		window = now - load->window_start;
+
+		if (window) {
+			load->load = schedule_load_permille(busy -
+							    load->busy_last,
+							    window);
+			schedule_load_stats_update(load, window);
+		}
+
+		load->busy_last = busy;
+		load->window_start = now;
+	}
+}
+
+uint32_t schedule_load_get(int core)
+{
+	return sch_load[core].load;
+}
+
+void schedule_load_stats_get(int core, struct schedule_load_stats *stats)
+{
+	*stats = sch_load[core].stats;
+}
+
+uint32_t schedule_load_sample(int core, struct schedule_load_window *win)
+{
+	uint64_t now = platform_timer_get(platform_timer);
+	uint32_t busy = sch_load[core].busy;
+	uint32_t load = 0;
+
+	if (now != win->start)
+		load = MIN((uint64_t)(busy - win->busy) * 1000 /
+			   (now - win->start), 1000);
+
+	win->busy = busy;
+	win->start = now;
+
+	return load;
+}
+
 int scheduler_init(void)
 {
 	struct schedule_data **sch = arch_schedule_get_data();
 	int i = 0;
 	int ret = 0;
 
+	/* load of all cores is kept by the master core */
+	if (cpu_get_id() == PLATFORM_MASTER_CORE_ID) {
+		sch_load = rzalloc(RZONE_SYS | RZONE_FLAG_UNCACHED,
+				   SOF_MEM_CAPS_RAM,
+				   sizeof(*sch_load) * PLATFORM_CORE_COUNT);
+		for (i = 0; i < PLATFORM_CORE_COUNT; i++)
+			sch_load[i].window_start =
+				platform_timer_get(platform_timer);
+	}
+
 	/* init scheduler_data */
 	*sch = rzalloc(RZONE_SYS, SOF_MEM_CAPS_RAM, sizeof(**sch));
 
@@ -41,6 +41,9 @@ int do_task_master_core(struct sof *sof)
 	/* init default audio components */
 	sys_comp_init();
 
+	/* init pool of freed buffer memory */
+	buffer_pool_init();
+
 	/* init self-registered modules */
 	sys_module_init();
 
@@ -59,7 +62,9 @@ int do_task_master_core(struct sof *sof)
 	while (1) {
 		/* sleep until next IPC or DMA */
 		sa_enter_idle(sof);
+		schedule_load_idle_enter();
 		wait_for_interrupt(0);
+		schedule_load_idle_exit();
 
 		/* now process any IPC messages to host */
 		ipc_process_msg_queue();
@@ -77,7 +82,9 @@ int do_task_slave_core(struct sof *sof)
 	/* main audio IDC processing loop */
 	while (1) {
 		/* sleep until next IDC */
+		schedule_load_idle_enter();
 		wait_for_interrupt(0);
+		schedule_load_idle_exit();
 
 		/* schedule any idle tasks */
 		schedule();
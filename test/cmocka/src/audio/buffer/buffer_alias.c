@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/ipc.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+/* upstream, in-place and downstream components */
+static struct comp_dev comp[3];
+
+struct buffer_alias_data {
+	struct comp_buffer *src;
+	struct comp_buffer *snk;
+};
+
+static int setup(void **state)
+{
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = 64
+	};
+	struct buffer_alias_data *data = calloc(sizeof(*data), 1);
+
+	data->src = buffer_new(&test_buf_desc);
+	data->snk = buffer_new(&test_buf_desc);
+	data->src->source = &comp[0];
+	data->src->sink = &comp[1];
+	data->snk->source = &comp[1];
+	data->snk->sink = &comp[2];
+	list_init(&data->src->source_list);
+	list_init(&data->src->sink_list);
+	list_init(&data->snk->source_list);
+	list_init(&data->snk->sink_list);
+
+	*state = data;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct buffer_alias_data *data = *state;
+
+	buffer_free(data->src);
+	buffer_free(data->snk);
+	free(data);
+
+	return 0;
+}
+
+static void test_audio_buffer_alias_shares_memory(void **state)
+{
+	struct buffer_alias_data *data = *state;
+
+	assert_int_equal(buffer_alias(data->snk, data->src), 0);
+
+	assert_ptr_equal(data->snk->addr, data->src->addr);
+	assert_ptr_equal(data->snk->end_addr, data->src->end_addr);
+	assert_int_equal(data->snk->size, data->src->size);
+	assert_ptr_equal(data->snk->alias_source, data->src);
+	assert_ptr_equal(data->src->alias_sink, data->snk);
+
+	/* a buffer can only have one alias */
+	assert_int_equal(buffer_alias(data->src, data->snk), -EINVAL);
+}
+
+static void test_audio_buffer_alias_in_place(void **state)
+{
+	struct buffer_alias_data *data = *state;
+
+	assert_int_equal(buffer_alias(data->snk, data->src), 0);
+
+	comp_update_buffer_produce(data->src, 32);
+	assert_int_equal(data->src->free, 32);
+
+	/* processed data stays in place and still takes space upstream */
+	comp_update_buffer_produce(data->snk, 16);
+	comp_update_buffer_consume(data->src, 16);
+	assert_ptr_equal(data->snk->w_ptr, data->src->r_ptr);
+	assert_int_equal(data->snk->avail, 16);
+	assert_int_equal(data->src->avail, 16);
+	assert_int_equal(data->src->free, 32);
+
+	/* space is released once consumed downstream */
+	comp_update_buffer_consume(data->snk, 16);
+	assert_int_equal(data->snk->avail, 0);
+	assert_int_equal(data->src->free, 48);
+}
+
+static void test_audio_buffer_alias_resize_source(void **state)
+{
+	struct buffer_alias_data *data = *state;
+
+	assert_int_equal(buffer_alias(data->snk, data->src), 0);
+
+	/* alias can't follow the new backing store of its source */
+	assert_int_equal(buffer_set_size(data->src, 128), 0);
+	assert_null(data->src->alias_sink);
+	assert_null(data->snk->alias_source);
+	assert_null(data->snk->addr);
+
+	buffer_unalias(data->snk);
+	assert_non_null(data->snk->addr);
+	assert_ptr_not_equal(data->snk->addr, data->src->addr);
+	assert_int_equal(data->snk->size, 64);
+	assert_int_equal(data->snk->free, 64);
+}
+
+static void test_audio_buffer_alias_unalias(void **state)
+{
+	struct buffer_alias_data *data = *state;
+
+	assert_int_equal(buffer_alias(data->snk, data->src), 0);
+
+	buffer_unalias(data->snk);
+	assert_null(data->src->alias_sink);
+	assert_null(data->snk->alias_source);
+	assert_non_null(data->snk->addr);
+	assert_ptr_not_equal(data->snk->addr, data->src->addr);
+	assert_int_equal(data->src->free, 64);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_alias_shares_memory, setup,
+			 teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_alias_in_place, setup, teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_alias_resize_source, setup,
+			 teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_alias_unalias, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
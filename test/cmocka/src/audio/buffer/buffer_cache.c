@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/ipc.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#include "buffer_fixture.h"
+
+static void test_audio_buffer_cache_batch_writeback(void **state)
+{
+	struct buffer_fixture *data = *state;
+	struct comp_buffer *buf = data->buf;
+
+	data->sink.is_dma_connected = 1;
+
+	/* chunks produced for DMA are only recorded */
+	comp_update_buffer_produce(buf, 16);
+	comp_update_buffer_produce(buf, 16);
+	comp_update_buffer_produce(buf, 32);
+
+	assert_int_equal(buf->cache_ops, 0);
+	assert_int_equal(buf->cache_pending, 64);
+
+	/* and written back in one go */
+	buffer_cache_sync(buf);
+
+	assert_int_equal(buf->cache_ops, 1);
+	assert_int_equal(buf->cache_pending, 0);
+
+	/* nothing left for the next sync */
+	buffer_cache_sync(buf);
+
+	assert_int_equal(buf->cache_ops, 1);
+}
+
+static void test_audio_buffer_cache_batch_wrap(void **state)
+{
+	struct buffer_fixture *data = *state;
+	struct comp_buffer *buf = data->buf;
+
+	data->sink.is_dma_connected = 1;
+
+	comp_update_buffer_produce(buf, 192);
+	comp_update_buffer_consume(buf, 192);
+	buffer_cache_sync(buf);
+
+	assert_int_equal(buf->cache_ops, 1);
+
+	/* data wrapping the end of the buffer needs two operations */
+	comp_update_buffer_produce(buf, 32);
+	comp_update_buffer_produce(buf, 64);
+	assert_ptr_equal(buf->w_ptr, (char *)buf->addr + 32);
+
+	buffer_cache_sync(buf);
+
+	assert_int_equal(buf->cache_ops, 3);
+	assert_int_equal(buf->cache_pending, 0);
+}
+
+static void test_audio_buffer_cache_invalidate(void **state)
+{
+	struct buffer_fixture *data = *state;
+	struct comp_buffer *buf = data->buf;
+
+	data->source.is_dma_connected = 1;
+
+	/* DMA data is invalidated before the sink can read it */
+	comp_update_buffer_produce(buf, 64);
+
+	assert_int_equal(buf->cache_ops, 1);
+	assert_int_equal(buf->cache_pending, 0);
+
+	buffer_cache_sync(buf);
+
+	assert_int_equal(buf->cache_ops, 1);
+	assert_int_equal(buf->cache_ops_sync, 1);
+}
+
+static void test_audio_buffer_cache_no_dma(void **state)
+{
+	struct buffer_fixture *data = *state;
+	struct comp_buffer *buf = data->buf;
+
+	comp_update_buffer_produce(buf, 64);
+	comp_update_buffer_consume(buf, 32);
+	buffer_cache_sync(buf);
+
+	assert_int_equal(buf->cache_ops, 0);
+	assert_int_equal(buf->cache_pending, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_cache_batch_writeback,
+			 buffer_fixture_setup, buffer_fixture_teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_cache_batch_wrap,
+			 buffer_fixture_setup, buffer_fixture_teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_cache_invalidate,
+			 buffer_fixture_setup, buffer_fixture_teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_cache_no_dma,
+			 buffer_fixture_setup, buffer_fixture_teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
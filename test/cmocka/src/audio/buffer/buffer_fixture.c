@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/ipc.h>
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include "buffer_fixture.h"
+
+int buffer_fixture_setup(void **state)
+{
+	struct sof_ipc_buffer desc = {
+		.size = 256,
+	};
+	struct buffer_fixture *data = calloc(1, sizeof(*data));
+
+	if (!data)
+		return -ENOMEM;
+
+	data->buf = buffer_new(&desc);
+	if (!data->buf) {
+		free(data);
+		return -ENOMEM;
+	}
+
+	list_init(&data->buf->source_list);
+	list_init(&data->buf->sink_list);
+	data->buf->source = &data->source;
+	data->buf->sink = &data->sink;
+
+	*state = data;
+
+	return 0;
+}
+
+int buffer_fixture_teardown(void **state)
+{
+	struct buffer_fixture *data = *state;
+
+	buffer_free(data->buf);
+	free(data);
+
+	return 0;
+}
@@ -0,0 +1,17 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2019 Intel Corporation. All rights reserved.
+ */
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+
+/* a single buffer connected between two dummy components */
+struct buffer_fixture {
+	struct comp_dev source;
+	struct comp_dev sink;
+	struct comp_buffer *buf;
+};
+
+int buffer_fixture_setup(void **state);
+int buffer_fixture_teardown(void **state);
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/ipc.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+static int setup(void **state)
+{
+	(void)state;
+
+	buffer_pool_init();
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	(void)state;
+
+	buffer_pool_flush();
+
+	return 0;
+}
+
+static void test_audio_buffer_pool_reuse(void **state)
+{
+	(void)state;
+
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = 256
+	};
+	struct buffer_pool_stats stats;
+	struct comp_buffer *buf;
+	void *addr;
+
+	buffer_pool_flush();
+
+	buf = buffer_new(&test_buf_desc);
+	assert_non_null(buf);
+	addr = buf->addr;
+	buffer_free(buf);
+
+	buffer_pool_get_stats(&stats);
+	assert_int_equal(stats.entries, 1);
+
+	/* same size class gets the retained backing store */
+	buf = buffer_new(&test_buf_desc);
+	assert_non_null(buf);
+	assert_ptr_equal(buf->addr, addr);
+	assert_int_equal(buf->avail, 0);
+	assert_int_equal(buf->free, 256);
+
+	buffer_pool_get_stats(&stats);
+	assert_int_equal(stats.hits, 1);
+	assert_int_equal(stats.entries, 0);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_pool_size_class(void **state)
+{
+	(void)state;
+
+	struct sof_ipc_buffer small_desc = {
+		.size = 256
+	};
+	struct sof_ipc_buffer large_desc = {
+		.size = 1024
+	};
+	struct buffer_pool_stats before;
+	struct buffer_pool_stats after;
+	struct comp_buffer *buf;
+
+	buffer_pool_flush();
+
+	buf = buffer_new(&small_desc);
+	assert_non_null(buf);
+	buffer_free(buf);
+
+	buffer_pool_get_stats(&before);
+
+	/* different size class is served from the heap */
+	buf = buffer_new(&large_desc);
+	assert_non_null(buf);
+
+	buffer_pool_get_stats(&after);
+	assert_int_equal(after.hits, before.hits);
+	assert_int_equal(after.misses, before.misses + 1);
+	assert_int_equal(after.entries, 1);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_pool_limit(void **state)
+{
+	(void)state;
+
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = CONFIG_BUFFER_POOL_SIZE / 2
+	};
+	struct buffer_pool_stats stats;
+	struct comp_buffer *buf[3];
+	int i;
+
+	buffer_pool_flush();
+
+	for (i = 0; i < ARRAY_SIZE(buf); i++) {
+		buf[i] = buffer_new(&test_buf_desc);
+		assert_non_null(buf[i]);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(buf); i++)
+		buffer_free(buf[i]);
+
+	/* oldest backing store went back to the heap */
+	buffer_pool_get_stats(&stats);
+	assert_int_equal(stats.entries, 2);
+	assert_true(stats.bytes <= CONFIG_BUFFER_POOL_SIZE);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_buffer_pool_reuse),
+		cmocka_unit_test(test_audio_buffer_pool_size_class),
+		cmocka_unit_test(test_audio_buffer_pool_limit),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, setup, teardown);
+}
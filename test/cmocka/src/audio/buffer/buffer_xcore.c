@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/ipc.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#include "buffer_fixture.h"
+
+static int setup(void **state)
+{
+	struct buffer_fixture *data;
+	int ret;
+
+	ret = buffer_fixture_setup(state);
+	if (ret < 0)
+		return ret;
+
+	data = *state;
+	data->buf->xcore = true;
+
+	return 0;
+}
+
+static void test_audio_buffer_xcore_publish(void **state)
+{
+	struct buffer_fixture *data = *state;
+	struct comp_buffer *buf = data->buf;
+
+	/* produced data takes space at once */
+	comp_update_buffer_produce(buf, 48);
+	comp_update_buffer_produce(buf, 16);
+	assert_int_equal(buf->free, 192);
+
+	/* but the sink sees it only once it is written back */
+	buffer_xcore_pull(buf);
+	assert_int_equal(buf->avail, 0);
+
+	buffer_cache_sync(buf);
+	assert_int_equal(buf->cache_ops, 1);
+	assert_int_equal(buf->cache_pending, 0);
+
+	buffer_xcore_pull(buf);
+	assert_int_equal(buf->avail, 64);
+	assert_int_equal(buf->visible, 64);
+}
+
+static void test_audio_buffer_xcore_reclaim(void **state)
+{
+	struct buffer_fixture *data = *state;
+	struct comp_buffer *buf = data->buf;
+
+	comp_update_buffer_produce(buf, 128);
+	buffer_cache_sync(buf);
+	buffer_xcore_pull(buf);
+
+	comp_update_buffer_consume(buf, 96);
+	assert_int_equal(buf->avail, 32);
+	assert_ptr_equal(buf->r_ptr, (char *)buf->addr + 96);
+
+	/* released space is picked up by the source */
+	assert_int_equal(buf->free, 128);
+	buffer_xcore_reclaim(buf);
+	assert_int_equal(buf->free, 224);
+}
+
+static void test_audio_buffer_xcore_wrap(void **state)
+{
+	struct buffer_fixture *data = *state;
+	struct comp_buffer *buf = data->buf;
+
+	comp_update_buffer_produce(buf, 192);
+	buffer_cache_sync(buf);
+	buffer_xcore_pull(buf);
+	comp_update_buffer_consume(buf, 192);
+	buffer_xcore_reclaim(buf);
+
+	/* data wrapping the end of the buffer needs two write backs */
+	comp_update_buffer_produce(buf, 96);
+	assert_ptr_equal(buf->w_ptr, (char *)buf->addr + 32);
+	buffer_cache_sync(buf);
+	assert_int_equal(buf->cache_ops, 3);
+
+	buffer_xcore_pull(buf);
+	assert_int_equal(buf->avail, 96);
+
+	comp_update_buffer_consume(buf, 96);
+	assert_ptr_equal(buf->r_ptr, buf->w_ptr);
+	assert_int_equal(buf->avail, 0);
+
+	buffer_xcore_reclaim(buf);
+	assert_int_equal(buf->free, 256);
+}
+
+static void test_audio_buffer_xcore_full(void **state)
+{
+	struct buffer_fixture *data = *state;
+	struct comp_buffer *buf = data->buf;
+
+	comp_update_buffer_produce(buf, 256);
+	assert_int_equal(buf->free, 0);
+	assert_ptr_equal(buf->w_ptr, buf->addr);
+
+	buffer_cache_sync(buf);
+	buffer_xcore_pull(buf);
+	assert_int_equal(buf->avail, 256);
+
+	/* reset drops both positions */
+	buffer_reset_pos(buf);
+	assert_int_equal(buf->produced, 0);
+	assert_int_equal(buf->consumed, 0);
+	assert_int_equal(buf->free, 256);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_xcore_publish, setup,
+			 buffer_fixture_teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_xcore_reclaim, setup,
+			 buffer_fixture_teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_xcore_wrap, setup,
+			 buffer_fixture_teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_buffer_xcore_full, setup,
+			 buffer_fixture_teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmocka.h>
+
+/* stereo s32 frames */
+#define BYPASS_FRAME_BYTES	8
+
+static int copy_calls;
+
+static int bypass_test_copy(struct comp_dev *dev)
+{
+	(void)dev;
+
+	copy_calls++;
+
+	return 0;
+}
+
+static struct comp_driver bypass_test_drv = {
+	.type = SOF_COMP_EQ_IIR,
+	.ops = {
+		.copy = bypass_test_copy,
+	},
+};
+
+struct bypass_test_data {
+	struct comp_dev up;
+	struct comp_dev dev;
+	struct comp_dev down;
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+};
+
+static void bypass_test_comp_init(struct comp_dev *dev)
+{
+	dev->drv = &bypass_test_drv;
+	dev->params.frame_fmt = SOF_IPC_FRAME_S32_LE;
+	dev->params.channels = 2;
+	list_init(&dev->bsource_list);
+	list_init(&dev->bsink_list);
+}
+
+static struct comp_buffer *bypass_test_buffer(uint32_t size)
+{
+	struct sof_ipc_buffer desc = {
+		.size = size,
+	};
+	struct comp_buffer *buffer = buffer_new(&desc);
+
+	list_init(&buffer->source_list);
+	list_init(&buffer->sink_list);
+
+	return buffer;
+}
+
+static int setup(void **state)
+{
+	struct bypass_test_data *data = calloc(sizeof(*data), 1);
+
+	bypass_test_comp_init(&data->up);
+	bypass_test_comp_init(&data->dev);
+	bypass_test_comp_init(&data->down);
+
+	data->source = bypass_test_buffer(64);
+	data->sink = bypass_test_buffer(40);
+
+	data->source->source = &data->up;
+	data->source->sink = &data->dev;
+	data->sink->source = &data->dev;
+	data->sink->sink = &data->down;
+	list_item_append(&data->source->sink_list, &data->dev.bsource_list);
+	list_item_append(&data->sink->source_list, &data->dev.bsink_list);
+
+	copy_calls = 0;
+	*state = data;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct bypass_test_data *data = *state;
+
+	buffer_free(data->source);
+	buffer_free(data->sink);
+	free(data);
+
+	return 0;
+}
+
+/* produce frames with values start, start + 1, ... into buffer */
+static void bypass_test_produce(struct comp_buffer *buffer, int32_t start,
+				int frames)
+{
+	int32_t *w;
+	int i;
+
+	for (i = 0; i < frames * 2; i++) {
+		w = buffer_write_frag_s32(buffer, i);
+		*w = start + i;
+	}
+
+	comp_update_buffer_produce(buffer, frames * BYPASS_FRAME_BYTES);
+}
+
+static void bypass_test_check(struct comp_buffer *buffer, int32_t start,
+			      int frames)
+{
+	int32_t *r;
+	int i;
+
+	assert_int_equal(buffer->avail, frames * BYPASS_FRAME_BYTES);
+
+	for (i = 0; i < frames * 2; i++) {
+		r = buffer_read_frag_s32(buffer, i);
+		assert_int_equal(*r, start + i);
+	}
+
+	comp_update_buffer_consume(buffer, frames * BYPASS_FRAME_BYTES);
+}
+
+static void test_audio_comp_bypass_skips_copy(void **state)
+{
+	struct bypass_test_data *data = *state;
+
+	comp_set_bypass(&data->dev, true);
+
+	bypass_test_produce(data->source, 100, 4);
+	assert_int_equal(comp_copy(&data->dev), 0);
+
+	assert_int_equal(copy_calls, 0);
+	assert_int_equal(data->source->avail, 0);
+	bypass_test_check(data->sink, 100, 4);
+}
+
+static void test_audio_comp_bypass_wrap(void **state)
+{
+	struct bypass_test_data *data = *state;
+	int i;
+
+	comp_set_bypass(&data->dev, true);
+
+	/* buffers of different size wrap at different frames */
+	for (i = 0; i < 8; i++) {
+		bypass_test_produce(data->source, i * 100, 3);
+		assert_int_equal(comp_copy(&data->dev), 0);
+		bypass_test_check(data->sink, i * 100, 3);
+	}
+
+	assert_int_equal(copy_calls, 0);
+}
+
+static void test_audio_comp_bypass_in_place(void **state)
+{
+	struct bypass_test_data *data = *state;
+
+	assert_int_equal(buffer_alias(data->sink, data->source), 0);
+	comp_set_bypass(&data->dev, true);
+
+	bypass_test_produce(data->source, 200, 4);
+	assert_int_equal(comp_copy(&data->dev), 0);
+
+	/* frames are handed over without moving them */
+	assert_ptr_equal(data->sink->r_ptr, data->source->addr);
+	bypass_test_check(data->sink, 200, 4);
+}
+
+static void test_audio_comp_bypass_off(void **state)
+{
+	struct bypass_test_data *data = *state;
+
+	comp_set_bypass(&data->dev, true);
+	comp_set_bypass(&data->dev, false);
+
+	bypass_test_produce(data->source, 0, 4);
+	assert_int_equal(comp_copy(&data->dev), 0);
+
+	assert_int_equal(copy_calls, 1);
+	assert_int_equal(data->sink->avail, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown
+			(test_audio_comp_bypass_skips_copy, setup, teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_comp_bypass_wrap, setup, teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_comp_bypass_in_place, setup, teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_comp_bypass_off, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -25,6 +25,26 @@ void *rzalloc(int zone, uint32_t caps, size_t bytes)
 	return calloc(bytes, 1);
 }
 
+void *rballoc(int zone, uint32_t caps, size_t bytes)
+{
+	(void)zone;
+	(void)caps;
+
+	return malloc(bytes);
+}
+
+void rfree(void *ptr)
+{
+	free(ptr);
+}
+
+bool arena_contains(void *ptr)
+{
+	(void)ptr;
+
+	return false;
+}
+
 void pipeline_xrun(struct pipeline *p, struct comp_dev *dev, int32_t bytes)
 {
 }
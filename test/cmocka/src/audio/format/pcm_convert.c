@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/format/pcm_converter.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+/* odd block size so vector code variants also process tails */
+#define TEST_BLOCK		1021
+
+#define TEST_S16_COUNT		65536
+#define TEST_S24_STRIDE		257
+#define TEST_S24_COUNT		((1 << 24) / TEST_S24_STRIDE + 2)
+#define TEST_S32_STRIDE		65521
+#define TEST_S32_COUNT		(0xffffffffu / TEST_S32_STRIDE + 2)
+#define TEST_FLOAT_PATTERNS	65536
+
+/* rounding ties and saturation edges */
+static const float test_float_special[] = {
+	1.0f, -1.0f, 0.5f, -0.5f, 2.0f, -2.0f,
+	0.5f / 32768, -0.5f / 32768, 1.5f / 32768, -1.5f / 32768,
+	32767.5f / 32768, -32767.5f / 32768, -32768.5f / 32768,
+	0.5f / 8388608, -0.5f / 8388608, 2.5f / 8388608, -2.5f / 8388608,
+	8388607.0f / 8388608, -8388607.5f / 8388608,
+	0x1.fffffep-2f / 32768, -0x1.fffffep-2f / 32768,
+	0x1.fffffep-1f, -0x1.fffffep-1f,
+};
+
+void __panic(uint32_t p, char *filename, uint32_t linenum)
+{
+	(void)p;
+	(void)filename;
+	(void)linenum;
+
+	fail();
+}
+
+static uint32_t test_count(enum sof_ipc_frame fmt)
+{
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return TEST_S16_COUNT;
+	case SOF_IPC_FRAME_S24_4LE:
+		return TEST_S24_COUNT;
+	case SOF_IPC_FRAME_S32_LE:
+		return TEST_S32_COUNT;
+	default:
+		return TEST_FLOAT_PATTERNS + ARRAY_SIZE(test_float_special);
+	}
+}
+
+/* every s16 value, strides over s24 and s32 with both ends and a walk
+ * over float bit patterns covering all exponents, infinities and NaNs
+ */
+static void test_input(enum sof_ipc_frame fmt, uint32_t i, void *x)
+{
+	int32_t v;
+	uint32_t bits;
+
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		*(int16_t *)x = (int16_t)i;
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		v = INT24_MINVALUE + (int32_t)i * TEST_S24_STRIDE;
+		if (v > INT24_MAXVALUE)
+			v = INT24_MAXVALUE;
+
+		/* container bits are ignored */
+		*(uint32_t *)x = ((uint32_t)v & 0xffffff) |
+			((i * 0x9e) & 0xff) << 24;
+		break;
+	case SOF_IPC_FRAME_S32_LE:
+		if (i == TEST_S32_COUNT - 1)
+			*(int32_t *)x = INT32_MAX;
+		else
+			*(int32_t *)x = (int32_t)(0x80000000u +
+						  i * TEST_S32_STRIDE);
+		break;
+	default:
+		if (i < TEST_FLOAT_PATTERNS) {
+			bits = i * 0x10001u;
+			memcpy_s(x, sizeof(bits), &bits, sizeof(bits));
+		} else {
+			*(float *)x = test_float_special[i -
+							  TEST_FLOAT_PATTERNS];
+		}
+		break;
+	}
+}
+
+static uint32_t test_sample_bytes(enum sof_ipc_frame fmt)
+{
+	return fmt == SOF_IPC_FRAME_S16_LE ? sizeof(int16_t) :
+		sizeof(int32_t);
+}
+
+static int32_t test_raw(enum sof_ipc_frame fmt, const void *x)
+{
+	int32_t v;
+
+	if (fmt == SOF_IPC_FRAME_S16_LE)
+		return *(const int16_t *)x;
+
+	memcpy_s(&v, sizeof(v), x, sizeof(v));
+
+	return v;
+}
+
+static int64_t test_floor(double y)
+{
+	int64_t t = (int64_t)y;
+
+	return t > y ? t - 1 : t;
+}
+
+/* independent double precision model of the converters */
+static int32_t test_ref_int(double v, double scale, int32_t min,
+			    int32_t max, bool away)
+{
+	double y = v * scale;
+	int64_t t;
+
+	if (y != y)
+		return 0;
+	if (y > 4e9)
+		return max;
+	if (y < -4e9)
+		return min;
+
+	if (away && y < 0)
+		t = -test_floor(-y + 0.5);
+	else
+		t = test_floor(y + 0.5);
+
+	if (t > max)
+		return max;
+	if (t < min)
+		return min;
+
+	return t;
+}
+
+static void test_reference(enum sof_ipc_frame ifmt, const void *x,
+			   enum sof_ipc_frame ofmt, void *y)
+{
+	bool away = ifmt == SOF_IPC_FRAME_FLOAT;
+	double v;
+
+	if (ifmt == ofmt) {
+		memcpy_s(y, sizeof(int32_t), x, test_sample_bytes(ofmt));
+		return;
+	}
+
+	switch (ifmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		v = *(const int16_t *)x / 32768.0;
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		v = (((test_raw(ifmt, x) & 0xffffff) ^ 0x800000) - 0x800000) /
+			8388608.0;
+		break;
+	case SOF_IPC_FRAME_S32_LE:
+		v = test_raw(ifmt, x) / 2147483648.0;
+		break;
+	default:
+		v = *(const float *)x;
+		break;
+	}
+
+	switch (ofmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		*(int16_t *)y = test_ref_int(v, 32768.0, INT16_MIN, INT16_MAX,
+					     away);
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		*(int32_t *)y = test_ref_int(v, 8388608.0, INT24_MINVALUE,
+					     INT24_MAXVALUE, away);
+		break;
+	case SOF_IPC_FRAME_S32_LE:
+		*(int32_t *)y = test_ref_int(v, 2147483648.0, INT32_MIN,
+					     INT32_MAX, away);
+		break;
+	default:
+		*(float *)y = (float)v;
+		break;
+	}
+}
+
+static void test_convert_from(enum sof_ipc_frame ifmt)
+{
+	const struct pcm_func_map *conv;
+	int32_t in[TEST_BLOCK];
+	int32_t out[TEST_BLOCK];
+	int32_t ref;
+	uint32_t isize = test_sample_bytes(ifmt);
+	uint32_t osize;
+	uint32_t count = test_count(ifmt);
+	uint32_t n;
+	uint32_t i;
+	uint32_t j;
+	int ofmt;
+
+	for (ofmt = SOF_IPC_FRAME_S16_LE; ofmt <= SOF_IPC_FRAME_FLOAT;
+	     ofmt++) {
+		conv = pcm_get_conversion(ifmt, ofmt);
+		assert_non_null(conv);
+		osize = test_sample_bytes(ofmt);
+
+		for (i = 0; i < count; i += n) {
+			n = count - i < TEST_BLOCK ? count - i : TEST_BLOCK;
+			for (j = 0; j < n; j++)
+				test_input(ifmt, i + j,
+					   (uint8_t *)in + j * isize);
+
+			conv->func(in, out, n);
+
+			for (j = 0; j < n; j++) {
+				test_reference(ifmt, (uint8_t *)in + j * isize,
+					       ofmt, &ref);
+				assert_int_equal(test_raw(ofmt,
+						(uint8_t *)out + j * osize),
+						 test_raw(ofmt, &ref));
+			}
+		}
+	}
+}
+
+static void test_audio_pcm_convert_s16(void **state)
+{
+	(void)state;
+
+	test_convert_from(SOF_IPC_FRAME_S16_LE);
+}
+
+static void test_audio_pcm_convert_s24(void **state)
+{
+	(void)state;
+
+	test_convert_from(SOF_IPC_FRAME_S24_4LE);
+}
+
+static void test_audio_pcm_convert_s32(void **state)
+{
+	(void)state;
+
+	test_convert_from(SOF_IPC_FRAME_S32_LE);
+}
+
+static void test_audio_pcm_convert_float(void **state)
+{
+	(void)state;
+
+	test_convert_from(SOF_IPC_FRAME_FLOAT);
+}
+
+static void test_audio_pcm_convert_wrap(void **state)
+{
+	const struct pcm_func_map *conv;
+	int16_t in[10];
+	int32_t out[7];
+	struct comp_buffer source = {
+		.addr = in,
+		.end_addr = in + ARRAY_SIZE(in),
+		.size = sizeof(in),
+		.r_ptr = in + 6,
+	};
+	struct comp_buffer sink = {
+		.addr = out,
+		.end_addr = out + ARRAY_SIZE(out),
+		.size = sizeof(out),
+		.w_ptr = out + 3,
+	};
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(in); i++)
+		in[i] = i + 1;
+	memset(out, 0, sizeof(out));
+
+	/* reads samples 7..9, 0..2 and writes 5, 6, 0..3 */
+	conv = pcm_get_conversion(SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE);
+	pcm_convert(conv, &source, 1, &sink, 2, 6);
+
+	assert_int_equal(out[5], 8 << 16);
+	assert_int_equal(out[6], 9 << 16);
+	assert_int_equal(out[0], 10 << 16);
+	assert_int_equal(out[1], 1 << 16);
+	assert_int_equal(out[2], 2 << 16);
+	assert_int_equal(out[3], 3 << 16);
+	assert_int_equal(out[4], 0);
+}
+
+static void test_audio_pcm_convert_unsupported(void **state)
+{
+	(void)state;
+
+	assert_null(pcm_get_conversion(SOF_IPC_FRAME_FLOAT + 1,
+				       SOF_IPC_FRAME_S16_LE));
+	assert_null(pcm_get_conversion(SOF_IPC_FRAME_S16_LE,
+				       SOF_IPC_FRAME_FLOAT + 1));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_pcm_convert_s16),
+		cmocka_unit_test(test_audio_pcm_convert_s24),
+		cmocka_unit_test(test_audio_pcm_convert_s32),
+		cmocka_unit_test(test_audio_pcm_convert_float),
+		cmocka_unit_test(test_audio_pcm_convert_wrap),
+		cmocka_unit_test(test_audio_pcm_convert_unsupported),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
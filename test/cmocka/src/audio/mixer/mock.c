@@ -40,6 +40,13 @@ void rfree(void *ptr)
 	free(ptr);
 }
 
+bool arena_contains(void *ptr)
+{
+	(void)ptr;
+
+	return false;
+}
+
 void *_brealloc(void *ptr, int zone, uint32_t caps, size_t bytes)
 {
 	(void)zone;
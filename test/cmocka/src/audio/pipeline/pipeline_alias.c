@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/schedule/edf_schedule.h>
+#include "pipeline_mocks.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#define ALIAS_PIPELINE_ID	1
+#define ALIAS_COMPS		3
+#define ALIAS_BUFFER_BYTES	768
+
+static bool eq_flat;
+
+/* flat EQ response leaves the data unchanged */
+static int alias_test_eq_prepare(struct comp_dev *dev)
+{
+	comp_set_bypass(dev, eq_flat);
+
+	return 0;
+}
+
+static struct comp_driver drv_host = {
+	.type = SOF_COMP_HOST,
+};
+
+static struct comp_driver drv_eq = {
+	.type = SOF_COMP_EQ_FIR,
+	.ops = {
+		.prepare = alias_test_eq_prepare,
+	},
+};
+
+static struct comp_driver drv_dai = {
+	.type = SOF_COMP_DAI,
+};
+
+/* host -> eq -> dai connected by buffers */
+struct pipeline_alias_data {
+	struct pipeline p;
+	struct comp_dev *comp[ALIAS_COMPS];
+	struct comp_buffer *buffer[ALIAS_COMPS - 1];
+};
+
+static int setup(void **state)
+{
+	struct pipeline_alias_data *data = calloc(sizeof(*data), 1);
+	struct comp_driver *drv[ALIAS_COMPS] = {
+		&drv_host, &drv_eq, &drv_dai
+	};
+	struct sof_ipc_comp_config *dconfig;
+	int i;
+
+	data->p.ipc_pipe.pipeline_id = ALIAS_PIPELINE_ID;
+	data->p.ipc_pipe.frames_per_sched = 48;
+	data->p.status = COMP_STATE_INIT;
+
+	for (i = 0; i < ALIAS_COMPS; i++) {
+		data->comp[i] = calloc(COMP_SIZE(struct sof_ipc_comp_dai), 1);
+		data->comp[i]->comp.id = i;
+		data->comp[i]->comp.type = drv[i]->type;
+		data->comp[i]->comp.pipeline_id = ALIAS_PIPELINE_ID;
+		data->comp[i]->drv = drv[i];
+		data->comp[i]->params.frame_fmt = SOF_IPC_FRAME_S32_LE;
+		data->comp[i]->params.channels = 2;
+		list_init(&data->comp[i]->bsource_list);
+		list_init(&data->comp[i]->bsink_list);
+	}
+
+	/* dai takes its format from topology */
+	dconfig = COMP_GET_CONFIG(data->comp[ALIAS_COMPS - 1]);
+	dconfig->frame_fmt = SOF_IPC_FRAME_S32_LE;
+
+	/* endpoints move data with DMA */
+	data->comp[0]->is_dma_connected = 1;
+	data->comp[ALIAS_COMPS - 1]->is_dma_connected = 1;
+
+	for (i = 0; i < ALIAS_COMPS - 1; i++) {
+		data->buffer[i] = calloc(sizeof(struct comp_buffer), 1);
+		data->buffer[i]->ipc_buffer.comp.pipeline_id =
+			ALIAS_PIPELINE_ID;
+		data->buffer[i]->addr = calloc(ALIAS_BUFFER_BYTES, 1);
+		buffer_set_size(data->buffer[i], ALIAS_BUFFER_BYTES);
+		list_init(&data->buffer[i]->source_list);
+		list_init(&data->buffer[i]->sink_list);
+		pipeline_connect(data->comp[i], data->buffer[i],
+				 PPL_CONN_DIR_COMP_TO_BUFFER);
+		pipeline_connect(data->comp[i + 1], data->buffer[i],
+				 PPL_CONN_DIR_BUFFER_TO_COMP);
+	}
+
+	data->p.sched_comp = data->comp[ALIAS_COMPS - 1];
+	eq_flat = true;
+	*state = data;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct pipeline_alias_data *data = *state;
+	int i;
+
+	for (i = 0; i < ALIAS_COMPS; i++)
+		free(data->comp[i]);
+	for (i = 0; i < ALIAS_COMPS - 1; i++) {
+		free(data->buffer[i]->addr);
+		free(data->buffer[i]);
+	}
+	free(data);
+
+	return 0;
+}
+
+static void alias_test_prepare(struct pipeline_alias_data *data)
+{
+	assert_int_equal(pipeline_complete(&data->p, data->comp[0],
+					   data->comp[ALIAS_COMPS - 1]), 0);
+	assert_int_equal(pipeline_prepare(&data->p, data->comp[0]), 0);
+}
+
+static void test_audio_pipeline_alias_bypass_dma(void **state)
+{
+	struct pipeline_alias_data *data = *state;
+
+	alias_test_prepare(data);
+
+	/* dai reads what host dma wrote, eq copies nothing */
+	assert_true(data->comp[1]->bypass);
+	assert_ptr_equal(data->buffer[1]->alias_source, data->buffer[0]);
+}
+
+static void test_audio_pipeline_alias_not_bypassed(void **state)
+{
+	struct pipeline_alias_data *data = *state;
+
+	eq_flat = false;
+	alias_test_prepare(data);
+
+	/* processing eq must not write over data of host dma */
+	assert_null(data->buffer[1]->alias_source);
+}
+
+static void test_audio_pipeline_alias_dai_size(void **state)
+{
+	struct pipeline_alias_data *data = *state;
+
+	buffer_set_size(data->buffer[1], ALIAS_BUFFER_BYTES / 2);
+	alias_test_prepare(data);
+
+	/* dai dma set up for a different ring can't move onto it */
+	assert_null(data->buffer[1]->alias_source);
+}
+
+static void test_audio_pipeline_alias_unbypassed(void **state)
+{
+	struct pipeline_alias_data *data = *state;
+
+	alias_test_prepare(data);
+	assert_ptr_equal(data->buffer[1]->alias_source, data->buffer[0]);
+
+	/* buffers are separated again once eq processes data */
+	eq_flat = false;
+	assert_int_equal(pipeline_prepare(&data->p, data->comp[0]), 0);
+	assert_null(data->buffer[1]->alias_source);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown
+			(test_audio_pipeline_alias_bypass_dma, setup, teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_pipeline_alias_not_bypassed, setup,
+			 teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_pipeline_alias_dai_size, setup, teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_pipeline_alias_unbypassed, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
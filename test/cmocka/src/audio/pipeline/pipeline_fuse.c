@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/schedule/edf_schedule.h>
+#include "pipeline_mocks.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#define FUSE_PIPELINE_ID	1
+#define FUSE_COMPS		4
+#define FUSE_FRAMES		48
+#define FUSE_FRAME_BYTES	8
+#define FUSE_BUFFER_BYTES	(2 * FUSE_FRAMES * FUSE_FRAME_BYTES)
+
+static struct comp_driver drv_endpoint = {
+	.type = SOF_COMP_HOST,
+};
+
+static struct comp_driver drv_fusable = {
+	.type = SOF_COMP_VOLUME,
+	.flags = COMP_DRV_FUSABLE,
+};
+
+/* host -> vol -> eq -> dai connected by buffers */
+struct pipeline_fuse_data {
+	struct pipeline p;
+	struct comp_dev *comp[FUSE_COMPS];
+	struct comp_buffer *buffer[FUSE_COMPS - 1];
+};
+
+static int setup(void **state)
+{
+	struct pipeline_fuse_data *data = calloc(sizeof(*data), 1);
+	int i;
+
+	data->p.ipc_pipe.pipeline_id = FUSE_PIPELINE_ID;
+	data->p.ipc_pipe.frames_per_sched = 48;
+	data->p.status = COMP_STATE_INIT;
+
+	for (i = 0; i < FUSE_COMPS; i++) {
+		data->comp[i] = calloc(sizeof(struct comp_dev), 1);
+		data->comp[i]->comp.id = i;
+		data->comp[i]->comp.pipeline_id = FUSE_PIPELINE_ID;
+		data->comp[i]->frames = FUSE_FRAMES;
+		data->comp[i]->params.frame_fmt = SOF_IPC_FRAME_S32_LE;
+		data->comp[i]->params.channels = 2;
+		data->comp[i]->drv = i == 0 || i == FUSE_COMPS - 1 ?
+			&drv_endpoint : &drv_fusable;
+		list_init(&data->comp[i]->bsource_list);
+		list_init(&data->comp[i]->bsink_list);
+	}
+
+	for (i = 0; i < FUSE_COMPS - 1; i++) {
+		data->buffer[i] = calloc(sizeof(struct comp_buffer), 1);
+		data->buffer[i]->ipc_buffer.comp.pipeline_id = FUSE_PIPELINE_ID;
+		data->buffer[i]->addr = calloc(FUSE_BUFFER_BYTES, 1);
+		buffer_set_size(data->buffer[i], FUSE_BUFFER_BYTES);
+		list_init(&data->buffer[i]->source_list);
+		list_init(&data->buffer[i]->sink_list);
+		pipeline_connect(data->comp[i], data->buffer[i],
+				 PPL_CONN_DIR_COMP_TO_BUFFER);
+		pipeline_connect(data->comp[i + 1], data->buffer[i],
+				 PPL_CONN_DIR_BUFFER_TO_COMP);
+	}
+
+	data->p.sched_comp = data->comp[FUSE_COMPS - 1];
+	*state = data;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct pipeline_fuse_data *data = *state;
+	int i;
+
+	for (i = 0; i < FUSE_COMPS; i++)
+		free(data->comp[i]);
+	for (i = 0; i < FUSE_COMPS - 1; i++) {
+		free(data->buffer[i]->addr);
+		free(data->buffer[i]);
+	}
+	free(data);
+
+	return 0;
+}
+
+static void test_audio_pipeline_fuse_chain(void **state)
+{
+	struct pipeline_fuse_data *data = *state;
+
+	assert_int_equal(pipeline_complete(&data->p, data->comp[0],
+					   data->comp[FUSE_COMPS - 1]), 0);
+
+	/* endpoints are never fused */
+	assert_null(data->comp[0]->fuse_head);
+	assert_null(data->comp[0]->fuse_next);
+	assert_null(data->comp[3]->fuse_head);
+
+	/* vol heads the chain followed by eq */
+	assert_ptr_equal(data->comp[1]->fuse_head, data->comp[1]);
+	assert_ptr_equal(data->comp[1]->fuse_next, data->comp[2]);
+	assert_ptr_equal(data->comp[2]->fuse_head, data->comp[1]);
+	assert_null(data->comp[2]->fuse_next);
+}
+
+static void test_audio_pipeline_fuse_not_fusable(void **state)
+{
+	struct pipeline_fuse_data *data = *state;
+
+	data->comp[2]->drv = &drv_endpoint;
+
+	assert_int_equal(pipeline_complete(&data->p, data->comp[0],
+					   data->comp[FUSE_COMPS - 1]), 0);
+
+	/* a single fusable stage is not a chain */
+	assert_null(data->comp[1]->fuse_head);
+	assert_null(data->comp[1]->fuse_next);
+	assert_null(data->comp[2]->fuse_head);
+}
+
+static void test_audio_pipeline_fuse_other_pipeline(void **state)
+{
+	struct pipeline_fuse_data *data = *state;
+
+	data->comp[2]->comp.pipeline_id = FUSE_PIPELINE_ID + 1;
+
+	assert_int_equal(pipeline_complete(&data->p, data->comp[0],
+					   data->comp[FUSE_COMPS - 1]), 0);
+
+	/* stages are fused only within one pipeline */
+	assert_null(data->comp[1]->fuse_next);
+	assert_null(data->comp[2]->fuse_head);
+}
+
+static void test_audio_pipeline_fuse_tile_buffer(void **state)
+{
+	struct pipeline_fuse_data *data = *state;
+
+	assert_int_equal(pipeline_complete(&data->p, data->comp[0],
+					   data->comp[FUSE_COMPS - 1]), 0);
+	assert_int_equal(pipeline_prepare(&data->p, data->comp[0]), 0);
+
+	/* only the buffer inside the chain is reduced to a single tile */
+	assert_int_equal(data->buffer[0]->size, FUSE_BUFFER_BYTES);
+	assert_int_equal(data->buffer[1]->ipc_buffer.size,
+			 CONFIG_PIPELINE_FUSION_TILE_FRAMES * FUSE_FRAME_BYTES);
+	assert_int_equal(data->buffer[1]->size,
+			 CONFIG_PIPELINE_FUSION_TILE_FRAMES * FUSE_FRAME_BYTES);
+	assert_int_equal(data->buffer[2]->size, FUSE_BUFFER_BYTES);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_fuse_chain,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_pipeline_fuse_not_fusable, setup, teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_pipeline_fuse_other_pipeline, setup,
+			 teardown),
+		cmocka_unit_test_setup_teardown
+			(test_audio_pipeline_fuse_tile_buffer, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -98,6 +98,77 @@ void heap_trace_all(int force)
 	(void)force;
 }
 
+void heap_set_owner(uint32_t pipeline_id)
+{
+	(void)pipeline_id;
+}
+
+void heap_clear_owner(void) { }
+
+struct mm_arena *arena_new(uint32_t owner, uint32_t caps, size_t bytes)
+{
+	(void)owner;
+	(void)caps;
+	(void)bytes;
+
+	return NULL;
+}
+
+void *arena_alloc(struct mm_arena *arena, size_t bytes)
+{
+	(void)arena;
+	(void)bytes;
+
+	return NULL;
+}
+
+void arena_seal(struct mm_arena *arena)
+{
+	(void)arena;
+}
+
+void arena_free(struct mm_arena *arena)
+{
+	(void)arena;
+}
+
+int buffer_alias(struct comp_buffer *buffer, struct comp_buffer *source)
+{
+	buffer->alias_source = source;
+	source->alias_sink = buffer;
+
+	return 0;
+}
+
+void buffer_unalias(struct comp_buffer *buffer)
+{
+	if (buffer->alias_source)
+		buffer->alias_source->alias_sink = NULL;
+	buffer->alias_source = NULL;
+}
+
+int buffer_set_size(struct comp_buffer *buffer, uint32_t size)
+{
+	/* tests provide backing store big enough for any size */
+	buffer->ipc_buffer.size = size;
+	buffer->size = size;
+	buffer->end_addr = buffer->addr + size;
+
+	return 0;
+}
+
+int comp_bypass_copy(struct comp_dev *dev)
+{
+	(void)dev;
+
+	return 0;
+}
+
+void buffer_cache_sync(struct comp_buffer *buffer)
+{
+	(void)buffer;
+}
+
 void __panic(uint32_t p, char *filename, uint32_t linenum)
 {
 	(void)p;
@@ -50,8 +50,9 @@ static void set_volume(int32_t *vol, int32_t value, uint32_t channels)
 {
 	int i;
 
+	/* distinct gains catch channel mix-ups */
 	for (i = 0; i < channels; i++)
-		vol[i] = value;
+		vol[i] = value / (i + 1);
 }
 
 static int setup(void **state)
@@ -448,6 +449,38 @@ static struct vol_test_parameters parameters[] = {
 		SOF_IPC_FRAME_S32_LE,   verify_s32_to_s24_s32 }, /* 26 */
 	{ VOL_MINUS_80DB, 2, 48, 1, SOF_IPC_FRAME_S32_LE,
 		SOF_IPC_FRAME_S32_LE,   verify_s32_to_s24_s32 }, /* 27 */
+
+	/* channel counts with specialised and generic processing */
+	{ VOL_MAX,        1, 48, 1, SOF_IPC_FRAME_S16_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_s16_to_s16 }, /* 28 */
+	{ VOL_MAX,        1, 48, 1, SOF_IPC_FRAME_S24_4LE,
+		SOF_IPC_FRAME_S32_LE,  verify_s24_to_s24_s32 }, /* 29 */
+	{ VOL_MAX,        1, 48, 1, SOF_IPC_FRAME_S32_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_sX_to_s16 }, /* 30 */
+	{ VOL_MAX,        4, 48, 1, SOF_IPC_FRAME_S16_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_s16_to_s16 }, /* 31 */
+	{ VOL_MAX,        4, 48, 1, SOF_IPC_FRAME_S24_4LE,
+		SOF_IPC_FRAME_S32_LE,  verify_s24_to_s24_s32 }, /* 32 */
+	{ VOL_MAX,        4, 48, 1, SOF_IPC_FRAME_S32_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_sX_to_s16 }, /* 33 */
+	{ VOL_MAX,        6, 48, 1, SOF_IPC_FRAME_S16_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_s16_to_s16 }, /* 34 */
+	{ VOL_MAX,        6, 48, 1, SOF_IPC_FRAME_S24_4LE,
+		SOF_IPC_FRAME_S32_LE,  verify_s24_to_s24_s32 }, /* 35 */
+	{ VOL_MAX,        6, 48, 1, SOF_IPC_FRAME_S32_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_sX_to_s16 }, /* 36 */
+	{ VOL_MAX,        8, 48, 1, SOF_IPC_FRAME_S16_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_s16_to_s16 }, /* 37 */
+	{ VOL_MAX,        8, 48, 1, SOF_IPC_FRAME_S24_4LE,
+		SOF_IPC_FRAME_S32_LE,  verify_s24_to_s24_s32 }, /* 38 */
+	{ VOL_MAX,        8, 48, 1, SOF_IPC_FRAME_S32_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_sX_to_s16 }, /* 39 */
+	{ VOL_MAX,        3, 48, 1, SOF_IPC_FRAME_S16_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_s16_to_s16 }, /* 40 */
+	{ VOL_MAX,        3, 48, 1, SOF_IPC_FRAME_S24_4LE,
+		SOF_IPC_FRAME_S32_LE,  verify_s24_to_s24_s32 }, /* 41 */
+	{ VOL_MAX,        3, 48, 1, SOF_IPC_FRAME_S32_LE,
+		SOF_IPC_FRAME_S16_LE,  verify_sX_to_s16 }, /* 42 */
 };
 
 int main(void)
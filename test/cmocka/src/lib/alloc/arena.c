@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <sof/sof.h>
+#include <sof/alloc.h>
+
+#define LINE	PLATFORM_DCACHE_ALIGN
+
+static struct sof *sof;
+
+static int setup(void **state)
+{
+	struct mm_arena *arena;
+
+	arena = arena_new(1, SOF_MEM_CAPS_RAM, 4 * LINE);
+	if (!arena)
+		return -ENOMEM;
+
+	*state = arena;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct mm_arena *arena = *state;
+
+	/* all allocations of the tests are released */
+	arena_free(arena);
+
+	return 0;
+}
+
+static void test_lib_arena_alloc_seal(void **state)
+{
+	struct mm_arena *arena = *state;
+	char *base = arena->base;
+	void *a;
+	void *b;
+	void *c;
+
+	/* allocations are cache line aligned */
+	a = arena_alloc(arena, 1);
+	b = arena_alloc(arena, LINE + 1);
+	assert_ptr_equal(a, base);
+	assert_ptr_equal(b, base + LINE);
+
+	/* allocations before the seal are pinned */
+	arena_seal(arena);
+	assert_int_equal(arena->mark, 3 * LINE);
+	assert_int_equal(arena->pinned, 2);
+	assert_int_equal(arena->live, 0);
+
+	c = arena_alloc(arena, LINE);
+	assert_ptr_equal(c, base + 3 * LINE);
+	assert_int_equal(arena->live, 1);
+
+	/* no space left */
+	assert_null(arena_alloc(arena, 1));
+
+	rfree(c);
+	rfree(b);
+	rfree(a);
+	assert_int_equal(arena->pinned, 0);
+	assert_int_equal(arena->live, 0);
+}
+
+static void test_lib_arena_release_tail(void **state)
+{
+	struct mm_arena *arena = *state;
+	void *x;
+	void *y;
+	void *z;
+
+	arena_seal(arena);
+
+	x = arena_alloc(arena, LINE);
+	y = arena_alloc(arena, LINE);
+
+	/* the latest allocation is recycled at once */
+	rfree(y);
+	z = arena_alloc(arena, LINE);
+	assert_ptr_equal(z, y);
+
+	/* the tail goes back once all of it is released */
+	rfree(x);
+	assert_int_equal(arena->top, 2 * LINE);
+	rfree(z);
+	assert_int_equal(arena->top, arena->mark);
+	assert_ptr_equal(arena_alloc(arena, LINE), x);
+	rfree(x);
+}
+
+static void test_lib_arena_reuse_pinned(void **state)
+{
+	struct mm_arena *arena = *state;
+	void *a;
+	void *b;
+
+	a = arena_alloc(arena, 2 * LINE);
+	arena_seal(arena);
+
+	/* a resized buffer takes the space of its old store */
+	rfree(a);
+	assert_int_equal(arena->pinned, 0);
+
+	b = arena_alloc(arena, LINE);
+	assert_ptr_equal(b, a);
+	assert_int_equal(arena->pinned, 1);
+	assert_int_equal(arena->top, arena->mark);
+
+	/* too big for the slot, taken from the tail */
+	rfree(b);
+	b = arena_alloc(arena, 3 * LINE);
+	assert_null(b);
+	b = arena_alloc(arena, 2 * LINE);
+	assert_ptr_equal(b, a);
+	rfree(b);
+}
+
+static void test_lib_arena_free(void **state)
+{
+	struct mm_arena *arena = arena_new(2, SOF_MEM_CAPS_RAM, LINE);
+	void *a;
+
+	assert_non_null(arena);
+	a = arena_alloc(arena, LINE);
+	arena_seal(arena);
+
+	/* region stays until its last allocation is freed */
+	arena_free(arena);
+	assert_true(arena_contains(a));
+
+	rfree(a);
+	assert_false(arena_contains(a));
+}
+
+static int group_setup(void **state)
+{
+	sof = malloc(sizeof(struct sof));
+	platform_init_memmap();
+	init_heap(sof);
+
+	return 0;
+}
+
+static int group_teardown(void **state)
+{
+	free(sof);
+
+	return 0;
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_lib_arena_alloc_seal,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_arena_release_tail,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_arena_reuse_pinned,
+						setup, teardown),
+		cmocka_unit_test(test_lib_arena_free),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, group_setup, group_teardown);
+}
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/clk.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define TEST_FREQ_COUNT	4
+
+static const struct freq_table test_freq[TEST_FREQ_COUNT] = {
+	{ 50000000, 50000, 0},
+	{100000000, 100000, 1},
+	{200000000, 200000, 2},
+	{343000000, 343000, 3},
+};
+
+static void test_lib_clk_gov_init(void **state)
+{
+	struct clk_gov gov;
+
+	(void)state;
+
+	clk_gov_init(&gov, test_freq, TEST_FREQ_COUNT, 150000000);
+	assert_int_equal(gov.idx, 2);
+
+	clk_gov_init(&gov, test_freq, TEST_FREQ_COUNT, 400000000);
+	assert_int_equal(gov.idx, 3);
+}
+
+static void test_lib_clk_gov_scale_up(void **state)
+{
+	struct clk_gov gov;
+
+	(void)state;
+
+	clk_gov_init(&gov, test_freq, TEST_FREQ_COUNT, 50000000);
+
+	/* 45 MCPS needs 100 MHz to stay below the target */
+	assert_int_equal(clk_gov_update(&gov, 900, 0), 1);
+	assert_int_equal(gov.transitions, 1);
+
+	/* declared load jumps straight to the needed clock */
+	assert_int_equal(clk_gov_update(&gov, 100, 150000), 3);
+	assert_int_equal(gov.transitions, 2);
+	assert_int_equal(gov.misses, 0);
+}
+
+static void test_lib_clk_gov_scale_down(void **state)
+{
+	struct clk_gov gov;
+	int i;
+
+	(void)state;
+
+	clk_gov_init(&gov, test_freq, TEST_FREQ_COUNT, 343000000);
+
+	for (i = 0; i < CLK_GOV_DOWN_DELAY - 1; i++)
+		assert_int_equal(clk_gov_update(&gov, 100, 0), 3);
+
+	/* a busy window restarts the delay */
+	assert_int_equal(clk_gov_update(&gov, 500, 0), 3);
+
+	for (i = 0; i < CLK_GOV_DOWN_DELAY - 1; i++)
+		assert_int_equal(clk_gov_update(&gov, 100, 0), 3);
+
+	/* one step at a time */
+	assert_int_equal(clk_gov_update(&gov, 100, 0), 2);
+	assert_int_equal(gov.transitions, 1);
+}
+
+static void test_lib_clk_gov_hysteresis(void **state)
+{
+	struct clk_gov gov;
+	int i;
+
+	(void)state;
+
+	clk_gov_init(&gov, test_freq, TEST_FREQ_COUNT, 200000000);
+
+	/* 60 MCPS would fit 100 MHz at the target, but not with the
+	 * headroom needed to scale down
+	 */
+	for (i = 0; i < 2 * CLK_GOV_DOWN_DELAY; i++)
+		assert_int_equal(clk_gov_update(&gov, 300, 0), 2);
+
+	/* declared load keeps the clock up as well */
+	for (i = 0; i < 2 * CLK_GOV_DOWN_DELAY; i++)
+		assert_int_equal(clk_gov_update(&gov, 100, 120000), 2);
+
+	assert_int_equal(gov.transitions, 0);
+}
+
+static void test_lib_clk_gov_saturated(void **state)
+{
+	struct clk_gov gov;
+	int i;
+
+	(void)state;
+
+	clk_gov_init(&gov, test_freq, TEST_FREQ_COUNT, 100000000);
+
+	/* saturation without a transition is not a miss */
+	assert_int_equal(clk_gov_update(&gov, 1000, 0), 3);
+	assert_int_equal(gov.misses, 0);
+
+	for (i = 0; i < CLK_GOV_DOWN_DELAY; i++)
+		clk_gov_update(&gov, 100, 0);
+	assert_int_equal(gov.idx, 2);
+
+	/* the window after scaling down is verified */
+	assert_int_equal(clk_gov_update(&gov, 1000, 0), 3);
+	assert_int_equal(gov.misses, 1);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_lib_clk_gov_init),
+		cmocka_unit_test(test_lib_clk_gov_scale_up),
+		cmocka_unit_test(test_lib_clk_gov_scale_down),
+		cmocka_unit_test(test_lib_clk_gov_hysteresis),
+		cmocka_unit_test(test_lib_clk_gov_saturated),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+#include <sof/alloc.h>
+#include <sof/idc.h>
+#include <sof/notifier.h>
+#include <sof/drivers/timer.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#include <mock_trace.h>
+
+TRACE_IMPL()
+
+struct timer *platform_timer;
+
+static struct notify *test_notify;
+static uint64_t test_time;
+static struct idc_msg test_idc_msg;
+static uint8_t test_idc_payload[IDC_PAYLOAD_SIZE];
+static int test_idc_sent;
+
+struct notify **arch_notify_get(void)
+{
+	return &test_notify;
+}
+
+void *rzalloc(int zone, uint32_t caps, size_t bytes)
+{
+	(void)zone;
+	(void)caps;
+
+	return calloc(bytes, 1);
+}
+
+uint64_t platform_timer_get(struct timer *timer)
+{
+	(void)timer;
+
+	return test_time;
+}
+
+int arch_cpu_is_core_enabled(int id)
+{
+	(void)id;
+
+	return 1;
+}
+
+#if CONFIG_SMP
+int arch_idc_send_msg(struct idc_msg *msg, uint32_t mode)
+{
+	assert_int_equal(mode, IDC_COALESCE);
+
+	test_idc_msg = *msg;
+	assert_int_equal(memcpy_s(test_idc_payload, sizeof(test_idc_payload),
+				  msg->payload, msg->size), 0);
+	test_idc_sent++;
+
+	return 0;
+}
+#endif
+
+void __panic(uint32_t p, char *filename, uint32_t linenum)
+{
+	(void)p;
+	(void)filename;
+	(void)linenum;
+
+	fail();
+}
+
+/* delivered events in order */
+struct test_log {
+	int count;
+	int cb[16];
+	int message[16];
+	uint32_t data[16];
+	int raise;		/* events to raise from the callback */
+};
+
+static struct test_log test_log;
+
+static void test_cb(int message, void *cb_data, void *event_data)
+{
+	struct notify_data nested = {
+		.id = NOTIFIER_ID_SSP_FREQ,
+		.target_core_mask = NOTIFIER_TARGET_CORE_MASK(0),
+	};
+	int i = test_log.count++;
+
+	test_log.cb[i] = (uintptr_t)cb_data;
+	test_log.message[i] = message;
+	test_log.data[i] = *(uint32_t *)event_data;
+
+	/* time spent by the callback */
+	test_time += 10;
+
+	while (test_log.raise > 0) {
+		nested.message = 100 + test_log.raise--;
+		notifier_event(&nested);
+	}
+}
+
+static struct notifier test_cpu = {
+	.id = NOTIFIER_ID_CPU_FREQ,
+	.cb = test_cb,
+	.cb_data = (void *)1,
+};
+
+static struct notifier test_ssp = {
+	.id = NOTIFIER_ID_SSP_FREQ,
+	.cb = test_cb,
+	.cb_data = (void *)2,
+};
+
+static int setup(void **state)
+{
+	(void)state;
+
+	memset(&test_log, 0, sizeof(test_log));
+	test_time = 0;
+	test_idc_sent = 0;
+
+	init_system_notify(NULL);
+	notifier_register(&test_cpu);
+	notifier_register(&test_ssp);
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	(void)state;
+
+	free(test_notify);
+	test_notify = NULL;
+
+	return 0;
+}
+
+static void test_event(int id, int message, uint32_t data)
+{
+	struct notify_data event = {
+		.id = id,
+		.message = message,
+		.target_core_mask = NOTIFIER_TARGET_CORE_MASK(0),
+		.data_size = sizeof(data),
+		.data = &data,
+	};
+
+	notifier_event(&event);
+}
+
+static void test_lib_notifier_bucket(void **state)
+{
+	(void)state;
+
+	test_event(NOTIFIER_ID_SSP_FREQ, 7, 0x1234);
+
+	/* only the subscriber of the event id is called, with a copy */
+	assert_int_equal(test_log.count, 1);
+	assert_int_equal(test_log.cb[0], 2);
+	assert_int_equal(test_log.message[0], 7);
+	assert_int_equal(test_log.data[0], 0x1234);
+
+	notifier_unregister(&test_ssp);
+	test_event(NOTIFIER_ID_SSP_FREQ, 8, 0);
+	assert_int_equal(test_log.count, 1);
+}
+
+static void test_lib_notifier_nested(void **state)
+{
+	struct notify_stats stats;
+
+	(void)state;
+
+	/* events raised by a callback wait for it to return */
+	test_log.raise = 2;
+	test_event(NOTIFIER_ID_CPU_FREQ, 1, 0);
+
+	assert_int_equal(test_log.count, 3);
+	assert_int_equal(test_log.cb[0], 1);
+	assert_int_equal(test_log.message[1], 102);
+	assert_int_equal(test_log.message[2], 101);
+
+	/* second nested event waited for one callback */
+	notifier_stats_get(&stats);
+	assert_int_equal(stats.events, 3);
+	assert_int_equal(stats.queued_max, 2);
+	assert_int_equal(stats.latency_max, 10);
+	assert_int_equal(stats.latency_sum, 10);
+	assert_int_equal(stats.overflows, 0);
+}
+
+static void test_lib_notifier_overflow(void **state)
+{
+	struct notify_stats stats;
+
+	(void)state;
+
+	/* full queue delivers at once rather than dropping */
+	test_log.raise = NOTIFIER_QUEUE_SIZE + 1;
+	test_event(NOTIFIER_ID_CPU_FREQ, 1, 0);
+
+	assert_int_equal(test_log.count, NOTIFIER_QUEUE_SIZE + 2);
+
+	notifier_stats_get(&stats);
+	assert_int_equal(stats.overflows, 1);
+	assert_int_equal(stats.queued_max, NOTIFIER_QUEUE_SIZE);
+}
+
+static void test_lib_notifier_invalid(void **state)
+{
+	struct notify_data event = {
+		.id = NOTIFIER_ID_COUNT,
+		.target_core_mask = NOTIFIER_TARGET_CORE_MASK(0),
+	};
+	uint8_t data[NOTIFIER_DATA_SIZE + 1];
+
+	(void)state;
+
+	notifier_event(&event);
+
+	event.id = NOTIFIER_ID_CPU_FREQ;
+	event.data = data;
+	event.data_size = sizeof(data);
+	notifier_event(&event);
+
+	assert_int_equal(test_log.count, 0);
+}
+
+#if CONFIG_SMP
+static void test_lib_notifier_remote(void **state)
+{
+	struct notify_data event = {
+		.id = NOTIFIER_ID_SSP_FREQ,
+		.message = 3,
+		.target_core_mask = NOTIFIER_TARGET_CORE_MASK(1),
+	};
+	uint32_t data = 0xabcd;
+
+	(void)state;
+
+	event.data = &data;
+	event.data_size = sizeof(data);
+	notifier_event(&event);
+
+	/* other core gets the event data along with the message */
+	assert_int_equal(test_log.count, 0);
+	assert_int_equal(test_idc_sent, 1);
+	assert_int_equal(test_idc_msg.core, 1);
+	assert_int_equal(test_idc_msg.header, IDC_MSG_NOTIFY);
+
+	assert_int_equal(notifier_notify_remote(test_idc_payload,
+						test_idc_msg.size), 0);
+	assert_int_equal(test_log.count, 1);
+	assert_int_equal(test_log.cb[0], 2);
+	assert_int_equal(test_log.message[0], 3);
+	assert_int_equal(test_log.data[0], 0xabcd);
+}
+#endif
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_lib_notifier_bucket,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_notifier_nested,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_notifier_overflow,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_notifier_invalid,
+						setup, teardown),
+#if CONFIG_SMP
+		cmocka_unit_test_setup_teardown(test_lib_notifier_remote,
+						setup, teardown),
+#endif
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
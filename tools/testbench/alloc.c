@@ -10,48 +10,218 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <errno.h>
 #include <malloc.h>
+#include <pthread.h>
 #include <sof/alloc.h>
+#include <sof/audio/buffer.h>
 #include "testbench/common_test.h"
 
 /* testbench mem alloc definition */
 
+/* heap usage is accounted per zone class like on the DSP */
+#define TB_HEAP_RUNTIME	0
+#define TB_HEAP_BUFFER	1
+#define TB_HEAP_COUNT	2
+
+/* accounting header prepended to each allocation */
+struct tb_alloc_hdr {
+	size_t size;
+	uint32_t heap;
+	uint32_t owner;
+} __aligned(16);
+
+static struct mm_info tb_heap[TB_HEAP_COUNT];
+static struct mm_owner tb_owner[HEAP_OWNER_COUNT] = {
+	[0 ... HEAP_OWNER_COUNT - 1] = { .id = HEAP_OWNER_NONE },
+};
+
+static uint32_t tb_owner_slot = HEAP_OWNER_SLOT_NONE;
+
+/* emulated cores allocate from their own threads */
+static pthread_mutex_t tb_heap_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void tb_account_alloc(struct tb_alloc_hdr *hdr)
+{
+	struct mm_info *info = &tb_heap[hdr->heap];
+	struct mm_owner *owner;
+
+	pthread_mutex_lock(&tb_heap_lock);
+
+	info->used += hdr->size;
+	info->allocs++;
+	if (info->used > info->peak)
+		info->peak = info->used;
+
+	if (hdr->owner != HEAP_OWNER_SLOT_NONE) {
+		owner = &tb_owner[hdr->owner];
+		owner->used += hdr->size;
+		owner->allocs++;
+		if (owner->used > owner->peak)
+			owner->peak = owner->used;
+	}
+
+	pthread_mutex_unlock(&tb_heap_lock);
+}
+
+static void tb_account_free(struct tb_alloc_hdr *hdr)
+{
+	pthread_mutex_lock(&tb_heap_lock);
+
+	tb_heap[hdr->heap].used -= hdr->size;
+	tb_heap[hdr->heap].allocs--;
+
+	if (hdr->owner != HEAP_OWNER_SLOT_NONE) {
+		tb_owner[hdr->owner].used -= hdr->size;
+		tb_owner[hdr->owner].allocs--;
+	}
+
+	pthread_mutex_unlock(&tb_heap_lock);
+}
+
+static void *tb_alloc(int heap, size_t bytes, int zero)
+{
+	struct tb_alloc_hdr *hdr;
+
+	hdr = zero ? calloc(sizeof(*hdr) + bytes, 1) :
+		malloc(sizeof(*hdr) + bytes);
+	if (!hdr)
+		return NULL;
+
+	hdr->size = bytes;
+	hdr->heap = heap;
+	hdr->owner = tb_owner_slot;
+	tb_account_alloc(hdr);
+
+	return hdr + 1;
+}
+
+static void *tb_realloc(void *ptr, int heap, size_t bytes)
+{
+	struct tb_alloc_hdr *hdr;
+	struct tb_alloc_hdr *new_hdr;
+	struct tb_alloc_hdr old;
+
+	if (!ptr)
+		return tb_alloc(heap, bytes, 0);
+
+	/* the old block and its accounting stay as is if realloc fails */
+	hdr = (struct tb_alloc_hdr *)ptr - 1;
+	old = *hdr;
+
+	new_hdr = realloc(hdr, sizeof(*hdr) + bytes);
+	if (!new_hdr)
+		return NULL;
+
+	/* the block keeps its heap and owner */
+	tb_account_free(&old);
+	new_hdr->size = bytes;
+	tb_account_alloc(new_hdr);
+
+	return new_hdr + 1;
+}
+
 void *rmalloc(int zone, uint32_t caps, size_t bytes)
 {
-	return malloc(bytes);
+	return tb_alloc(TB_HEAP_RUNTIME, bytes, 0);
 }
 
 void *rzalloc(int zone, uint32_t caps, size_t bytes)
 {
-	return calloc(bytes, 1);
+	return tb_alloc(TB_HEAP_RUNTIME, bytes, 1);
 }
 
 void rfree(void *ptr)
 {
-	free(ptr);
+	struct tb_alloc_hdr *hdr;
+
+	if (!ptr)
+		return;
+
+	hdr = (struct tb_alloc_hdr *)ptr - 1;
+	tb_account_free(hdr);
+	free(hdr);
 }
 
 void *rballoc(int zone, uint32_t caps, size_t bytes)
 {
-	return malloc(bytes);
+	return tb_alloc(TB_HEAP_BUFFER, bytes, 0);
 }
 
 void *rrealloc(void *ptr, int zone, uint32_t caps, size_t bytes)
 {
-	return realloc(ptr, bytes);
+	return tb_realloc(ptr, TB_HEAP_RUNTIME, bytes);
 }
 
 void *rbrealloc(void *ptr, int zone, uint32_t caps, size_t bytes)
 {
-	return realloc(ptr, bytes);
+	return tb_realloc(ptr, TB_HEAP_BUFFER, bytes);
+}
+
+void heap_set_owner(uint32_t pipeline_id)
+{
+	int i;
+
+	for (i = 1; i < HEAP_OWNER_COUNT; i++) {
+		if (tb_owner[i].id == pipeline_id ||
+		    tb_owner[i].id == HEAP_OWNER_NONE) {
+			tb_owner[i].id = pipeline_id;
+			tb_owner_slot = i;
+			return;
+		}
+	}
+
+	tb_owner_slot = HEAP_OWNER_SLOT_NONE;
+}
+
+void heap_clear_owner(void)
+{
+	tb_owner_slot = HEAP_OWNER_SLOT_NONE;
+}
+
+int heap_get_owner_info(int slot, struct mm_owner *owner)
+{
+	if (slot <= HEAP_OWNER_SLOT_NONE || slot >= HEAP_OWNER_COUNT ||
+	    tb_owner[slot].id == HEAP_OWNER_NONE)
+		return -EINVAL;
+
+	*owner = tb_owner[slot];
+	return 0;
 }
 
 void heap_trace(struct mm_heap *heap, int size)
 {
-	malloc_info(0, stdout);
+	/* only dumped in debug mode, processing API users share stdout */
+	if (debug)
+		malloc_info(0, stdout);
 }
 
 void heap_trace_all(int force)
 {
 	heap_trace(NULL, 0);
 }
+
+void tb_heap_summary(void)
+{
+	struct buffer_pool_stats pool;
+	int i;
+
+	printf("Runtime heap: peak %u bytes, %u live allocations\n",
+	       tb_heap[TB_HEAP_RUNTIME].peak,
+	       tb_heap[TB_HEAP_RUNTIME].allocs);
+	printf("Buffer heap: peak %u bytes, %u live allocations\n",
+	       tb_heap[TB_HEAP_BUFFER].peak,
+	       tb_heap[TB_HEAP_BUFFER].allocs);
+
+	for (i = 1; i < HEAP_OWNER_COUNT; i++) {
+		if (tb_owner[i].id == HEAP_OWNER_NONE)
+			continue;
+
+		printf("Pipeline %u heap: peak %u bytes\n",
+		       tb_owner[i].id, tb_owner[i].peak);
+	}
+
+	buffer_pool_get_stats(&pool);
+	printf("Buffer pool: %u hits, %u misses, %u bytes retained\n",
+	       pool.hits, pool.misses, pool.bytes);
+}
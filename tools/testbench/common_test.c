@@ -19,6 +19,8 @@
 #include <sof/wait.h>
 #include <sof/ipc.h>
 #include <sof/audio/pipeline.h>
+#include <sof/notifier.h>
+#include <platform/idc.h>
 #include "testbench/common_test.h"
 #include "testbench/topology.h"
 
@@ -28,6 +30,7 @@ int tb_pipeline_setup(struct sof *sof)
 {
 	/* init components */
 	sys_comp_init();
+	buffer_pool_init();
 
 	/* init IPC */
 	if (ipc_init(sof) < 0) {
@@ -41,6 +44,10 @@ int tb_pipeline_setup(struct sof *sof)
 		return -EINVAL;
 	}
 
+	/* master core side of notifier and IDC */
+	init_system_notify(sof);
+	idc_init();
+
 	debug_print("ipc and scheduler initialized\n");
 
 	return 0;
@@ -52,6 +59,7 @@ int tb_pipeline_start(struct ipc *ipc, int nch,
 		      struct testbench_prm *tp)
 {
 	struct ipc_comp_dev *pcm_dev;
+	struct sof_ipc_stream *stream;
 	struct pipeline *p;
 	struct comp_dev *cd;
 	int ret;
@@ -77,6 +85,11 @@ int tb_pipeline_start(struct ipc *ipc, int nch,
 	/* Component prepare */
 	ret = pipeline_prepare(p, cd);
 
+	/* trigger of a pipeline on another core reads the IPC payload */
+	stream = ipc->comp_data;
+	stream->hdr.size = sizeof(*stream);
+	stream->comp_id = ipc_pipe->sched_id;
+
 	/* Start the pipeline */
 	ret = pipeline_trigger(p, cd, COMP_TRIGGER_START);
 	if (ret < 0)
@@ -158,6 +171,42 @@ int tb_pipeline_params(struct ipc *ipc, int nch,
 	return ret;
 }
 
+/* free components */
+void tb_free_comps(struct sof *sof)
+{
+	struct list_item *clist;
+	struct list_item *temp;
+	struct ipc_comp_dev *icd = NULL;
+
+	/* buffers first, they unlink from the lists of their components */
+	list_for_item_safe(clist, temp, &sof->ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_BUFFER)
+			continue;
+
+		/* backing store goes back to the buffer pool */
+		buffer_free(icd->cb);
+		list_item_del(&icd->list);
+		rfree(icd);
+	}
+
+	list_for_item_safe(clist, temp, &sof->ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		switch (icd->type) {
+		case COMP_TYPE_COMPONENT:
+			comp_free(icd->cd);
+			list_item_del(&icd->list);
+			rfree(icd);
+			break;
+		default:
+			rfree(icd->pipeline);
+			list_item_del(&icd->list);
+			rfree(icd);
+			break;
+		}
+	}
+}
+
 /* getindex of shared library from table */
 int get_index_by_name(char *comp_type,
 		      struct shared_lib_table *lib_table)
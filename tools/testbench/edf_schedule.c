@@ -5,20 +5,27 @@
 // Author: Bartosz Kokoszko <bartoszx.kokoszko@linux.intel.com>
 
 #include <sof/audio/component.h>
+#include <sof/cpu.h>
+#include <sof/idc.h>
 #include <sof/task.h>
+#include <platform/idc.h>
+#include <pthread.h>
 #include <stdint.h>
+#include <time.h>
 #include <sof/schedule/edf_schedule.h>
 #include <sof/wait.h>
 
  /* scheduler testbench definition */
 
+/* per core task queue, tasks of other cores are run by their threads */
 struct edf_schedule_data {
-	spinlock_t lock; /* schedule lock */
+	pthread_mutex_t lock; /* schedule lock */
+	pthread_cond_t idle; /* signalled when the queue drains */
 	struct list_item list; /* list of tasks in priority queue */
 	uint32_t clock;
 };
 
-static struct edf_schedule_data *sch;
+static struct edf_schedule_data *sch[PLATFORM_CORE_COUNT];
 
 static void schedule_edf_task_complete(struct task *task);
 static void schedule_edf_task(struct task *task, uint64_t start,
@@ -40,14 +47,35 @@ static void schedule_edf_task_complete(struct task *task)
 static void schedule_edf_task(struct task *task, uint64_t start,
 			      uint64_t deadline, uint32_t flags)
 {
+	struct edf_schedule_data *data = sch[task->core];
+
 	(void)deadline;
-	list_item_prepend(&task->list, &sch->list);
+
+	/* remote core owns the task, queue it and kick its thread */
+	if (task->core != cpu_get_id() && cpu_is_core_enabled(task->core)) {
+		pthread_mutex_lock(&data->lock);
+		if (task->state != SOF_TASK_STATE_QUEUED &&
+		    task->state != SOF_TASK_STATE_RUNNING) {
+			list_item_prepend(&task->list, &data->list);
+			task->state = SOF_TASK_STATE_QUEUED;
+		}
+		pthread_mutex_unlock(&data->lock);
+
+		arch_cpu_wake_core(task->core);
+		return;
+	}
+
+	pthread_mutex_lock(&data->lock);
+	list_item_prepend(&task->list, &data->list);
 	task->state = SOF_TASK_STATE_QUEUED;
+	pthread_mutex_unlock(&data->lock);
 
 	if (task->func)
 		task->func(task->data);
 
+	pthread_mutex_lock(&data->lock);
 	schedule_edf_task_complete(task);
+	pthread_mutex_unlock(&data->lock);
 }
 
 static int schedule_edf_task_init(struct task *task, uint32_t xflags)
@@ -64,31 +92,105 @@ static int schedule_edf_task_init(struct task *task, uint32_t xflags)
 /* initialize scheduler */
 static int edf_scheduler_init(void)
 {
+	int i;
+
 	trace_edf_sch("edf_scheduler_init()");
-	sch = malloc(sizeof(*sch));
-	list_init(&sch->list);
-	spinlock_init(&sch->lock);
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		sch[i] = malloc(sizeof(*sch[i]));
+		list_init(&sch[i]->list);
+		pthread_mutex_init(&sch[i]->lock, NULL);
+		pthread_cond_init(&sch[i]->idle, NULL);
+	}
 
 	return 0;
 }
 
 static void edf_scheduler_free(void)
 {
-	free(sch);
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		pthread_mutex_destroy(&sch[i]->lock);
+		pthread_cond_destroy(&sch[i]->idle);
+		free(sch[i]);
+	}
+}
+
+/* run tasks queued for the calling core, oldest first */
+static void schedule_edf_run_queue(struct edf_schedule_data *data)
+{
+	struct task *task;
+
+	pthread_mutex_lock(&data->lock);
+
+	while (!list_is_empty(&data->list)) {
+		task = container_of(data->list.prev, struct task, list);
+		task->state = SOF_TASK_STATE_RUNNING;
+		pthread_mutex_unlock(&data->lock);
+
+		if (task->func)
+			task->func(task->data);
+
+		pthread_mutex_lock(&data->lock);
+		schedule_edf_task_complete(task);
+	}
+
+	pthread_cond_broadcast(&data->idle);
+	pthread_mutex_unlock(&data->lock);
+}
+
+/* master waits for the period to complete on every core, like a timer tick
+ * IDC sent to the master meanwhile is serviced while waiting
+ */
+static void schedule_edf_wait_cores(void)
+{
+	struct edf_schedule_data *data;
+	struct timespec ts;
+	int i;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++) {
+		if (i == PLATFORM_MASTER_CORE_ID || !cpu_is_core_enabled(i))
+			continue;
+
+		data = sch[i];
+		pthread_mutex_lock(&data->lock);
+		while (!list_is_empty(&data->list)) {
+			clock_gettime(CLOCK_REALTIME, &ts);
+			ts.tv_nsec += 1000000;
+			if (ts.tv_nsec >= 1000000000) {
+				ts.tv_sec++;
+				ts.tv_nsec -= 1000000000;
+			}
+			pthread_cond_timedwait(&data->idle, &data->lock, &ts);
+
+			pthread_mutex_unlock(&data->lock);
+			idc_process_msg_queue();
+			pthread_mutex_lock(&data->lock);
+		}
+		pthread_mutex_unlock(&data->lock);
+	}
 }
 
-/* The following definitions are to satisfy libsof linker errors */
 static void schedule_edf(void)
 {
+	schedule_edf_run_queue(sch[cpu_get_id()]);
+
+	if (cpu_get_id() == PLATFORM_MASTER_CORE_ID)
+		schedule_edf_wait_cores();
 }
 
 static int schedule_edf_task_cancel(struct task *task)
 {
+	struct edf_schedule_data *data = sch[task->core];
+
+	pthread_mutex_lock(&data->lock);
 	if (task->state == SOF_TASK_STATE_QUEUED) {
 		/* delete task */
 		task->state = SOF_TASK_STATE_CANCEL;
 		list_item_del(&task->list);
 	}
+	pthread_mutex_unlock(&data->lock);
 
 	return 0;
 }
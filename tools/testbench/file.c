@@ -398,7 +398,7 @@ static struct comp_dev *file_new(struct sof_ipc_comp *comp)
 	struct comp_dev *dev;
 	struct sof_ipc_comp_file *file;
 	struct sof_ipc_comp_file *ipc_file =
-		(struct sof_ipc_comp_file *)comp;
+		container_of(comp, struct sof_ipc_comp_file, comp);
 	struct file_comp_data *cd;
 
 	if (IPC_IS_SIZE_INVALID(ipc_file->config)) {
@@ -418,7 +418,7 @@ static struct comp_dev *file_new(struct sof_ipc_comp *comp)
 	/* allocate  memory for file comp data */
 	cd = rzalloc(RZONE_RUNTIME, SOF_MEM_CAPS_RAM, sizeof(*cd));
 	if (!cd) {
-		free(dev);
+		rfree(dev);
 		return NULL;
 	}
 
@@ -442,8 +442,9 @@ static struct comp_dev *file_new(struct sof_ipc_comp *comp)
 		cd->fs.rfh = fopen(cd->fs.fn, "r");
 		if (!cd->fs.rfh) {
 			fprintf(stderr, "error: opening file %s\n", cd->fs.fn);
-			free(cd);
-			free(dev);
+			free(cd->fs.fn);
+			rfree(cd);
+			rfree(dev);
 			return NULL;
 		}
 		break;
@@ -451,8 +452,9 @@ static struct comp_dev *file_new(struct sof_ipc_comp *comp)
 		cd->fs.wfh = fopen(cd->fs.fn, "w");
 		if (!cd->fs.wfh) {
 			fprintf(stderr, "error: opening file %s\n", cd->fs.fn);
-			free(cd);
-			free(dev);
+			free(cd->fs.fn);
+			rfree(cd);
+			rfree(dev);
 			return NULL;
 		}
 		break;
@@ -479,8 +481,8 @@ static void file_free(struct comp_dev *dev)
 		fclose(cd->fs.wfh);
 
 	free(cd->fs.fn);
-	free(cd);
-	free(dev);
+	rfree(cd);
+	rfree(dev);
 
 	debug_print("free file component\n");
 }
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/* Offline evaluation of the clock governor policy on a load trace. */
+
+#include <sof/clk.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "testbench/common_test.h"
+
+/* frequencies of the host library platform */
+static const struct freq_table tb_cpu_freq[] = {
+	{ 50000000, 50000, 0},
+	{100000000, 100000, 1},
+	{200000000, 200000, 2},
+	{343000000, 343000, 3},
+};
+
+/*
+ * Each line of the trace is the cycle demand of one governor window in kcps,
+ * optionally followed by the load committed by running pipelines in kcps.
+ * A window asking for more than the clock provides misses its deadlines.
+ */
+int tb_clock_governor_sim(const char *trace_file, uint32_t target,
+			  uint32_t hysteresis, uint32_t down_delay)
+{
+	struct clk_gov gov;
+	char line[DEBUG_MSG_LEN];
+	FILE *trace;
+	uint64_t freq_sum = 0;
+	uint32_t windows = 0;
+	uint32_t misses = 0;
+	uint32_t demand;
+	uint32_t committed;
+	uint32_t capacity;
+	uint32_t load;
+
+	trace = fopen(trace_file, "r");
+	if (!trace) {
+		fprintf(stderr, "error: opening governor trace %s\n",
+			trace_file);
+		return -EINVAL;
+	}
+
+	/* platforms boot at the highest frequency */
+	clk_gov_init(&gov, tb_cpu_freq, ARRAY_SIZE(tb_cpu_freq),
+		     tb_cpu_freq[ARRAY_SIZE(tb_cpu_freq) - 1].freq);
+	if (target)
+		gov.target = target;
+	if (hysteresis)
+		gov.hysteresis = hysteresis;
+	if (down_delay)
+		gov.down_delay = down_delay;
+
+	while (fgets(line, sizeof(line), trace)) {
+		committed = 0;
+		if (sscanf(line, "%u %u", &demand, &committed) < 1)
+			continue;
+
+		capacity = tb_cpu_freq[gov.idx].freq / 1000;
+		load = demand < capacity ?
+			(uint64_t)demand * 1000 / capacity : 1000;
+		if (demand > capacity)
+			misses++;
+
+		if (debug)
+			printf("window %u demand %u kcps clock %u MHz "
+			       "load %u\n", windows, demand, capacity / 1000,
+			       load);
+
+		freq_sum += tb_cpu_freq[gov.idx].freq;
+		windows++;
+
+		clk_gov_update(&gov, load, committed);
+	}
+
+	fclose(trace);
+
+	if (!windows) {
+		fprintf(stderr, "error: empty governor trace %s\n",
+			trace_file);
+		return -EINVAL;
+	}
+
+	printf("Clock governor: target %u hysteresis %u down delay %u\n",
+	       gov.target, gov.hysteresis, gov.down_delay);
+	printf("Windows %u, transitions %u, average clock %u MHz\n", windows,
+	       gov.transitions, (uint32_t)(freq_sum / windows / 1000000));
+	printf("Deadline misses %u, detected after transitions %u\n", misses,
+	       gov.misses);
+
+	return 0;
+}
@@ -33,6 +33,14 @@ struct testbench_prm {
 	 */
 	uint32_t fs_in;
 	uint32_t fs_out;
+	uint32_t cores; /* number of emulated DSP cores to enable */
+	const void *tplg_blob; /* topology in memory instead of tplg_file */
+	size_t tplg_size; /* topology blob size in bytes */
+	int mem_io; /* PCM endpoints are memory streams, not files */
+	char *gov_trace; /* load trace for clock governor simulation */
+	uint32_t gov_target; /* governor policy, 0 keeps the default */
+	uint32_t gov_hysteresis;
+	uint32_t gov_down_delay;
 };
 
 struct shared_lib_table {
@@ -63,6 +71,13 @@ int tb_pipeline_params(struct ipc *ipc, int nch,
 
 void debug_print(char *message);
 
+void tb_heap_summary(void);
+
+int tb_clock_governor_sim(const char *trace_file, uint32_t target,
+			  uint32_t hysteresis, uint32_t down_delay);
+
+void tb_free_comps(struct sof *sof);
+
 int get_index_by_name(char *comp_name,
 		      struct shared_lib_table *lib_table);
 
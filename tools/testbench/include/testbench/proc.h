@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2019 Intel Corporation. All rights reserved.
+ */
+
+#ifndef _PROC_H
+#define _PROC_H
+
+#include <ipc/control.h>
+#include <ipc/stream.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * In-process processing API. A topology blob is turned into the same
+ * component graph the firmware would create, and interleaved PCM is then
+ * pushed in and pulled out of it. Only one graph can exist at a time as
+ * the firmware context is global. Push, pull and control calls do not
+ * allocate memory.
+ */
+struct sof_proc;
+
+struct sof_proc_config {
+	const void *tplg; /* topology binary blob */
+	size_t tplg_size; /* topology blob size in bytes */
+	enum sof_ipc_frame frame_fmt; /* PCM format of input and output */
+	uint32_t channels; /* interleaved channel count */
+	uint32_t rate_in; /* input rate, 0 to take it from topology */
+	uint32_t rate_out; /* output rate, 0 to take it from topology */
+};
+
+/* create graph from topology and start it, NULL on failure */
+struct sof_proc *sof_proc_new(const struct sof_proc_config *config);
+
+/* stop graph and free all of its components */
+void sof_proc_free(struct sof_proc *proc);
+
+/* push input frames and process, returns frames accepted or error */
+int sof_proc_push(struct sof_proc *proc, const void *pcm, uint32_t frames);
+
+/* pull processed frames, returns frames copied or error */
+int sof_proc_pull(struct sof_proc *proc, void *pcm, uint32_t frames);
+
+/* id of the index-th component of given SOF_COMP_ type or error */
+int sof_proc_find_comp(struct sof_proc *proc, uint32_t type, int index);
+
+/* set per channel values of a SOF_CTRL_CMD_ control, e.g. volume */
+int sof_proc_set_values(struct sof_proc *proc, uint32_t comp_id,
+			uint32_t cmd, const uint32_t *values, uint32_t count);
+
+/* pass binary control data, comp_id and size are taken from cdata */
+int sof_proc_set_data(struct sof_proc *proc,
+		      struct sof_ipc_ctrl_data *cdata);
+
+/* frames pushed but not yet pulled, in output rate frames */
+uint32_t sof_proc_latency(struct sof_proc *proc);
+
+#endif
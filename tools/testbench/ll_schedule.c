@@ -5,20 +5,115 @@
 // Author: Bartosz Kokoszko <bartoszx.kokoszko@linux.intel.com>
 
 #include <sof/audio/component.h>
+#include <sof/cpu.h>
+#include <sof/list.h>
 #include <sof/task.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <sof/wait.h>
+#include "testbench/ll_schedule.h"
+
+/*
+ * Low latency work such as volume ramps. There is no timer so every
+ * queued task is run once per scheduler tick by the core owning it and
+ * stays queued for as long as it returns a non zero reschedule time.
+ */
+static pthread_mutex_t ll_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct list_item ll_list;
+
+static void schedule_ll_task(struct task *task, uint64_t start,
+			     uint64_t deadline, uint32_t flags)
+{
+	pthread_mutex_lock(&ll_lock);
+	if (task->state != SOF_TASK_STATE_QUEUED &&
+	    task->state != SOF_TASK_STATE_RUNNING) {
+		list_item_append(&task->list, &ll_list);
+		task->state = SOF_TASK_STATE_QUEUED;
+	}
+	pthread_mutex_unlock(&ll_lock);
+}
+
+static int schedule_ll_task_init(struct task *task, uint32_t xflags)
+{
+	list_init(&task->list);
+
+	return 0;
+}
+
+static int ll_scheduler_init(void)
+{
+	list_init(&ll_list);
+
+	return 0;
+}
+
+static void schedule_ll(void)
+{
+	struct list_item *tlist;
+	struct list_item *tnext;
+	struct task *task;
+	uint64_t next;
+
+	pthread_mutex_lock(&ll_lock);
+
+	list_for_item_safe(tlist, tnext, &ll_list) {
+		task = container_of(tlist, struct task, list);
+		if (task->core != cpu_get_id() ||
+		    task->state != SOF_TASK_STATE_QUEUED)
+			continue;
+
+		/* work may queue other tasks, run it unlocked */
+		task->state = SOF_TASK_STATE_RUNNING;
+		pthread_mutex_unlock(&ll_lock);
+
+		next = task->func ? task->func(task->data) : 0;
+
+		pthread_mutex_lock(&ll_lock);
+		if (task->state != SOF_TASK_STATE_RUNNING)
+			continue;
+
+		if (next) {
+			task->state = SOF_TASK_STATE_QUEUED;
+		} else {
+			list_item_del(&task->list);
+			task->state = SOF_TASK_STATE_COMPLETED;
+		}
+	}
+
+	pthread_mutex_unlock(&ll_lock);
+}
+
+static int schedule_ll_task_cancel(struct task *task)
+{
+	pthread_mutex_lock(&ll_lock);
+	if (task->state == SOF_TASK_STATE_QUEUED ||
+	    task->state == SOF_TASK_STATE_RUNNING) {
+		list_item_del(&task->list);
+		task->state = SOF_TASK_STATE_CANCEL;
+	}
+	pthread_mutex_unlock(&ll_lock);
+
+	return 0;
+}
+
+static void schedule_ll_task_free(struct task *task)
+{
+	schedule_ll_task_cancel(task);
+
+	task->state = SOF_TASK_STATE_FREE;
+	task->func = NULL;
+	task->data = NULL;
+}
 
-/* TODO: Make host ll ops implementation */
 struct scheduler_ops schedule_ll_ops = {
-	.schedule_task = NULL,
-	.schedule_task_init = NULL,
-	.schedule_task_running = NULL,
+	.schedule_task		= schedule_ll_task,
+	.schedule_task_init	= schedule_ll_task_init,
+	.schedule_task_running	= NULL,
 	.schedule_task_complete = NULL,
-	.reschedule_task = NULL,
-	.schedule_task_cancel = NULL,
-	.schedule_task_free = NULL,
-	.scheduler_init = NULL,
-	.scheduler_free = NULL,
-	.scheduler_run = NULL
+	.reschedule_task	= NULL,
+	.schedule_task_cancel	= schedule_ll_task_cancel,
+	.schedule_task_free	= schedule_ll_task_free,
+	.scheduler_init		= ll_scheduler_init,
+	.scheduler_free		= NULL,
+	.scheduler_run		= schedule_ll
 };
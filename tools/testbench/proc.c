@@ -0,0 +1,430 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2019 Intel Corporation. All rights reserved.
+
+/*
+ * In-process processing API on top of the testbench topology loader.
+ * PCM endpoints are memory streams: push writes into the buffer after
+ * the source endpoint and pull reads from the buffer before the sink
+ * endpoint, the pipeline is copied in between.
+ */
+
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/ipc.h>
+#include <sof/list.h>
+#include <sof/math/numbers.h>
+#include <sof/schedule/schedule.h>
+#include <stdio.h>
+#include <string.h>
+#include "testbench/common_test.h"
+#include "testbench/file.h"
+#include "testbench/proc.h"
+#include "testbench/topology.h"
+#include "testbench/trace.h"
+
+struct sof_proc {
+	struct pipeline *p;
+	struct comp_dev *sched; /* scheduling component */
+	struct comp_buffer *in; /* written by push */
+	struct comp_buffer *out; /* read by pull */
+	uint32_t in_frame_bytes;
+	uint32_t out_frame_bytes;
+	uint32_t rate_in;
+	uint32_t rate_out;
+	uint64_t frames_in;
+	uint64_t frames_out;
+	struct sof_ipc_ctrl_data *cdata; /* preallocated control message */
+};
+
+/* components are registered when their shared library is loaded */
+static struct shared_lib_table proc_lib_table[NUM_WIDGETS_SUPPORTED] = {
+	{"file", "", SND_SOC_TPLG_DAPM_AIF_IN, 0, NULL},
+	{"vol", "libsof_volume.so", SND_SOC_TPLG_DAPM_PGA, 0, NULL},
+	{"src", "libsof_src.so", SND_SOC_TPLG_DAPM_SRC, 0, NULL},
+};
+
+/* firmware context, set up once per process */
+static struct sof sof;
+static int sof_ready;
+static struct sof_proc *proc_active;
+
+/* memory stream endpoint, the data is moved by push and pull */
+static struct comp_dev *mem_new(struct sof_ipc_comp *comp)
+{
+	struct sof_ipc_comp_file *ipc_file =
+		container_of(comp, struct sof_ipc_comp_file, comp);
+	struct comp_dev *dev;
+
+	if (IPC_IS_SIZE_INVALID(ipc_file->config))
+		return NULL;
+
+	dev = rzalloc(RZONE_RUNTIME, SOF_MEM_CAPS_RAM,
+		      COMP_SIZE(struct sof_ipc_comp_file));
+	if (!dev)
+		return NULL;
+
+	memcpy_s(&dev->comp, sizeof(struct sof_ipc_comp_file), ipc_file,
+		 sizeof(struct sof_ipc_comp_file));
+
+	dev->state = COMP_STATE_READY;
+
+	return dev;
+}
+
+static void mem_free(struct comp_dev *dev)
+{
+	rfree(dev);
+}
+
+static int mem_params(struct comp_dev *dev)
+{
+	struct sof_ipc_comp_file *ipc_file =
+		(struct sof_ipc_comp_file *)&dev->comp;
+	struct sof_ipc_comp_config *config = COMP_GET_CONFIG(dev);
+
+	/* sink endpoint format comes from config like a DAI */
+	if (ipc_file->mode == FILE_WRITE) {
+		dev->params.frame_fmt = config->frame_fmt;
+		dev->params.sample_container_bytes =
+			config->frame_fmt == SOF_IPC_FRAME_S16_LE ? 2 : 4;
+	}
+
+	return 0;
+}
+
+static int mem_trigger(struct comp_dev *dev, int cmd)
+{
+	return comp_set_state(dev, cmd);
+}
+
+static int mem_cmd(struct comp_dev *dev, int cmd, void *data,
+		   int max_data_size)
+{
+	return 0;
+}
+
+static int mem_copy(struct comp_dev *dev)
+{
+	return 0;
+}
+
+static int mem_prepare(struct comp_dev *dev)
+{
+	struct sof_ipc_comp_file *ipc_file =
+		(struct sof_ipc_comp_file *)&dev->comp;
+	struct sof_ipc_comp_config *config = COMP_GET_CONFIG(dev);
+	struct comp_buffer *buffer;
+	uint32_t periods;
+	int ret;
+
+	if (ipc_file->mode == FILE_READ) {
+		buffer = list_first_item(&dev->bsink_list, struct comp_buffer,
+					 source_list);
+		periods = config->periods_sink;
+	} else {
+		buffer = list_first_item(&dev->bsource_list,
+					 struct comp_buffer, sink_list);
+		periods = config->periods_source;
+	}
+
+	ret = buffer_set_size(buffer, dev->frames * periods *
+			      dev->params.channels *
+			      dev->params.sample_container_bytes);
+	if (ret < 0)
+		return ret;
+
+	buffer_reset_pos(buffer);
+	dev->state = COMP_STATE_PREPARE;
+
+	return 0;
+}
+
+static int mem_reset(struct comp_dev *dev)
+{
+	dev->state = COMP_STATE_INIT;
+
+	return 0;
+}
+
+static struct comp_driver comp_mem = {
+	.type = SOF_COMP_HOST,
+	.ops = {
+		.new = mem_new,
+		.free = mem_free,
+		.params = mem_params,
+		.cmd = mem_cmd,
+		.trigger = mem_trigger,
+		.copy = mem_copy,
+		.prepare = mem_prepare,
+		.reset = mem_reset,
+	},
+};
+
+static char *proc_format_name(enum sof_ipc_frame frame_fmt)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(sof_frames); i++) {
+		if (sof_frames[i].frame == frame_fmt)
+			return sof_frames[i].name;
+	}
+
+	return NULL;
+}
+
+/* copy periods until the graph makes no more progress */
+static void proc_run(struct sof_proc *proc)
+{
+	uint32_t avail;
+	uint32_t free;
+
+	do {
+		avail = proc->in->avail;
+		free = proc->out->free;
+
+		pipeline_schedule_copy(proc->p, 0);
+		schedule();
+	} while (proc->in->avail != avail || proc->out->free != free);
+}
+
+struct sof_proc *sof_proc_new(const struct sof_proc_config *config)
+{
+	struct testbench_prm tp;
+	struct ipc_comp_dev *pcm_dev;
+	struct ipc_comp_dev *src_dev;
+	struct ipc_comp_dev *snk_dev;
+	struct sof_proc *proc;
+	struct comp_dev *src;
+	struct comp_dev *snk;
+	char pipeline[DEBUG_MSG_LEN];
+	int fr_id, fw_id, sched_id;
+
+	if (proc_active || !config->tplg || !config->channels ||
+	    config->channels > SOF_IPC_MAX_CHANNELS)
+		return NULL;
+
+	memset(&tp, 0, sizeof(tp));
+	tp.bits_in = proc_format_name(config->frame_fmt);
+	if (!tp.bits_in)
+		return NULL;
+
+	tp.tplg_blob = config->tplg;
+	tp.tplg_size = config->tplg_size;
+	tp.mem_io = 1;
+	tp.fs_in = config->rate_in;
+	tp.fs_out = config->rate_out;
+	tp.cores = 1;
+
+	tb_enable_trace(false);
+
+	if (!sof_ready) {
+		if (tb_pipeline_setup(&sof) < 0)
+			return NULL;
+
+		comp_register(&comp_mem);
+		sof_ready = 1;
+	}
+
+	proc = rzalloc(RZONE_RUNTIME, SOF_MEM_CAPS_RAM, sizeof(*proc));
+	if (!proc)
+		return NULL;
+
+	proc->cdata = rzalloc(RZONE_RUNTIME, SOF_MEM_CAPS_RAM,
+			      sizeof(*proc->cdata) + SOF_IPC_MAX_CHANNELS *
+			      sizeof(struct sof_ipc_ctrl_value_chan));
+	if (!proc->cdata)
+		goto err;
+
+	if (parse_topology(&sof, proc_lib_table, &tp, &fr_id, &fw_id,
+			   &sched_id, pipeline) < 0)
+		goto err_comps;
+
+	pcm_dev = ipc_get_comp(sof.ipc, sched_id);
+	if (!pcm_dev)
+		goto err_comps;
+
+	proc->sched = pcm_dev->cd;
+	proc->p = pcm_dev->cd->pipeline;
+
+	/* same defaults as the testbench when rates are not known */
+	if (!tp.fs_in)
+		tp.fs_in = proc->p->ipc_pipe.period *
+			proc->p->ipc_pipe.frames_per_sched;
+	if (!tp.fs_out)
+		tp.fs_out = proc->p->ipc_pipe.period *
+			proc->p->ipc_pipe.frames_per_sched;
+
+	if (tb_pipeline_start(sof.ipc, config->channels, &proc->p->ipc_pipe,
+			      &tp) < 0)
+		goto err_comps;
+
+	src_dev = ipc_get_comp(sof.ipc, fr_id);
+	snk_dev = ipc_get_comp(sof.ipc, fw_id);
+	if (!src_dev || !snk_dev)
+		goto err_reset;
+
+	src = src_dev->cd;
+	snk = snk_dev->cd;
+	proc->in = list_first_item(&src->bsink_list, struct comp_buffer,
+				   source_list);
+	proc->out = list_first_item(&snk->bsource_list, struct comp_buffer,
+				    sink_list);
+	proc->in_frame_bytes = comp_frame_bytes(src);
+	proc->out_frame_bytes = comp_frame_bytes(snk);
+	proc->rate_in = tp.fs_in;
+	proc->rate_out = tp.fs_out;
+
+	proc_active = proc;
+
+	return proc;
+
+err_reset:
+	pipeline_reset(proc->p, proc->sched);
+err_comps:
+	tb_free_comps(&sof);
+err:
+	rfree(proc->cdata);
+	rfree(proc);
+	return NULL;
+}
+
+void sof_proc_free(struct sof_proc *proc)
+{
+	if (!proc)
+		return;
+
+	pipeline_reset(proc->p, proc->sched);
+	tb_free_comps(&sof);
+
+	rfree(proc->cdata);
+	rfree(proc);
+	proc_active = NULL;
+}
+
+int sof_proc_push(struct sof_proc *proc, const void *pcm, uint32_t frames)
+{
+	struct comp_buffer *in = proc->in;
+	const uint8_t *data = pcm;
+	uint32_t done = 0;
+	uint32_t bytes;
+	uint32_t head;
+	uint32_t n;
+
+	while (done < frames) {
+		n = MIN(frames - done, in->free / proc->in_frame_bytes);
+		if (!n)
+			break;
+
+		/* copy in up to two fragments around the wrap */
+		bytes = n * proc->in_frame_bytes;
+		head = MIN(bytes, (uint32_t)((char *)in->end_addr -
+					     (char *)in->w_ptr));
+		memcpy(in->w_ptr, data, head);
+		memcpy(in->addr, data + head, bytes - head);
+		comp_update_buffer_produce(in, bytes);
+
+		data += bytes;
+		done += n;
+
+		proc_run(proc);
+	}
+
+	proc->frames_in += done;
+
+	return done;
+}
+
+int sof_proc_pull(struct sof_proc *proc, void *pcm, uint32_t frames)
+{
+	struct comp_buffer *out = proc->out;
+	uint8_t *data = pcm;
+	uint32_t bytes;
+	uint32_t head;
+	uint32_t n;
+
+	n = MIN(frames, out->avail / proc->out_frame_bytes);
+	if (n) {
+		bytes = n * proc->out_frame_bytes;
+		head = MIN(bytes, (uint32_t)((char *)out->end_addr -
+					     (char *)out->r_ptr));
+		memcpy(data, out->r_ptr, head);
+		memcpy(data + head, out->addr, bytes - head);
+		comp_update_buffer_consume(out, bytes);
+
+		proc->frames_out += n;
+	}
+
+	/* input may have been held back by a full output */
+	proc_run(proc);
+
+	return n;
+}
+
+int sof_proc_find_comp(struct sof_proc *proc, uint32_t type, int index)
+{
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+
+	list_for_item(clist, &sof.ipc->shared_ctx->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_COMPONENT ||
+		    icd->cd->comp.type != type)
+			continue;
+
+		if (!index--)
+			return icd->cd->comp.id;
+	}
+
+	return -ENODEV;
+}
+
+int sof_proc_set_values(struct sof_proc *proc, uint32_t comp_id,
+			uint32_t cmd, const uint32_t *values, uint32_t count)
+{
+	struct sof_ipc_ctrl_data *cdata = proc->cdata;
+	struct ipc_comp_dev *icd;
+	int i;
+
+	if (count > SOF_IPC_MAX_CHANNELS)
+		return -EINVAL;
+
+	icd = ipc_get_comp(sof.ipc, comp_id);
+	if (!icd || icd->type != COMP_TYPE_COMPONENT)
+		return -ENODEV;
+
+	cdata->rhdr.hdr.size = sizeof(*cdata) +
+		count * sizeof(struct sof_ipc_ctrl_value_chan);
+	cdata->comp_id = comp_id;
+	cdata->type = SOF_CTRL_TYPE_VALUE_CHAN_SET;
+	cdata->cmd = cmd;
+	cdata->num_elems = count;
+
+	for (i = 0; i < count; i++) {
+		cdata->chanv[i].channel = i;
+		cdata->chanv[i].value = values[i];
+	}
+
+	return comp_cmd(icd->cd, COMP_CMD_SET_VALUE, cdata,
+			cdata->rhdr.hdr.size);
+}
+
+int sof_proc_set_data(struct sof_proc *proc,
+		      struct sof_ipc_ctrl_data *cdata)
+{
+	struct ipc_comp_dev *icd;
+
+	icd = ipc_get_comp(sof.ipc, cdata->comp_id);
+	if (!icd || icd->type != COMP_TYPE_COMPONENT)
+		return -ENODEV;
+
+	return comp_cmd(icd->cd, COMP_CMD_SET_DATA, cdata,
+			cdata->rhdr.hdr.size);
+}
+
+uint32_t sof_proc_latency(struct sof_proc *proc)
+{
+	uint64_t produced = proc->frames_in * proc->rate_out / proc->rate_in;
+
+	return produced > proc->frames_out ? produced - proc->frames_out : 0;
+}
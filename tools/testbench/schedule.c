@@ -102,3 +102,42 @@ void schedule(void)
 			schedulers[i]->scheduler_run();
 	}
 }
+
+/* the testbench does not measure load, all cores appear idle */
+uint64_t schedule_task_run(struct task *task)
+{
+	return task->func(task->data);
+}
+
+uint32_t schedule_task_cycles(struct task *task)
+{
+	(void)task;
+
+	return 0;
+}
+
+void schedule_load_update(void)
+{
+}
+
+uint32_t schedule_load_get(int core)
+{
+	(void)core;
+
+	return 0;
+}
+
+void schedule_load_stats_get(int core, struct schedule_load_stats *stats)
+{
+	(void)core;
+
+	memset(stats, 0, sizeof(*stats));
+}
+
+uint32_t schedule_load_sample(int core, struct schedule_load_window *win)
+{
+	(void)core;
+	(void)win;
+
+	return 0;
+}
@@ -5,6 +5,7 @@
 // Author: Seppo Ingalsuo <seppo.ingalsuo@linux.intel.com>
 //         Ranjani Sridharan <ranjani.sridharan@linux.intel.com>
 
+#include <sof/cpu.h>
 #include <sof/ipc.h>
 #include <sof/list.h>
 #include <getopt.h>
@@ -82,47 +83,22 @@ static void print_usage(char *executable)
 	printf("-t <tplg_file> -b <input_format> ");
 	printf("-a <comp1=comp1_library,comp2=comp2_library>\n");
 	printf("input_format should be S16_LE, S32_LE, S24_LE or FLOAT_LE\n");
+	printf("-C <cores> runs pipelines on up to %d emulated cores\n",
+	       PLATFORM_CORE_COUNT);
+	printf("-G <load_trace> simulates the clock governor on a trace ");
+	printf("of window demands in kcps, -P <target,hysteresis,delay> ");
+	printf("overrides its policy\n");
 	printf("Example Usage:\n");
 	printf("%s -i in.txt -o out.txt -t test.tplg ", executable);
 	printf("-r 48000 -R 96000 ");
 	printf("-b S16_LE -a vol=libsof_volume.so\n");
 }
 
-/* free components */
-static void free_comps(void)
-{
-	struct list_item *clist;
-	struct list_item *temp;
-	struct ipc_comp_dev *icd = NULL;
-
-	list_for_item_safe(clist, temp, &sof.ipc->shared_ctx->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
-		switch (icd->type) {
-		case COMP_TYPE_COMPONENT:
-			comp_free(icd->cd);
-			list_item_del(&icd->list);
-			rfree(icd);
-			break;
-		case COMP_TYPE_BUFFER:
-			rfree(icd->cb->addr);
-			rfree(icd->cb);
-			list_item_del(&icd->list);
-			rfree(icd);
-			break;
-		default:
-			rfree(icd->pipeline);
-			list_item_del(&icd->list);
-			rfree(icd);
-			break;
-		}
-	}
-}
-
 static void parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 {
 	int option = 0;
 
-	while ((option = getopt(argc, argv, "hdi:o:t:b:a:r:R:")) != -1) {
+	while ((option = getopt(argc, argv, "hdi:o:t:b:a:r:R:C:G:P:")) != -1) {
 		switch (option) {
 		/* input sample file */
 		case 'i':
@@ -159,6 +135,22 @@ static void parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 			tp->fs_out = atoi(optarg);
 			break;
 
+		/* number of emulated cores */
+		case 'C':
+			tp->cores = atoi(optarg);
+			break;
+
+		/* clock governor simulation */
+		case 'G':
+			tp->gov_trace = strdup(optarg);
+			break;
+
+		/* clock governor policy */
+		case 'P':
+			sscanf(optarg, "%u,%u,%u", &tp->gov_target,
+			       &tp->gov_hysteresis, &tp->gov_down_delay);
+			break;
+
 		/* enable debug prints */
 		case 'd':
 			debug = 1;
@@ -190,12 +182,29 @@ int main(int argc, char **argv)
 	/* initialize input and output sample rates */
 	tp.fs_in = 0;
 	tp.fs_out = 0;
+	tp.cores = 1;
+	tp.tplg_blob = NULL;
+	tp.mem_io = 0;
+	tp.gov_trace = NULL;
+	tp.gov_target = 0;
+	tp.gov_hysteresis = 0;
+	tp.gov_down_delay = 0;
 
 	/* command line arguments*/
 	parse_input_args(argc, argv, &tp);
 
+	/* governor simulation does not run a pipeline */
+	if (tp.gov_trace) {
+		ret = tb_clock_governor_sim(tp.gov_trace, tp.gov_target,
+					    tp.gov_hysteresis,
+					    tp.gov_down_delay);
+		free(tp.gov_trace);
+		exit(ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+	}
+
 	/* check args */
-	if (!tp.tplg_file || !tp.input_file || !tp.output_file || !tp.bits_in) {
+	if (!tp.tplg_file || !tp.input_file || !tp.output_file || !tp.bits_in ||
+	    !tp.cores || tp.cores > PLATFORM_CORE_COUNT) {
 		print_usage(argv[0]);
 		exit(EXIT_FAILURE);
 	}
@@ -206,6 +215,10 @@ int main(int argc, char **argv)
 		exit(EXIT_FAILURE);
 	}
 
+	/* pipelines are run by the core set in topology */
+	for (i = 0; i < tp.cores; i++)
+		cpu_enable_core(i);
+
 	/* parse topology file and create pipeline */
 	if (parse_topology(&sof, lib_table, &tp, &fr_id, &fw_id, &sched_id,
 			   pipeline) < 0) {
@@ -241,8 +254,10 @@ int main(int argc, char **argv)
 	tb_enable_trace(false); /* reduce trace output */
 	tic = clock();
 
-	while (frcd->fs.reached_eof == 0)
+	while (frcd->fs.reached_eof == 0) {
 		pipeline_schedule_copy(p, 0);
+		schedule();
+	}
 
 	if (!frcd->fs.reached_eof)
 		printf("warning: possible pipeline xrun\n");
@@ -256,13 +271,16 @@ int main(int argc, char **argv)
 		exit(EXIT_FAILURE);
 	}
 
+	for (i = 0; i < tp.cores; i++)
+		cpu_disable_core(i);
+
 	n_in = frcd->fs.n;
 	n_out = fwcd->fs.n;
 	t_exec = (double)(toc - tic) / CLOCKS_PER_SEC;
 	c_realtime = (double)n_out / TESTBENCH_NCH / tp.fs_out / t_exec;
 
 	/* free all components/buffers in pipeline */
-	free_comps();
+	tb_free_comps(&sof);
 
 	/* print test summary */
 	printf("==========================================================\n");
@@ -278,6 +296,7 @@ int main(int argc, char **argv)
 	printf("Output sample count: %d\n", n_out);
 	printf("Total execution time: %.2f us, %.2f x realtime\n",
 	       1e3 * t_exec, c_realtime);
+	tb_heap_summary();
 
 	/* free all other data */
 	free(tp.bits_in);
@@ -256,15 +256,15 @@ static int load_fileread(struct sof *sof, int comp_id, int pipeline_id,
 		total_array_size += array->size;
 	}
 
-	/* configure fileread */
-	fileread.fn = strdup(tp->input_file);
+	/* configure fileread, memory stream endpoints have no file */
+	fileread.fn = tp->mem_io ? NULL : strdup(tp->input_file);
 	fileread.mode = FILE_READ;
 	fileread.comp.id = comp_id;
 
 	/* use fileread comp as scheduling comp */
 	*fr_id = *sched_id = comp_id;
 	fileread.comp.hdr.size = sizeof(struct sof_ipc_comp_file);
-	fileread.comp.type = SOF_COMP_FILEREAD;
+	fileread.comp.type = tp->mem_io ? SOF_COMP_HOST : SOF_COMP_FILEREAD;
 	fileread.comp.pipeline_id = pipeline_id;
 	fileread.config.hdr.size = sizeof(struct sof_ipc_comp_config);
 
@@ -316,13 +316,18 @@ static int load_filewrite(struct sof *sof, int comp_id, int pipeline_id,
 		total_array_size += array->size;
 	}
 
-	/* configure filewrite */
-	filewrite.fn = strdup(tp->output_file);
+	/* configure filewrite, memory streams use the input format */
+	if (tp->mem_io) {
+		filewrite.fn = NULL;
+		filewrite.config.frame_fmt = find_format(tp->bits_in);
+	} else {
+		filewrite.fn = strdup(tp->output_file);
+	}
 	filewrite.comp.id = comp_id;
 	filewrite.mode = FILE_WRITE;
 	*fw_id = comp_id;
 	filewrite.comp.hdr.size = sizeof(struct sof_ipc_comp_file);
-	filewrite.comp.type = SOF_COMP_FILEREAD;
+	filewrite.comp.type = tp->mem_io ? SOF_COMP_HOST : SOF_COMP_FILEREAD;
 	filewrite.comp.pipeline_id = pipeline_id;
 	filewrite.config.hdr.size = sizeof(struct sof_ipc_comp_config);
 
@@ -346,6 +351,9 @@ static int load_pga(struct sof *sof, int comp_id, int pipeline_id,
 	size_t total_array_size = 0, read_size;
 	int ret = 0;
 
+	/* limits not set in topology select the volume defaults */
+	memset(&volume, 0, sizeof(volume));
+
 	/* allocate memory for vendor tuple array */
 	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
 	if (!array) {
@@ -772,10 +780,17 @@ int parse_topology(struct sof *sof, struct shared_lib_table *library_table,
 	int i, ret = 0;
 	size_t file_size, size;
 
-	/* open topology file */
-	file = fopen(tp->tplg_file, "rb");
+	/* graph description is rebuilt on every parse */
+	pipeline_string[0] = '\0';
+
+	/* open topology file or blob already in memory */
+	if (tp->tplg_blob)
+		file = fmemopen((void *)tp->tplg_blob, tp->tplg_size, "rb");
+	else
+		file = fopen(tp->tplg_file, "rb");
 	if (!file) {
-		fprintf(stderr, "error: opening file %s\n", tp->tplg_file);
+		fprintf(stderr, "error: opening file %s\n",
+			tp->tplg_blob ? "<blob>" : tp->tplg_file);
 		return -EINVAL;
 	}
 
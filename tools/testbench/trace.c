@@ -44,6 +44,9 @@ char *get_trace_class(uint32_t trace_class)
 		CASE(SA);
 		CASE(DMIC);
 		CASE(POWER);
+		CASE(IDC);
+		CASE(CPU);
+		CASE(EDF);
 	default: return "unknown";
 	}
 }